@@ -1,33 +1,75 @@
-/*******************************************************************************
-* 文 件 名: sched_config.h
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-25
-* 文件说明: 事件驱动调度器配置
-*******************************************************************************/
-
-#ifndef __SCHED_CONFIG_H
-#define __SCHED_CONFIG_H
-
-/* 调度器参数 ----------------------------------------------------------------*/
-#define SCHED_TICK_HZ               ( CPU_TICK_HZ ) /* 调度器节拍频率(Hz)     */
-#define SCHED_LOWEST_PRIORITY       ( 3 )           /* 调度器最低优先级       */
-#define SCHED_TOTAL_HEAP_SIZE       ( 1000 )        /* 调度器内存分配总大小   */
-#define SCHED_BYTE_ALIGNMENT        ( CPU_BYTE_ALIGNMENT )
-
-/* 调度器配置 ----------------------------------------------------------------*/
-#define SCHED_USE_16BIT_TICK_EN     ( 0 )   /* 0-使用32位节拍, 1-使用16位节拍 */
-#define SCHED_PRIOTBL_TABLE_SIZE    ( 4 )   /* 优先级记录表大小               */
-
-/* 调度器功能 ----------------------------------------------------------------*/
-#define SCHED_TASK_EN               ( 1 )   /* 任务使能控制(0/1)              */
-#define SCHED_TASK_EVENT_METHOD     ( 1 )   /* 0-使用记录表, >=1-使用消息队列 */
-#define SCHED_TASK_CYCLE_EN         ( 1 )   /* 周期信号使能控制(0/1)          */
-#define SCHED_TASK_ALARM_EN         ( 1 )   /* 闹钟使能控制(0/1)              */
-#define SCHED_DAEMON_EN             ( 1 )   /* 守护任务使能控制(0/1)          */
-
-/* 调度器调试 ----------------------------------------------------------------*/
-#define SCHED_CHECK_EN              ( 1 )   /* 调度器运行监测使能(0/1)        */
-#define SCHED_ASSERT_EN             ( 1 )   /* 调度器断言使能(0/1)            */
-
-#endif  /* __SCHED_CONFIG_H */
+/*******************************************************************************
+* 文 件 名: sched_config.h
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-25
+* 文件说明: 事件驱动调度器配置
+*******************************************************************************/
+
+#ifndef __SCHED_CONFIG_H
+#define __SCHED_CONFIG_H
+
+/* 调度器参数 ----------------------------------------------------------------*/
+#define SCHED_TICK_HZ               ( CPU_TICK_HZ ) /* 调度器节拍频率(Hz)     */
+#define SCHED_LOWEST_PRIORITY       ( 3 )           /* 调度器最低优先级       */
+#define SCHED_TOTAL_HEAP_SIZE       ( 1000 )        /* 调度器内存分配总大小   */
+#define SCHED_BYTE_ALIGNMENT        ( CPU_BYTE_ALIGNMENT )
+#define SCHED_HEAP_CLASS_NUM        ( 4 )           /* 内存池块大小级数       */
+#define SCHED_HEAP_CLASS_MIN        ( 16 )          /* 内存池最小块大小       */
+#define SCHED_HEAP_TLSF_SL_LOG2     ( 4 )           /* TLSF二级索引位数       */
+#define SCHED_EVENT_POOL_SIZE       ( 16 )          /* 共享事件节点池大小     */
+#define SCHED_CONFLATE_SIG_NUM      ( 8 )           /* 可合并的用户信号数量   */
+#define SCHED_SIGTBL_SIG_NUM        ( 64 )          /* 扩展记录表信号数量     */
+#define SCHED_TASK_DEFER_LEN        ( 4 )           /* 任务延迟队列长度       */
+#define SCHED_TIMER_NODE_NUM        ( 8 )           /* 延时事件定时节点数量   */
+#define SCHED_LATENCY_BINS          ( 8 )           /* 事件延时直方图分档数   */
+#define SCHED_HSM_MAX_DEPTH         ( 4 )           /* 层次状态机最大深度     */
+#define SCHED_HSM_PATH_CACHE        ( 8 )           /* 状态转移路径缓存数量   */
+#define SCHED_TRACE_LEN             ( 32 )          /* 状态转移跟踪记录数量   */
+#define SCHED_TRACE_STATE_NUM       ( 16 )          /* 状态驻留时间统计数量   */
+#define SCHED_DAEMON_LOWEST_PRIO    ( 3 )           /* 守护任务最低优先级     */
+#define SCHED_DAEMON_QUEUE_LEN      ( 4 )           /* 守护任务调用队列长度   */
+#define SCHED_DAEMON_BUDGET         ( 0 )           /* 守护任务份额,0-不保证  */
+#define SCHED_WORKER_NUM            ( 2 )           /* 工作线程数量           */
+#define SCHED_WORKER_DEQUE_LEN      ( 64 )          /* 工作线程作业队列长度   */
+
+/* 调度器配置 ----------------------------------------------------------------*/
+#define SCHED_USE_16BIT_TICK_EN     ( 0 )   /* 0-使用32位节拍, 1-使用16位节拍 */
+#define SCHED_PRIOTBL_TABLE_SIZE    ( 4 )   /* 优先级记录表大小               */
+#define SCHED_TASK_QUEUE_LANES      ( 1 )   /* 消息队列优先级通道数量         */
+#define SCHED_EVTPOS_WIDTH          ( 8 )   /* 消息队列偏移量位宽(8/16/32)    */
+#define SCHED_QUEUE_POW2_EN         ( 0 )   /* 队列长度取2的幂(0/1)           */
+#define SCHED_LIST_COMPACT_EN       ( 0 )   /* 链表项使用16位相对偏移(0/1)    */
+#define SCHED_STATIC_ALLOC_EN       ( 0 )   /* 静态创建对象接口使能(0/1)      */
+#define SCHED_DYNAMIC_ALLOC_EN      ( 1 )   /* 动态创建对象接口使能(0/1)      */
+#define SCHED_TASK_TABLE_EN         ( 0 )   /* 任务控制块连续存放(0/1)        */
+
+/* 调度器功能 ----------------------------------------------------------------*/
+#define SCHED_TASK_EN               ( 1 )   /* 任务使能控制(0/1)              */
+#define SCHED_FSM_HSM_EN            ( 0 )   /* 层次状态机使能(0/1)            */
+#define SCHED_FSM_TABLE_EN          ( 0 )   /* 状态转移表使能(0/1)            */
+#define SCHED_FSM_TRACE_EN          ( 0 )   /* 状态转移跟踪使能(0/1)          */
+#define SCHED_TASK_EVENT_METHOD     ( 1 )   /* 0-使用记录表, >=1-使用消息队列 */
+#define SCHED_SIGTBL_EXT_EN         ( 0 )   /* 记录表保存消息并扩展信号(0/1)  */
+#define SCHED_EVENT_POOL_EN         ( 0 )   /* 共享事件节点池使能(0/1)        */
+#define SCHED_QUEUE_POLICY_EN       ( 0 )   /* 消息队列溢出策略使能(0/1)      */
+#define SCHED_EVENT_CONFLATE_EN     ( 0 )   /* 事件信号合并使能(0/1)          */
+#define SCHED_TASK_DEFER_EN         ( 0 )   /* 事件延迟与召回使能(0/1)        */
+#define SCHED_SIGMASK_METHOD        ( 0 )   /* 信号屏蔽:0-关闭,1-丢弃,2-延迟  */
+#define SCHED_EVENT_TIMESTAMP_EN    ( 0 )   /* 事件时间戳与超时丢弃(0/1)      */
+#define SCHED_LATENCY_STAT_EN       ( 0 )   /* 事件排队延时统计(0/1)          */
+#define SCHED_TASK_CYCLE_EN         ( 1 )   /* 周期信号使能控制(0/1)          */
+#define SCHED_TASK_ALARM_EN         ( 1 )   /* 闹钟使能控制(0/1)              */
+#define SCHED_TIMER_EVENT_EN        ( 0 )   /* 延时发送事件使能(0/1)          */
+#define SCHED_DAEMON_EN             ( 1 )   /* 守护任务使能控制(0/1)          */
+#define SCHED_DAEMON_PRIO_EN        ( 0 )   /* 守护任务优先级使能(0/1)        */
+#define SCHED_DAEMON_QUEUE_EN       ( 0 )   /* 守护任务调用队列使能(0/1)      */
+#define SCHED_DAEMON_CO_EN          ( 0 )   /* 守护任务无栈协程使能(0/1)      */
+#define SCHED_DAEMON_CYCLE_EN       ( 0 )   /* 守护任务周期调用使能(0/1)      */
+#define SCHED_DAEMON_OFFLOAD_EN     ( 0 )   /* 守护任务卸载到工作线程(0/1)    */
+
+/* 调度器调试 ----------------------------------------------------------------*/
+#define SCHED_CHECK_EN              ( 1 )   /* 调度器运行监测使能(0/1)        */
+#define SCHED_ASSERT_EN             ( 1 )   /* 调度器断言使能(0/1)            */
+
+#endif  /* __SCHED_CONFIG_H */
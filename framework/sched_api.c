@@ -1,177 +1,417 @@
-/*******************************************************************************
-* 文 件 名: sched_api.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-08-03
-* 文件说明: 实现事件驱动调度器的API函数
-*******************************************************************************/
-
-#include "sched.h"
-#include "sched_framework.h"
-
-/*******************************************************************************
-
-                                  调度核心管理
-
-*******************************************************************************/
-void sched_Init(void)
-{
-    framework_CoreInit();
-}
-
-void sched_Start(void)
-{
-    framework_CoreStart();
-}
-
-#if SCHED_TASK_EN
-/*******************************************************************************
-
-                                    任务管理
-
-*******************************************************************************/
-SchedTaskHandle_t sched_TaskCreate(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial)
-{
-    return ((SchedTaskHandle_t)framework_TaskCreate(prio, queueLen, initial));
-}
-
-#if SCHED_TASK_CYCLE_EN
-void sched_TaskSetCyclePeriod(SchedTaskHandle_t task, SchedTick_t period, SchedBool_t immedTRIG)
-{
-    framework_TaskSetCyclePeriod((SchedTask_t *)task, period, immedTRIG);
-}
-
-SchedTick_t sched_TaskGetCycleTick(SchedTaskHandle_t task)
-{
-    return framework_TaskGetCycleTick((SchedTask_t *)task);
-}
-#endif  /* SCHED_TASK_CYCLE_EN */
-
-/*******************************************************************************
-
-                                    事件管理
-
-*******************************************************************************/
-SchedStatus_t sched_EventSend(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
-{
-SchedEvent_t event;
-
-    event.sig = evtSig;
-    event.msg = evtMsg;
-    return framework_EventSend((SchedTask_t *)task, &event);
-}
-
-SchedStatus_t sched_EventSendFront(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
-{
-SchedEvent_t event;
-
-    event.sig = evtSig;
-    event.msg = evtMsg;
-    return framework_EventSendFront((SchedTask_t *)task, &event);
-}
-
-SchedStatus_t sched_EventSendFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
-{
-SchedEvent_t event;
-
-    event.sig = evtSig;
-    event.msg = evtMsg;
-    return framework_EventSendFromISR((SchedTask_t *)task, &event);
-}
-
-SchedStatus_t sched_EventSendFrontFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
-{
-SchedEvent_t event;
-
-    event.sig = evtSig;
-    event.msg = evtMsg;
-    return framework_EventSendFrontFromISR((SchedTask_t *)task, &event);
-}
-
-#if SCHED_TASK_ALARM_EN
-/*******************************************************************************
-
-                                    闹钟管理
-
-*******************************************************************************/
-SchedAlarmHandle_t sched_AlarmCreate(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
-{
-SchedEvent_t event;
-
-    event.sig = evtSig;
-    event.msg = evtMsg;
-    return ((SchedAlarmHandle_t)framework_AlarmCreate((SchedTask_t *)task, &event));
-}
-
-void sched_AlarmSetEvent(SchedAlarmHandle_t alarm, EvtSig_t evtSig, EvtMsg_t evtMsg)
-{
-SchedEvent_t event;
-
-    event.sig = evtSig;
-    event.msg = evtMsg;
-    framework_AlarmSetEvent((SchedAlarm_t *)alarm, &event);
-}
-
-void sched_AlarmCancel(SchedAlarmHandle_t alarm)
-{
-    framework_AlarmCancel((SchedAlarm_t *)alarm);
-}
-
-void sched_AlarmSet(SchedAlarmHandle_t alarm, SchedTick_t period)
-{
-    framework_AlarmSet((SchedAlarm_t *)alarm, period);
-}
-
-SchedStatus_t sched_AlarmGetStatus(SchedAlarmHandle_t alarm)
-{
-    return framework_AlarmGetStatus((SchedAlarm_t *)alarm);
-}
-#endif  /* SCHED_TASK_ALARM_EN */
-
-#endif  /* SCHED_TASK_EN */
-
-#if SCHED_DAEMON_EN
-/*******************************************************************************
-
-                                  守护任务管理
-
-*******************************************************************************/
-SchedDaemonHandle_t sched_DaemonCreate(SchedDaemonFunction_t daemonFunc)
-{
-    return ((SchedDaemonHandle_t)framework_DaemonCreate(daemonFunc));
-}
-
-void sched_DaemonAbort(SchedDaemonHandle_t daemon)
-{
-    framework_DaemonAbort((SchedDaemon_t *)daemon);
-}
-
-SchedStatus_t sched_DaemonCall(SchedDaemonHandle_t daemon, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay)
-{
-SchedEvent_t event;
-
-    event.sig = evtSig;
-    event.msg = evtMsg;
-    return framework_DaemonCall((SchedDaemon_t *)daemon, &event, delay);
-}
-
-SchedStatus_t sched_DaemonGetStatus(SchedDaemonHandle_t daemon)
-{
-    return framework_DaemonGetStatus((SchedDaemon_t *)daemon);
-}
-
-SchedStatus_t sched_DaemonCallFromISR(SchedDaemonHandle_t daemon, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay)
-{
-SchedEvent_t event;
-
-    event.sig = evtSig;
-    event.msg = evtMsg;
-    return framework_DaemonCallFromISR((SchedDaemon_t *)daemon, &event, delay);
-}
-
-SchedStatus_t sched_DaemonGetStatusFromISR(SchedDaemonHandle_t daemon)
-{
-    return framework_DaemonGetStatusFromISR((SchedDaemon_t *)daemon);
-}
-
-#endif  /* SCHED_DAEMON_EN */
+/*******************************************************************************
+* 文 件 名: sched_api.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-08-03
+* 文件说明: 实现事件驱动调度器的API函数
+*******************************************************************************/
+
+#include "sched.h"
+#include "sched_framework.h"
+
+/*******************************************************************************
+
+                                  调度核心管理
+
+*******************************************************************************/
+void sched_Init(void)
+{
+    framework_CoreInit();
+}
+
+void sched_Start(void)
+{
+    framework_CoreStart();
+}
+
+#if SCHED_TASK_EN
+/*******************************************************************************
+
+                                    任务管理
+
+*******************************************************************************/
+#if SCHED_DYNAMIC_ALLOC_EN
+SchedTaskHandle_t sched_TaskCreate(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial)
+{
+    return ((SchedTaskHandle_t)framework_TaskCreate(prio, queueLen, initial));
+}
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+SchedTaskHandle_t sched_TaskCreateStatic(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial,
+                                         SchedTaskStatic_t *taskBuf, SchedEvent_t *queueBuf)
+{
+    return ((SchedTaskHandle_t)framework_TaskCreateStatic(prio, queueLen, initial, taskBuf, queueBuf));
+}
+#endif
+
+#if SCHED_FSM_TABLE_EN
+#if SCHED_DYNAMIC_ALLOC_EN
+SchedTaskHandle_t sched_TaskCreateTable(uint8_t prio, EvtPos_t queueLen, SchedFsmTable_t const *table)
+{
+    return ((SchedTaskHandle_t)framework_TaskCreateTable(prio, queueLen, table));
+}
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+SchedTaskHandle_t sched_TaskCreateTableStatic(uint8_t prio, EvtPos_t queueLen, SchedFsmTable_t const *table,
+                                              SchedTaskStatic_t *taskBuf, SchedEvent_t *queueBuf)
+{
+    return ((SchedTaskHandle_t)framework_TaskCreateTableStatic(prio, queueLen, table, taskBuf, queueBuf));
+}
+#endif
+
+uint8_t sched_TaskGetTableState(SchedTaskHandle_t task)
+{
+    return framework_FSM_GetTableState(&((SchedTask_t *)task)->fsm);
+}
+#endif
+
+#if SCHED_TASK_CYCLE_EN
+void sched_TaskSetCyclePeriod(SchedTaskHandle_t task, SchedTick_t period, SchedBool_t immedTRIG)
+{
+    framework_TaskSetCyclePeriod((SchedTask_t *)task, period, immedTRIG);
+}
+
+SchedTick_t sched_TaskGetCycleTick(SchedTaskHandle_t task)
+{
+    return framework_TaskGetCycleTick((SchedTask_t *)task);
+}
+#endif  /* SCHED_TASK_CYCLE_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_QUEUE_POLICY_EN
+void sched_TaskSetOverflowPolicy(SchedTaskHandle_t task, uint8_t policy)
+{
+    framework_TaskSetOverflowPolicy((SchedTask_t *)task, policy);
+}
+
+uint32_t sched_TaskGetDropCount(SchedTaskHandle_t task)
+{
+    return framework_TaskGetDropCount((SchedTask_t *)task);
+}
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_QUEUE_POLICY_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_CONFLATE_EN
+void sched_TaskSetConflate(SchedTaskHandle_t task, EvtSig_t sig, SchedBool_t enable)
+{
+    framework_TaskSetConflate((SchedTask_t *)task, sig, enable);
+}
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_CONFLATE_EN */
+
+#if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+void sched_TaskSetEventTTL(SchedTaskHandle_t task, SchedTimestamp_t ttl)
+{
+    framework_TaskSetEventTTL((SchedTask_t *)task, ttl);
+}
+
+uint32_t sched_TaskGetExpiredCount(SchedTaskHandle_t task)
+{
+    return framework_TaskGetExpiredCount((SchedTask_t *)task);
+}
+
+#if SCHED_LATENCY_STAT_EN
+uint32_t sched_TaskGetLatencyCount(SchedTaskHandle_t task, uint8_t bin)
+{
+    return framework_TaskGetLatencyCount((SchedTask_t *)task, bin);
+}
+
+SchedTimestamp_t sched_TaskGetLatencyMax(SchedTaskHandle_t task)
+{
+    return framework_TaskGetLatencyMax((SchedTask_t *)task);
+}
+#endif  /* SCHED_LATENCY_STAT_EN */
+#endif  /* SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1) */
+
+#if SCHED_SIGMASK_METHOD
+void sched_TaskSetSigMask(SchedTaskHandle_t task, SchedSigMask_t mask)
+{
+    framework_TaskSetSigMask((SchedTask_t *)task, mask);
+}
+#endif  /* SCHED_SIGMASK_METHOD */
+
+#if SCHED_FSM_TRACE_EN
+uint16_t sched_TraceRead(SchedTraceRecord_t *buf, uint16_t max)
+{
+    return framework_TraceRead(buf, max);
+}
+
+uint16_t sched_TraceGetResidency(SchedTraceResidency_t *buf, uint16_t max)
+{
+    return framework_TraceGetResidency(buf, max);
+}
+
+void sched_TraceReset(void)
+{
+    framework_TraceReset();
+}
+#endif  /* SCHED_FSM_TRACE_EN */
+
+/*******************************************************************************
+
+                                    事件管理
+
+*******************************************************************************/
+SchedStatus_t sched_EventSend(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_EventSend((SchedTask_t *)task, &event);
+}
+
+SchedStatus_t sched_EventSendFront(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_EventSendFront((SchedTask_t *)task, &event);
+}
+
+SchedStatus_t sched_EventSendFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_EventSendFromISR((SchedTask_t *)task, &event);
+}
+
+SchedStatus_t sched_EventSendFrontFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_EventSendFrontFromISR((SchedTask_t *)task, &event);
+}
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && (SCHED_TASK_QUEUE_LANES > 1)
+SchedStatus_t sched_EventSendLane(SchedTaskHandle_t task, uint8_t lane, EvtSig_t evtSig, EvtMsg_t evtMsg)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_EventSendLane((SchedTask_t *)task, lane, &event);
+}
+
+SchedStatus_t sched_EventSendLaneFromISR(SchedTaskHandle_t task, uint8_t lane, EvtSig_t evtSig, EvtMsg_t evtMsg)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_EventSendLaneFromISR((SchedTask_t *)task, lane, &event);
+}
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && (SCHED_TASK_QUEUE_LANES > 1) */
+
+#if SCHED_TIMER_EVENT_EN
+SchedStatus_t sched_EventSendDelayed(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_EventSendDelayed((SchedTask_t *)task, &event, delay);
+}
+
+SchedStatus_t sched_EventSendDelayedFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_EventSendDelayedFromISR((SchedTask_t *)task, &event, delay);
+}
+
+uint16_t sched_TimerGetMinFree(void)
+{
+    return framework_TimerGetMinFree();
+}
+#endif  /* SCHED_TIMER_EVENT_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_TASK_DEFER_EN
+SchedStatus_t sched_EventDefer(SchedTaskHandle_t task, SchedEvent_t const *evt)
+{
+    return framework_EventDefer((SchedTask_t *)task, evt);
+}
+
+EvtPos_t sched_EventRecall(SchedTaskHandle_t task)
+{
+    return framework_EventRecall((SchedTask_t *)task);
+}
+
+#if SCHED_QUEUE_POLICY_EN
+uint32_t sched_EventDeferGetDropCount(SchedTaskHandle_t task)
+{
+    return framework_EventDeferGetDropCount((SchedTask_t *)task);
+}
+#endif
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_TASK_DEFER_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN
+EvtPos_t sched_EventPoolGetMinFree(void)
+{
+    return framework_EventPoolGetMinFree();
+}
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN */
+
+#if SCHED_TASK_ALARM_EN
+/*******************************************************************************
+
+                                    闹钟管理
+
+*******************************************************************************/
+#if SCHED_DYNAMIC_ALLOC_EN
+SchedAlarmHandle_t sched_AlarmCreate(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return ((SchedAlarmHandle_t)framework_AlarmCreate((SchedTask_t *)task, &event));
+}
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+SchedAlarmHandle_t sched_AlarmCreateStatic(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg,
+                                           SchedAlarmStatic_t *alarmBuf)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return ((SchedAlarmHandle_t)framework_AlarmCreateStatic((SchedTask_t *)task, &event, alarmBuf));
+}
+#endif
+
+void sched_AlarmSetEvent(SchedAlarmHandle_t alarm, EvtSig_t evtSig, EvtMsg_t evtMsg)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    framework_AlarmSetEvent((SchedAlarm_t *)alarm, &event);
+}
+
+void sched_AlarmCancel(SchedAlarmHandle_t alarm)
+{
+    framework_AlarmCancel((SchedAlarm_t *)alarm);
+}
+
+void sched_AlarmSet(SchedAlarmHandle_t alarm, SchedTick_t period)
+{
+    framework_AlarmSet((SchedAlarm_t *)alarm, period);
+}
+
+SchedStatus_t sched_AlarmGetStatus(SchedAlarmHandle_t alarm)
+{
+    return framework_AlarmGetStatus((SchedAlarm_t *)alarm);
+}
+#endif  /* SCHED_TASK_ALARM_EN */
+
+#endif  /* SCHED_TASK_EN */
+
+#if SCHED_DAEMON_EN
+/*******************************************************************************
+
+                                  守护任务管理
+
+*******************************************************************************/
+#if SCHED_DYNAMIC_ALLOC_EN
+SchedDaemonHandle_t sched_DaemonCreate(SchedDaemonFunction_t daemonFunc)
+{
+    return ((SchedDaemonHandle_t)framework_DaemonCreate(daemonFunc));
+}
+
+#if SCHED_DAEMON_PRIO_EN
+SchedDaemonHandle_t sched_DaemonCreatePrio(SchedDaemonFunction_t daemonFunc, uint8_t prio)
+{
+    return ((SchedDaemonHandle_t)framework_DaemonCreatePrio(daemonFunc, prio));
+}
+#endif
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+SchedDaemonHandle_t sched_DaemonCreateStatic(SchedDaemonFunction_t daemonFunc,
+                                             SchedDaemonStatic_t *daemonBuf, SchedDaemonQueueItem_t *queueBuf)
+{
+    return ((SchedDaemonHandle_t)framework_DaemonCreateStatic(daemonFunc, daemonBuf, queueBuf));
+}
+
+#if SCHED_DAEMON_PRIO_EN
+SchedDaemonHandle_t sched_DaemonCreatePrioStatic(SchedDaemonFunction_t daemonFunc, uint8_t prio,
+                                                 SchedDaemonStatic_t *daemonBuf, SchedDaemonQueueItem_t *queueBuf)
+{
+    return ((SchedDaemonHandle_t)framework_DaemonCreatePrioStatic(daemonFunc, prio, daemonBuf, queueBuf));
+}
+#endif
+#endif
+
+void sched_DaemonAbort(SchedDaemonHandle_t daemon)
+{
+    framework_DaemonAbort((SchedDaemon_t *)daemon);
+}
+
+SchedStatus_t sched_DaemonCall(SchedDaemonHandle_t daemon, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_DaemonCall((SchedDaemon_t *)daemon, &event, delay);
+}
+
+SchedStatus_t sched_DaemonGetStatus(SchedDaemonHandle_t daemon)
+{
+    return framework_DaemonGetStatus((SchedDaemon_t *)daemon);
+}
+
+SchedStatus_t sched_DaemonCallFromISR(SchedDaemonHandle_t daemon, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay)
+{
+SchedEvent_t event;
+
+    event.sig = evtSig;
+    event.msg = evtMsg;
+    return framework_DaemonCallFromISR((SchedDaemon_t *)daemon, &event, delay);
+}
+
+SchedStatus_t sched_DaemonGetStatusFromISR(SchedDaemonHandle_t daemon)
+{
+    return framework_DaemonGetStatusFromISR((SchedDaemon_t *)daemon);
+}
+
+#if SCHED_DAEMON_OFFLOAD_EN && SCHED_DYNAMIC_ALLOC_EN
+SchedDaemonHandle_t sched_DaemonCreateOffload(SchedOffloadFunction_t offloadFunc, SchedTaskHandle_t task, EvtSig_t doneSig)
+{
+    return ((SchedDaemonHandle_t)framework_DaemonCreateOffload(offloadFunc, task, doneSig));
+}
+#endif
+
+#if SCHED_DAEMON_CYCLE_EN
+void sched_DaemonSetCyclePeriod(SchedDaemonHandle_t daemon, SchedTick_t period, SchedBool_t immedTRIG)
+{
+    framework_DaemonSetCyclePeriod((SchedDaemon_t *)daemon, period, immedTRIG);
+}
+#endif
+
+#if SCHED_DAEMON_CO_EN
+uint16_t sched_DaemonCoGetLine(SchedDaemonHandle_t daemon)
+{
+    return framework_DaemonCoGetLine((SchedDaemon_t *)daemon);
+}
+
+void sched_DaemonCoSetLine(SchedDaemonHandle_t daemon, uint16_t line)
+{
+    framework_DaemonCoSetLine((SchedDaemon_t *)daemon, line);
+}
+
+void sched_DaemonCoYield(SchedDaemonHandle_t daemon, uint16_t line, SchedTick_t delay)
+{
+    framework_DaemonCoYield((SchedDaemon_t *)daemon, line, delay);
+}
+#endif
+
+#endif  /* SCHED_DAEMON_EN */
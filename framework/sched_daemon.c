@@ -1,303 +1,1002 @@
-/*******************************************************************************
-* 文 件 名: sched_daemon.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-08-02
-* 文件说明: 实现事件驱动调度器的核心框架 - 守护任务管理
-*******************************************************************************/
-
-#include "sched_framework.h"
-
-#if SCHED_DAEMON_EN
-/*******************************************************************************
-
-                                    全局变量
-
-*******************************************************************************/
-static SchedList_t daemonReadyList;
-static SchedDaemon_t *currentDaemon;
-
-/*******************************************************************************
-
-                                    操作函数
-
-*******************************************************************************/
-
-/*守护任务管理环境初始化*/
-void framework_DaemonEnvirInit(void)
-{
-    internal_ListInit(&daemonReadyList, SCHED_LIST_HEAD);
-    currentDaemon = NULL;
-}
-
-/**
- * 创建新的守护任务, 仅允许在调度器启动前创建守护任务
- *
- * @param daemonFunc: 守护任务函数
- *
- * @return: 若创建成功, 返回守护任务控制块指针
- *          若创建失败, 返回NULL
- */
-SchedDaemon_t *framework_DaemonCreate(SchedDaemonFunction_t daemonFunc)
-{
-SchedDaemon_t *pDaemon = NULL;
-
-    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_DAEMON_NOT_CREATED_BEFORE_CORE_RUNNING);
-    pDaemon = (SchedDaemon_t *)sched_PortMalloc(sizeof(SchedDaemon_t));
-    if (NULL != pDaemon)
-    {
-        pDaemon->daemonFunc = daemonFunc;
-        internal_ListInit(&pDaemon->daemonListItem, SCHED_LIST_DAEMON);
-    }
-    return (pDaemon);
-}
-
-/**
- * 唤醒守护任务并执行给定的事件
- *
- * @note: 当守护任务处于休眠状态(SCHED_DAEMON_DORMANT)或者
- *        运行状态(SCHED_DAEMON_RUNNING)时,允许唤醒守护任务
- *
- * @param daemon: 守护任务控制块指针
- *
- * @param evt: 守护任务待执行的事件
- *
- * @param delay: 守护任务执行延时, 延时为0表示守护任务立即就绪
- *
- * @return: SCHED_SUCCESS            表示守护任务唤醒成功
- *          SCHED_DAEMON_CALL_FAILED 表示守护任务唤醒失败
- */
-SchedStatus_t framework_DaemonCall(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay)
-{
-SchedStatus_t   ret;
-SchedCPU_t      cpu_sr;
-
-    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        /*守护任务处于休眠状态或者运行状态*/
-        if (SCHED_FALSE != internal_ListIsEmpty(&daemon->daemonListItem))
-        {
-            sched_PortEventCopy(&daemon->event,evt);
-            if (delay > 0)
-            {
-                __framework_CoreTimeManagerAddDelay(&daemon->daemonListItem,delay);
-            }
-            else
-            {
-                internal_ListInsertEnd(&daemonReadyList,&daemon->daemonListItem);
-            }
-            ret = SCHED_SUCCESS;
-        }
-        else
-        {
-            ret = SCHED_DAEMON_CALL_FAILED;
-        }
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-
-    return (ret);
-}
-
-/**
- * 终止指定的守护任务, 使得指定的守护任务进入休眠状态
- *
- * @param daemon: 守护任务控制块指针
- */
-void framework_DaemonAbort(SchedDaemon_t *daemon)
-{
-SchedCPU_t cpu_sr;
-
-    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        internal_ListRemove(&daemon->daemonListItem);
-        __framework_CoreTimeManagerUpdate();
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-}
-
-/**
- * 获取指定守护任务的状态
- *
- * @param daemon: 守护任务控制块指针
- *
- * @return: SCHED_DAEMON_RUNNING 表示守护任务正在运行
- *          SCHED_DAEMON_ACTIVE  表示守护任务已被唤醒
- *          SCHED_DAEMON_DORMANT 表示守护任务处于休眠
- */
-SchedStatus_t framework_DaemonGetStatus(SchedDaemon_t *daemon)
-{
-SchedStatus_t   ret;
-SchedCPU_t      cpu_sr;
-
-    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        if (daemon == currentDaemon)
-        {
-            ret = SCHED_DAEMON_RUNNING;
-        }
-        else if (SCHED_FALSE == internal_ListIsEmpty(&daemon->daemonListItem))
-        {
-            ret = SCHED_DAEMON_ACTIVE;
-        }
-        else
-        {
-            ret = SCHED_DAEMON_DORMANT;
-        }
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-
-    return (ret);
-}
-
-/**
- * 在中断函数中唤醒守护任务并执行给定的事件
- *
- * @note: 仅当守护任务处于休眠状态(SCHED_DAEMON_DORMANT), 允许唤醒守护任务
- *
- * @param daemon: 守护任务控制块指针
- *
- * @param evt: 守护任务待执行的事件
- *
- * @param delay: 守护任务执行延时, 延时为0表示守护任务立即就绪
- *
- * @return: SCHED_SUCCESS            表示守护任务唤醒成功
- *          SCHED_DAEMON_CALL_FAILED 表示守护任务唤醒失败
- */
-SchedStatus_t framework_DaemonCallFromISR(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay)
-{
-SchedStatus_t   ret;
-SchedCPU_t      cpu_sr;
-
-    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
-    cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
-    {
-        /*守护任务处于休眠状态*/
-        if ((SCHED_FALSE != internal_ListIsEmpty(&daemon->daemonListItem)) && (daemon != currentDaemon))
-        {
-            sched_PortEventCopy(&daemon->event,evt);
-            if (delay > 0)
-            {
-                __framework_CoreTimeManagerAddDelay(&daemon->daemonListItem,delay);
-            }
-            else
-            {
-                internal_ListInsertEnd(&daemonReadyList,&daemon->daemonListItem);
-            }
-            ret = SCHED_SUCCESS;
-        }
-        else
-        {
-            ret = SCHED_DAEMON_CALL_FAILED;
-        }
-    }
-    SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
-
-    return (ret);
-}
-
-/**
- * 在中断函数中获取指定守护任务的状态
- *
- * @param daemon: 守护任务控制块指针
- *
- * @return: SCHED_DAEMON_RUNNING 表示守护任务正在运行
- *          SCHED_DAEMON_ACTIVE  表示守护任务已被唤醒
- *          SCHED_DAEMON_DORMANT 表示守护任务处于休眠
- */
-SchedStatus_t framework_DaemonGetStatusFromISR(SchedDaemon_t *daemon)
-{
-SchedStatus_t   ret;
-SchedCPU_t      cpu_sr;
-
-    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
-    cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
-    {
-        if (daemon == currentDaemon)
-        {
-            ret = SCHED_DAEMON_RUNNING;
-        }
-        else if (SCHED_FALSE == internal_ListIsEmpty(&daemon->daemonListItem))
-        {
-            ret = SCHED_DAEMON_ACTIVE;
-        }
-        else
-        {
-            ret = SCHED_DAEMON_DORMANT;
-        }
-    }
-    SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
-
-    return (ret);
-}
-
-/**
- * 完成一次守护任务调度
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE)
- *          SCHED_TRUE  表示完成一次守护任务调度
- *          SCHED_FALSE 表示没有就绪的守护任务,进行了一次空操作
- */
-SchedBool_t framework_DaemonExecute(void)
-{
-SchedBool_t     ret;
-SchedEvent_t    event;
-SchedList_t    *pListItem;
-SchedCPU_t      cpu_sr;
-
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        /*获取就绪守护任务*/
-        if (SCHED_FALSE == internal_ListIsEmpty(&daemonReadyList))
-        {
-            pListItem = internal_ListNext(&daemonReadyList);
-            internal_ListRemove(pListItem);
-            currentDaemon = internal_ListEntry(pListItem,SchedDaemon_t,daemonListItem);
-            sched_PortEventCopy(&event, &currentDaemon->event);
-            ret = SCHED_TRUE;
-        }
-        else
-        {
-            currentDaemon = NULL;
-            ret = SCHED_FALSE;
-        }
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-
-    /*守护任务处理事件*/
-    if (ret)
-    {
-        (currentDaemon->daemonFunc)(currentDaemon, &event);
-    }
-
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        currentDaemon = NULL;
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-
-    return (ret);
-}
-
-/*******************************************************************************
-
-                                    内部函数
-
-*******************************************************************************/
-/**
- * 时间管理器的对象延时到时回调函数
- *
- * @param pArrivalListItem: 结束延时的对象的链表项指针
- *
- * @return: 返回0表示时间管理器无进一步动作,
- *          返回非零值表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
- */
-SchedTick_t __framework_DaemonTimeArrivalHandler(SchedList_t *pArrivalListItem)
-{
-    internal_ListInsertEnd(&daemonReadyList,pArrivalListItem);
-    return (0);
-}
-
-#endif  /* SCHED_DAEMON_EN */
+/*******************************************************************************
+* 文 件 名: sched_daemon.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-08-02
+* 文件说明: 实现事件驱动调度器的核心框架 - 守护任务管理
+*******************************************************************************/
+
+#include "sched_framework.h"
+
+#if SCHED_DAEMON_EN
+/*******************************************************************************
+
+                                    全局变量
+
+*******************************************************************************/
+#if SCHED_DAEMON_PRIO_EN
+/*各优先级的就绪守护任务链表, 以及非空就绪链表记录表*/
+static SchedList_t daemonReadyList[SCHED_DAEMON_LOWEST_PRIO+1];
+static SchedPrioTable_t daemonReadyTable;
+
+/*守护任务最低优先级不能超出优先级记录表的范围*/
+SCHED_STATIC_ASSERT(SCHED_DAEMON_LOWEST_PRIO <= SCHED_PRIOTBL_LOWEST_PRIO,
+                    sched_daemon_lowest_prio_over_priotbl);
+#else
+static SchedList_t daemonReadyList;
+#endif
+static SchedDaemon_t *currentDaemon;
+
+static void prvDaemonInit(SchedDaemon_t *daemon, SchedDaemonFunction_t daemonFunc);
+static void prvDaemonMakeReady(SchedDaemon_t *daemon);
+static SchedDaemon_t * prvDaemonTakeReady(void);
+static SchedBool_t prvDaemonIsRunning(SchedDaemon_t *daemon);
+#if !SCHED_DAEMON_QUEUE_EN
+static SchedBool_t prvDaemonIsActive(SchedDaemon_t *daemon);
+#endif
+#if SCHED_DAEMON_OFFLOAD_EN
+static void prvDaemonOffloadSubmit(SchedDaemon_t *daemon, SchedEvent_t const *evt);
+static void prvDaemonOffloadRun(SchedWorkerJob_t *job);
+#endif
+#if SCHED_DAEMON_CO_EN
+static void prvDaemonCoInit(SchedDaemon_t *daemon);
+#endif
+#if SCHED_DAEMON_CYCLE_EN
+static void prvDaemonCycleCall(SchedDaemon_t *daemon);
+#endif
+#if SCHED_DAEMON_QUEUE_EN
+static void prvDaemonQueueInit(SchedDaemon_t *daemon, SchedDaemonQueueItem_t *queueBuf);
+static SchedStatus_t prvDaemonEnqueue(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay);
+
+/*使能SCHED_QUEUE_POW2_EN时, 调用队列长度必须是2的幂*/
+SCHED_STATIC_ASSERT((0 == SCHED_QUEUE_POW2_EN) || (0 == (SCHED_DAEMON_QUEUE_LEN & (SCHED_DAEMON_QUEUE_LEN-1))),
+                    sched_daemon_queue_len_not_pow2);
+#endif
+
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+
+/*守护任务管理环境初始化*/
+void framework_DaemonEnvirInit(void)
+{
+#if SCHED_DAEMON_PRIO_EN
+uint8_t i;
+
+    for (i=0;i<=SCHED_DAEMON_LOWEST_PRIO;i++)
+    {
+        internal_ListInit(&daemonReadyList[i], SCHED_LIST_HEAD);
+    }
+    internal_PriotblInit(&daemonReadyTable);
+#else
+    internal_ListInit(&daemonReadyList, SCHED_LIST_HEAD);
+#endif
+    currentDaemon = NULL;
+}
+
+#if SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建新的守护任务, 仅允许在调度器启动前创建守护任务
+ *
+ * @param daemonFunc: 守护任务函数
+ *
+ * @return: 若创建成功, 返回守护任务控制块指针
+ *          若创建失败, 返回NULL
+ *
+ * @note: 若使能SCHED_DAEMON_PRIO_EN, 守护任务的优先级为SCHED_DAEMON_LOWEST_PRIO
+ */
+SchedDaemon_t *framework_DaemonCreate(SchedDaemonFunction_t daemonFunc)
+{
+#if SCHED_DAEMON_PRIO_EN
+    return framework_DaemonCreatePrio(daemonFunc, SCHED_DAEMON_LOWEST_PRIO);
+#else
+SchedDaemon_t *pDaemon = NULL;
+
+    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_DAEMON_NOT_CREATED_BEFORE_CORE_RUNNING);
+    pDaemon = (SchedDaemon_t *)sched_PortMalloc(sizeof(SchedDaemon_t));
+    if (NULL != pDaemon)
+    {
+        prvDaemonInit(pDaemon, daemonFunc);
+    #if SCHED_DAEMON_QUEUE_EN
+        prvDaemonQueueInit(pDaemon, (SchedDaemonQueueItem_t *)sched_PortMalloc(SCHED_DAEMON_QUEUE_BUF_LEN*sizeof(SchedDaemonQueueItem_t)));
+    #endif
+    }
+    return (pDaemon);
+#endif
+}
+
+#if SCHED_DAEMON_PRIO_EN
+/**
+ * 创建指定优先级的新守护任务, 仅允许在调度器启动前创建守护任务,
+ * 多个守护任务可以使用相同的优先级, 相同优先级的守护任务按就绪顺序执行
+ *
+ * @param daemonFunc: 守护任务函数
+ *
+ * @param prio: 守护任务优先级(0 - SCHED_DAEMON_LOWEST_PRIO), 0为最高优先级
+ *
+ * @return: 若创建成功, 返回守护任务控制块指针
+ *          若创建失败, 返回NULL
+ */
+SchedDaemon_t *framework_DaemonCreatePrio(SchedDaemonFunction_t daemonFunc, uint8_t prio)
+{
+SchedDaemon_t *pDaemon = NULL;
+
+    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_DAEMON_NOT_CREATED_BEFORE_CORE_RUNNING);
+    SCHED_ASSERT(prio<=SCHED_DAEMON_LOWEST_PRIO,errSCHED_DAEMON_PRIO_OVER_LOWEST);
+    pDaemon = (SchedDaemon_t *)sched_PortMalloc(sizeof(SchedDaemon_t));
+    if (NULL != pDaemon)
+    {
+        prvDaemonInit(pDaemon, daemonFunc);
+        pDaemon->prio = prio;
+    #if SCHED_DAEMON_QUEUE_EN
+        prvDaemonQueueInit(pDaemon, (SchedDaemonQueueItem_t *)sched_PortMalloc(SCHED_DAEMON_QUEUE_BUF_LEN*sizeof(SchedDaemonQueueItem_t)));
+    #endif
+    }
+    return (pDaemon);
+}
+#endif
+#endif  /* SCHED_DYNAMIC_ALLOC_EN */
+
+#if SCHED_STATIC_ALLOC_EN
+/**
+ * 使用调用者提供的存储空间创建新的守护任务, 仅允许在调度器启动前创建守护任务
+ *
+ * @param daemonFunc: 守护任务函数
+ *
+ * @param daemonBuf: 守护任务控制块存储空间
+ *
+ * @param queueBuf: 调用队列存储空间, 长度为SCHED_DAEMON_QUEUE_BUF_LEN,
+ *                  未使能SCHED_DAEMON_QUEUE_EN时为NULL
+ *
+ * @return: 守护任务控制块指针
+ *
+ * @note: 若使能SCHED_DAEMON_PRIO_EN, 守护任务的优先级为SCHED_DAEMON_LOWEST_PRIO
+ */
+SchedDaemon_t *framework_DaemonCreateStatic(SchedDaemonFunction_t daemonFunc,
+                                            SchedDaemon_t *daemonBuf, SchedDaemonQueueItem_t *queueBuf)
+{
+#if SCHED_DAEMON_PRIO_EN
+    return framework_DaemonCreatePrioStatic(daemonFunc, SCHED_DAEMON_LOWEST_PRIO, daemonBuf, queueBuf);
+#else
+    SCHED_ASSERT(NULL != daemonBuf,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT((0 == SCHED_DAEMON_QUEUE_BUF_LEN) == (NULL == queueBuf),errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_DAEMON_NOT_CREATED_BEFORE_CORE_RUNNING);
+    prvDaemonInit(daemonBuf, daemonFunc);
+#if SCHED_DAEMON_QUEUE_EN
+    prvDaemonQueueInit(daemonBuf, queueBuf);
+#endif
+    return (daemonBuf);
+#endif
+}
+
+#if SCHED_DAEMON_PRIO_EN
+/**
+ * 使用调用者提供的存储空间创建指定优先级的新守护任务
+ *
+ * @param daemonFunc: 守护任务函数
+ *
+ * @param prio: 守护任务优先级(0 - SCHED_DAEMON_LOWEST_PRIO), 0为最高优先级
+ *
+ * @param daemonBuf: 守护任务控制块存储空间
+ *
+ * @param queueBuf: 调用队列存储空间, 同framework_DaemonCreateStatic()
+ *
+ * @return: 守护任务控制块指针
+ */
+SchedDaemon_t *framework_DaemonCreatePrioStatic(SchedDaemonFunction_t daemonFunc, uint8_t prio,
+                                                SchedDaemon_t *daemonBuf, SchedDaemonQueueItem_t *queueBuf)
+{
+    SCHED_ASSERT(NULL != daemonBuf,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT((0 == SCHED_DAEMON_QUEUE_BUF_LEN) == (NULL == queueBuf),errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_DAEMON_NOT_CREATED_BEFORE_CORE_RUNNING);
+    SCHED_ASSERT(prio<=SCHED_DAEMON_LOWEST_PRIO,errSCHED_DAEMON_PRIO_OVER_LOWEST);
+    prvDaemonInit(daemonBuf, daemonFunc);
+    daemonBuf->prio = prio;
+#if SCHED_DAEMON_QUEUE_EN
+    prvDaemonQueueInit(daemonBuf, queueBuf);
+#endif
+    return (daemonBuf);
+}
+#endif
+#endif  /* SCHED_STATIC_ALLOC_EN */
+
+#if SCHED_DAEMON_OFFLOAD_EN && SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建卸载到工作线程执行的新守护任务, 仅允许在调度器启动前创建守护任务;
+ * 守护任务被调度时将事件作为作业提交到工作线程池, 调度函数立即返回,
+ * 作业完成后以函数返回值为消息向指定任务发送完成事件
+ *
+ * @param offloadFunc: 在工作线程中执行的函数, 不允许调用调度器接口
+ *
+ * @param task: 接收完成事件的任务, NULL表示不发送完成事件
+ *
+ * @param doneSig: 完成事件信号
+ *
+ * @return: 若创建成功, 返回守护任务控制块指针
+ *          若创建失败, 返回NULL
+ *
+ * @note: 每个守护任务同时只有一个作业在执行, 作业执行期间守护任务处于运行状态,
+ *        此时被调用的守护任务在作业完成后就绪
+ */
+SchedDaemon_t *framework_DaemonCreateOffload(SchedOffloadFunction_t offloadFunc, SchedTaskHandle_t task, EvtSig_t doneSig)
+{
+SchedDaemon_t *pDaemon;
+
+    SCHED_ASSERT(NULL != offloadFunc,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT((NULL == task) || (doneSig >= SCHED_SIG_USER),errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+    pDaemon = framework_DaemonCreate(NULL);
+    if (NULL != pDaemon)
+    {
+        pDaemon->offloadFunc = offloadFunc;
+        pDaemon->doneTask    = task;
+        pDaemon->doneSig     = doneSig;
+        pDaemon->job.func    = prvDaemonOffloadRun;
+    }
+    return (pDaemon);
+}
+#endif
+
+/**
+ * 唤醒守护任务并执行给定的事件
+ *
+ * @note: 当守护任务处于休眠状态(SCHED_DAEMON_DORMANT)或者
+ *        运行状态(SCHED_DAEMON_RUNNING)时,允许唤醒守护任务
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @param evt: 守护任务待执行的事件
+ *
+ * @param delay: 守护任务执行延时, 延时为0表示守护任务立即就绪
+ *
+ * @return: SCHED_SUCCESS            表示守护任务唤醒成功
+ *          SCHED_DAEMON_CALL_FAILED 表示守护任务唤醒失败
+ */
+SchedStatus_t framework_DaemonCall(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay)
+{
+SchedStatus_t   ret;
+SchedCPU_t      cpu_sr;
+
+    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+    #if SCHED_DAEMON_QUEUE_EN
+        ret = prvDaemonEnqueue(daemon, evt, delay);
+    #else
+        /*守护任务处于休眠状态或者运行状态*/
+        if (SCHED_FALSE == prvDaemonIsActive(daemon))
+        {
+            sched_PortEventCopy(&daemon->event,evt);
+            if (delay > 0)
+            {
+                __framework_CoreTimeManagerAddDelay(&daemon->daemonListItem,delay);
+            }
+            else
+            {
+                prvDaemonMakeReady(daemon);
+            }
+            ret = SCHED_SUCCESS;
+        }
+        else
+        {
+            ret = SCHED_DAEMON_CALL_FAILED;
+        }
+    #endif
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (ret);
+}
+
+/**
+ * 终止指定的守护任务, 使得指定的守护任务进入休眠状态
+ *
+ * @param daemon: 守护任务控制块指针
+ */
+void framework_DaemonAbort(SchedDaemon_t *daemon)
+{
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        internal_ListRemove(&daemon->daemonListItem);
+        __framework_CoreTimeManagerUpdate();
+    #if SCHED_DAEMON_QUEUE_EN
+        /*丢弃调用队列中等待的调用, 已开始延时的调用不受影响*/
+        {
+        SchedEvent_t event;
+
+            while (SCHED_FALSE != internal_QueueReceive(&daemon->queue, &event))
+            {
+            }
+        }
+    #endif
+    #if SCHED_DAEMON_CO_EN
+        /*协程下次调用时从头执行*/
+        prvDaemonCoInit(daemon);
+    #endif
+    #if SCHED_DAEMON_OFFLOAD_EN
+        /*正在执行的作业不能终止, 只取消作业完成后的就绪*/
+        if (SCHED_OFFLOAD_PENDING == daemon->offloadState)
+        {
+            daemon->offloadState = SCHED_OFFLOAD_BUSY;
+        }
+    #endif
+    #if SCHED_DAEMON_PRIO_EN
+        /*守护任务可能是所在优先级最后一个就绪守护任务*/
+        if (SCHED_FALSE != internal_ListIsEmpty(&daemonReadyList[daemon->prio]))
+        {
+            internal_PriotblResetPrio(&daemonReadyTable, daemon->prio);
+        }
+    #endif
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+}
+
+/**
+ * 获取指定守护任务的状态
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @return: SCHED_DAEMON_RUNNING 表示守护任务正在运行
+ *          SCHED_DAEMON_ACTIVE  表示守护任务已被唤醒
+ *          SCHED_DAEMON_DORMANT 表示守护任务处于休眠
+ */
+SchedStatus_t framework_DaemonGetStatus(SchedDaemon_t *daemon)
+{
+SchedStatus_t   ret;
+SchedCPU_t      cpu_sr;
+
+    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        if (SCHED_FALSE != prvDaemonIsRunning(daemon))
+        {
+            ret = SCHED_DAEMON_RUNNING;
+        }
+        else if (SCHED_FALSE == internal_ListIsEmpty(&daemon->daemonListItem))
+        {
+            ret = SCHED_DAEMON_ACTIVE;
+        }
+        else
+        {
+            ret = SCHED_DAEMON_DORMANT;
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (ret);
+}
+
+/**
+ * 在中断函数中唤醒守护任务并执行给定的事件
+ *
+ * @note: 仅当守护任务处于休眠状态(SCHED_DAEMON_DORMANT), 允许唤醒守护任务
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @param evt: 守护任务待执行的事件
+ *
+ * @param delay: 守护任务执行延时, 延时为0表示守护任务立即就绪
+ *
+ * @return: SCHED_SUCCESS            表示守护任务唤醒成功
+ *          SCHED_DAEMON_CALL_FAILED 表示守护任务唤醒失败
+ */
+SchedStatus_t framework_DaemonCallFromISR(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay)
+{
+SchedStatus_t   ret;
+SchedCPU_t      cpu_sr;
+
+    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
+    {
+    #if SCHED_DAEMON_QUEUE_EN
+        ret = prvDaemonEnqueue(daemon, evt, delay);
+    #else
+        /*守护任务处于休眠状态*/
+        if ((SCHED_FALSE == prvDaemonIsActive(daemon)) && (SCHED_FALSE == prvDaemonIsRunning(daemon)))
+        {
+            sched_PortEventCopy(&daemon->event,evt);
+            if (delay > 0)
+            {
+                __framework_CoreTimeManagerAddDelay(&daemon->daemonListItem,delay);
+            }
+            else
+            {
+                prvDaemonMakeReady(daemon);
+            }
+            ret = SCHED_SUCCESS;
+        }
+        else
+        {
+            ret = SCHED_DAEMON_CALL_FAILED;
+        }
+    #endif
+    }
+    SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
+
+    return (ret);
+}
+
+/**
+ * 在中断函数中获取指定守护任务的状态
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @return: SCHED_DAEMON_RUNNING 表示守护任务正在运行
+ *          SCHED_DAEMON_ACTIVE  表示守护任务已被唤醒
+ *          SCHED_DAEMON_DORMANT 表示守护任务处于休眠
+ */
+SchedStatus_t framework_DaemonGetStatusFromISR(SchedDaemon_t *daemon)
+{
+SchedStatus_t   ret;
+SchedCPU_t      cpu_sr;
+
+    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
+    {
+        if (SCHED_FALSE != prvDaemonIsRunning(daemon))
+        {
+            ret = SCHED_DAEMON_RUNNING;
+        }
+        else if (SCHED_FALSE == internal_ListIsEmpty(&daemon->daemonListItem))
+        {
+            ret = SCHED_DAEMON_ACTIVE;
+        }
+        else
+        {
+            ret = SCHED_DAEMON_DORMANT;
+        }
+    }
+    SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
+
+    return (ret);
+}
+
+/**
+ * 完成一次守护任务调度
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE)
+ *          SCHED_TRUE  表示完成一次守护任务调度
+ *          SCHED_FALSE 表示没有就绪的守护任务,进行了一次空操作
+ */
+SchedBool_t framework_DaemonExecute(void)
+{
+SchedBool_t     ret;
+SchedEvent_t    event;
+SchedCPU_t      cpu_sr;
+#if SCHED_DAEMON_OFFLOAD_EN
+SchedBool_t     collected;
+
+    /*向任务发送已完成作业的完成事件*/
+    collected = __framework_DaemonOffloadCollect();
+#endif
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        /*获取就绪守护任务*/
+        currentDaemon = prvDaemonTakeReady();
+        if (NULL != currentDaemon)
+        {
+        #if SCHED_DAEMON_QUEUE_EN && SCHED_DAEMON_CO_EN
+            /*协程从让出点恢复时继续处理原事件*/
+            if (SCHED_FALSE == currentDaemon->coResume)
+            {
+                (void)internal_QueueReceive(&currentDaemon->queue, &currentDaemon->coEvent);
+            }
+            currentDaemon->coResume = SCHED_FALSE;
+            sched_PortEventCopy(&event, &currentDaemon->coEvent);
+        #elif SCHED_DAEMON_QUEUE_EN
+            (void)internal_QueueReceive(&currentDaemon->queue, &event);
+        #else
+            sched_PortEventCopy(&event, &currentDaemon->event);
+        #endif
+        #if SCHED_DAEMON_OFFLOAD_EN
+            if (NULL != currentDaemon->offloadFunc)
+            {
+                currentDaemon->offloadState = SCHED_OFFLOAD_BUSY;
+            }
+        #endif
+            ret = SCHED_TRUE;
+        }
+        else
+        {
+            ret = SCHED_FALSE;
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    /*守护任务处理事件*/
+    if (ret)
+    {
+    #if SCHED_DAEMON_OFFLOAD_EN
+        if (NULL != currentDaemon->offloadFunc)
+        {
+            prvDaemonOffloadSubmit(currentDaemon, &event);
+        }
+        else
+    #endif
+        {
+            (currentDaemon->daemonFunc)(currentDaemon, &event);
+        }
+    }
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+    #if SCHED_DAEMON_QUEUE_EN
+        /*调用队列中还有等待的调用, 守护任务重新就绪(协程让出时已就绪或者开始延时)*/
+        if (ret && (SCHED_FALSE == internal_QueueIsEmpty(&currentDaemon->queue))
+                && (SCHED_FALSE != internal_ListIsEmpty(&currentDaemon->daemonListItem)))
+        {
+            prvDaemonMakeReady(currentDaemon);
+        }
+    #endif
+        currentDaemon = NULL;
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+#if SCHED_DAEMON_OFFLOAD_EN
+    return ((SchedBool_t)(ret || collected));
+#else
+    return (ret);
+#endif
+}
+
+#if SCHED_DAEMON_CYCLE_EN
+/**
+ * 设置守护任务周期调用的周期, 每个周期以SCHED_SIG_CYCLE信号调用一次守护任务,
+ * 到时守护任务不允许被调用(或者调用队列已满)时跳过本次调用;
+ * 周期调用不受sched_DaemonAbort()影响, 周期设置为0停止周期调用
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @param period: 周期调用的周期, 若为0则停止周期调用
+ *
+ * @param immedTRIG: 设置是否立即调用一次守护任务(SCHED_TRUE/SCHED_FALSE)
+ */
+void framework_DaemonSetCyclePeriod(SchedDaemon_t *daemon, SchedTick_t period, SchedBool_t immedTRIG)
+{
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT((SCHED_FALSE == immedTRIG)||(SCHED_TRUE == immedTRIG),errSCHED_PARAM_NOT_ALLOWED);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        internal_ListRemove(&daemon->cycleListItem);
+        daemon->cyclePeriod = period;
+        /*直接调用守护任务*/
+        if (immedTRIG)
+        {
+            prvDaemonCycleCall(daemon);
+        }
+        /*添加延时对象*/
+        if (period > 0)
+        {
+            __framework_CoreTimeManagerAddDelay(&daemon->cycleListItem, period);
+        }
+        __framework_CoreTimeManagerUpdate();
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+}
+#endif  /* SCHED_DAEMON_CYCLE_EN */
+
+#if SCHED_DAEMON_CO_EN
+/**
+ * 获取协程断点行号, 由SCHED_CO_BEGIN()调用
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @return: 断点行号, 0表示从头执行
+ */
+uint16_t framework_DaemonCoGetLine(SchedDaemon_t *daemon)
+{
+    SCHED_ASSERT(NULL != daemon,errSCHED_PARAM_PTR_IS_NULL);
+    return (daemon->coLine);
+}
+
+/**
+ * 设置协程断点行号, 由SCHED_CO_WAIT()和SCHED_CO_END()调用,
+ * 守护任务返回后进入休眠, 下次被调用时从断点继续执行
+ *
+ * @param daemon: 当前运行的守护任务控制块指针
+ *
+ * @param line: 断点行号, 0表示下次从头执行
+ */
+void framework_DaemonCoSetLine(SchedDaemon_t *daemon, uint16_t line)
+{
+    SCHED_ASSERT(daemon == currentDaemon,errSCHED_DAEMON_CO_NOT_RUNNING);
+    daemon->coLine = line;
+}
+
+/**
+ * 设置协程断点行号并让出, 由SCHED_CO_YIELD()和SCHED_CO_SLEEP()调用,
+ * 守护任务返回后重新就绪(或者延时后重新就绪), 并从断点继续处理原事件
+ *
+ * @param daemon: 当前运行的守护任务控制块指针
+ *
+ * @param line: 断点行号
+ *
+ * @param delay: 让出延时节拍数, 0表示立即重新就绪
+ *
+ * @note: 若守护任务运行期间被再次调用且已经就绪, 协程立即从断点继续执行新事件
+ */
+void framework_DaemonCoYield(SchedDaemon_t *daemon, uint16_t line, SchedTick_t delay)
+{
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(daemon == currentDaemon,errSCHED_DAEMON_CO_NOT_RUNNING);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        daemon->coLine = line;
+        if (SCHED_FALSE != internal_ListIsEmpty(&daemon->daemonListItem))
+        {
+        #if SCHED_DAEMON_QUEUE_EN
+            daemon->coResume = SCHED_TRUE;
+        #endif
+            if (delay > 0)
+            {
+                __framework_CoreTimeManagerAddDelay(&daemon->daemonListItem,delay);
+            }
+            else
+            {
+                prvDaemonMakeReady(daemon);
+            }
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+}
+#endif  /* SCHED_DAEMON_CO_EN */
+
+/*******************************************************************************
+
+                                    内部函数
+
+*******************************************************************************/
+/**
+ * 时间管理器的对象延时到时回调函数
+ *
+ * @param pArrivalListItem: 结束延时的对象的链表项指针
+ *
+ * @return: 返回0表示时间管理器无进一步动作,
+ *          返回非零值表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
+ */
+SchedTick_t __framework_DaemonTimeArrivalHandler(SchedList_t *pArrivalListItem)
+{
+    prvDaemonMakeReady(internal_ListEntry(pArrivalListItem,SchedDaemon_t,daemonListItem));
+    return (0);
+}
+
+#if SCHED_DAEMON_CYCLE_EN
+/**
+ * 守护任务周期调用到时回调函数
+ *
+ * @param pArrivalListItem: 结束延时的对象的链表项指针
+ *
+ * @return: 守护任务周期调用的周期, 时间管理器将当前对象重新加入延时链表
+ */
+SchedTick_t __framework_DaemonCycleArrivalHandler(SchedList_t *pArrivalListItem)
+{
+SchedDaemon_t *pDaemon;
+
+    pDaemon = internal_ListEntry(pArrivalListItem,SchedDaemon_t,cycleListItem);
+    if (pDaemon->cyclePeriod > 0)
+    {
+        prvDaemonCycleCall(pDaemon);
+    }
+    return (pDaemon->cyclePeriod);
+}
+#endif
+
+#if SCHED_DAEMON_OFFLOAD_EN
+/**
+ * 处理已完成的作业: 恢复守护任务状态并向任务发送完成事件,
+ * 调度器每次循环都会调用, 任务持续就绪时完成事件也能及时送达
+ *
+ * @return: SCHED_TRUE 表示处理了至少一个已完成的作业
+ */
+SchedBool_t __framework_DaemonOffloadCollect(void)
+{
+SchedWorkerJob_t   *pJob;
+SchedDaemon_t      *pDaemon;
+SchedEvent_t        event;
+SchedCPU_t          cpu_sr;
+SchedBool_t         ret = SCHED_FALSE;
+
+    pJob = sched_PortWorkerTakeDone();
+    while (NULL != pJob)
+    {
+        pDaemon = container_of(pJob, SchedDaemon_t, job);
+        pJob    = pJob->next;
+        event.sig = pDaemon->doneSig;
+        event.msg = pDaemon->jobResult;
+        cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+        {
+            if (SCHED_OFFLOAD_PENDING == pDaemon->offloadState)
+            {
+                pDaemon->offloadState = SCHED_OFFLOAD_IDLE;
+                prvDaemonMakeReady(pDaemon);
+            }
+            else
+            {
+                pDaemon->offloadState = SCHED_OFFLOAD_IDLE;
+            }
+        }
+        SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    #if SCHED_TASK_EN
+        if (NULL != pDaemon->doneTask)
+        {
+            if (SCHED_SUCCESS != framework_EventSend((SchedTask_t *)pDaemon->doneTask, &event))
+            {
+                /*任务消息队列已满, 完成事件丢失*/
+                SCHED_CHECK(0,chkSCHED_EVENT_SEND_FAILED);
+            }
+        }
+    #endif
+        ret = SCHED_TRUE;
+    }
+    return (ret);
+}
+#endif
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+
+/**
+ * 初始化守护任务控制块, 调用队列和优先级由创建函数初始化
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @param daemonFunc: 守护任务函数
+ */
+static void prvDaemonInit(SchedDaemon_t *daemon, SchedDaemonFunction_t daemonFunc)
+{
+    daemon->daemonFunc = daemonFunc;
+    internal_ListInit(&daemon->daemonListItem, SCHED_LIST_DAEMON);
+#if SCHED_DAEMON_CO_EN
+    prvDaemonCoInit(daemon);
+#endif
+#if SCHED_DAEMON_CYCLE_EN
+    daemon->cyclePeriod = 0;
+    internal_ListInit(&daemon->cycleListItem, SCHED_LIST_DAEMON_CYCLE);
+#endif
+#if SCHED_DAEMON_OFFLOAD_EN
+    daemon->offloadFunc  = NULL;
+    daemon->offloadState = SCHED_OFFLOAD_IDLE;
+#endif
+}
+
+/**
+ * 将守护任务加入就绪链表尾部, 调用前需进入临界区
+ *
+ * @param daemon: 守护任务控制块指针, 其链表项必须是孤立的
+ */
+static void prvDaemonMakeReady(SchedDaemon_t *daemon)
+{
+#if SCHED_DAEMON_OFFLOAD_EN
+    /*作业仍在工作线程中执行, 作业完成后再就绪*/
+    if (SCHED_OFFLOAD_IDLE != daemon->offloadState)
+    {
+        daemon->offloadState = SCHED_OFFLOAD_PENDING;
+    }
+    else
+#endif
+    {
+    #if SCHED_DAEMON_PRIO_EN
+        internal_ListInsertEnd(&daemonReadyList[daemon->prio],&daemon->daemonListItem);
+        internal_PriotblRecordPrio(&daemonReadyTable, daemon->prio);
+    #else
+        internal_ListInsertEnd(&daemonReadyList,&daemon->daemonListItem);
+    #endif
+    }
+}
+
+/**
+ * 从就绪链表中取出最高优先级的守护任务, 调用前需进入临界区
+ *
+ * @return: 若有就绪守护任务, 返回守护任务控制块指针
+ *          若没有就绪守护任务, 返回NULL
+ */
+static SchedDaemon_t * prvDaemonTakeReady(void)
+{
+SchedDaemon_t  *pDaemon = NULL;
+SchedList_t    *pListItem;
+#if SCHED_DAEMON_PRIO_EN
+uint8_t         prio;
+
+    if (SCHED_FALSE == internal_PriotblIsEmpty(&daemonReadyTable))
+    {
+        prio = internal_PriotblGetHighestPrio(&daemonReadyTable);
+        pListItem = internal_ListRemoveFirst(&daemonReadyList[prio]);
+        if (SCHED_FALSE != internal_ListIsEmpty(&daemonReadyList[prio]))
+        {
+            internal_PriotblResetPrio(&daemonReadyTable, prio);
+        }
+        pDaemon = internal_ListEntry(pListItem,SchedDaemon_t,daemonListItem);
+    }
+#else
+    /*经由取出的链表项而非链表头获取守护任务控制块*/
+    pListItem = internal_ListRemoveFirst(&daemonReadyList);
+    if (NULL != pListItem)
+    {
+        pDaemon = internal_ListEntry(pListItem,SchedDaemon_t,daemonListItem);
+    }
+#endif
+    return (pDaemon);
+}
+
+/**
+ * 判断守护任务是否处于运行状态, 调用前需进入临界区
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @return: SCHED_TRUE 表示守护任务正在调度线程(或者工作线程)中运行
+ */
+static SchedBool_t prvDaemonIsRunning(SchedDaemon_t *daemon)
+{
+SchedBool_t ret;
+
+    ret = (daemon == currentDaemon) ? SCHED_TRUE : SCHED_FALSE;
+#if SCHED_DAEMON_OFFLOAD_EN
+    if (SCHED_OFFLOAD_IDLE != daemon->offloadState)
+    {
+        ret = SCHED_TRUE;
+    }
+#endif
+    return (ret);
+}
+
+#if !SCHED_DAEMON_QUEUE_EN
+/**
+ * 判断守护任务是否已被唤醒(就绪, 延时或者等待作业完成后就绪), 调用前需进入临界区
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @return: SCHED_TRUE 表示守护任务已被唤醒
+ */
+static SchedBool_t prvDaemonIsActive(SchedDaemon_t *daemon)
+{
+SchedBool_t ret;
+
+    ret = (SCHED_FALSE == internal_ListIsEmpty(&daemon->daemonListItem)) ? SCHED_TRUE : SCHED_FALSE;
+#if SCHED_DAEMON_OFFLOAD_EN
+    if (SCHED_OFFLOAD_PENDING == daemon->offloadState)
+    {
+        ret = SCHED_TRUE;
+    }
+#endif
+    return (ret);
+}
+#endif
+
+#if SCHED_DAEMON_OFFLOAD_EN
+/**
+ * 将守护任务事件作为作业提交到工作线程池, 作业队列已满时在调度线程中直接执行
+ *
+ * @param daemon: 守护任务控制块指针, 卸载状态已设置为SCHED_OFFLOAD_BUSY
+ *
+ * @param evt: 守护任务待执行的事件
+ */
+static void prvDaemonOffloadSubmit(SchedDaemon_t *daemon, SchedEvent_t const *evt)
+{
+    sched_PortEventCopy(&daemon->jobEvent, evt);
+    if (SCHED_FALSE == sched_PortWorkerSubmit(&daemon->job))
+    {
+        prvDaemonOffloadRun(&daemon->job);
+    }
+}
+
+/**
+ * 工作线程作业函数, 执行卸载函数并报告作业完成
+ *
+ * @param job: 守护任务的作业指针
+ */
+static void prvDaemonOffloadRun(SchedWorkerJob_t *job)
+{
+SchedDaemon_t *pDaemon;
+
+    pDaemon = container_of(job, SchedDaemon_t, job);
+    pDaemon->jobResult = (pDaemon->offloadFunc)(pDaemon, &pDaemon->jobEvent);
+    sched_PortWorkerComplete(job);
+}
+#endif  /* SCHED_DAEMON_OFFLOAD_EN */
+
+#if SCHED_DAEMON_CYCLE_EN
+/**
+ * 以SCHED_SIG_CYCLE信号调用一次守护任务, 调用前需进入临界区,
+ * 守护任务不允许被调用时跳过本次调用
+ *
+ * @param daemon: 守护任务控制块指针
+ */
+static void prvDaemonCycleCall(SchedDaemon_t *daemon)
+{
+SchedEvent_t event;
+
+    event.sig = SCHED_SIG_CYCLE;
+    event.msg = 0;
+#if SCHED_DAEMON_QUEUE_EN
+    (void)prvDaemonEnqueue(daemon, &event, 0);
+#else
+    /*守护任务处于休眠状态*/
+    if ((SCHED_FALSE == prvDaemonIsActive(daemon)) && (SCHED_FALSE == prvDaemonIsRunning(daemon)))
+    {
+        sched_PortEventCopy(&daemon->event, &event);
+        prvDaemonMakeReady(daemon);
+    }
+#endif
+}
+#endif
+
+#if SCHED_DAEMON_CO_EN
+/**
+ * 复位守护任务协程, 下次调用时从头执行
+ *
+ * @param daemon: 守护任务控制块指针
+ */
+static void prvDaemonCoInit(SchedDaemon_t *daemon)
+{
+    daemon->coLine   = 0;
+#if SCHED_DAEMON_QUEUE_EN
+    daemon->coResume = SCHED_FALSE;
+#endif
+}
+#endif
+
+#if SCHED_DAEMON_QUEUE_EN
+/**
+ * 初始化守护任务调用队列
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @param queueBuf: 调用队列存储空间, 长度为SCHED_DAEMON_QUEUE_BUF_LEN,
+ *                  为NULL时调用队列长度为0
+ */
+static void prvDaemonQueueInit(SchedDaemon_t *daemon, SchedDaemonQueueItem_t *queueBuf)
+{
+#if SCHED_EVENT_POOL_EN
+    internal_EventPoolInit(&daemon->pool, queueBuf, (NULL != queueBuf) ? SCHED_DAEMON_QUEUE_LEN : 0);
+    internal_QueueInit(&daemon->queue, &daemon->pool, SCHED_DAEMON_QUEUE_LEN);
+#else
+    internal_QueueInit(&daemon->queue, queueBuf, (NULL != queueBuf) ? SCHED_DAEMON_QUEUE_LEN : 0);
+#endif
+}
+
+/**
+ * 将一次调用加入守护任务调用队列, 调用前需进入临界区
+ *
+ * @param daemon: 守护任务控制块指针
+ *
+ * @param evt: 守护任务待执行的事件
+ *
+ * @param delay: 执行延时, 延时调用占用一个定时节点, 到时再加入调用队列
+ *
+ * @return: SCHED_SUCCESS            表示调用成功
+ *          SCHED_DAEMON_CALL_FAILED 表示调用队列已满(或者定时节点已用完)
+ */
+static SchedStatus_t prvDaemonEnqueue(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay)
+{
+SchedStatus_t ret = SCHED_DAEMON_CALL_FAILED;
+
+    if (delay > 0)
+    {
+        ret = __framework_TimerDaemonCall(daemon, evt, delay);
+    }
+    else if (SCHED_FALSE != internal_QueueSend(&daemon->queue, evt))
+    {
+        /*运行中的守护任务在本次运行结束后由调度函数重新加入就绪链表*/
+        if ((SCHED_FALSE != internal_ListIsEmpty(&daemon->daemonListItem)) && (daemon != currentDaemon))
+        {
+            prvDaemonMakeReady(daemon);
+        }
+        ret = SCHED_SUCCESS;
+    }
+    return (ret);
+}
+#endif  /* SCHED_DAEMON_QUEUE_EN */
+
+#endif  /* SCHED_DAEMON_EN */
@@ -1,233 +1,446 @@
-/*******************************************************************************
-* 文 件 名: sched_event_queue.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-31
-* 文件说明: 实现事件驱动调度器的核心框架 - 事件管理(消息队列)
-*******************************************************************************/
-
-#include "sched_framework.h"
-
-#if SCHED_TASK_EN && (SCHED_TASK_EVENT_METHOD >= 1)
-/*******************************************************************************
-
-                                    操作函数
-
-*******************************************************************************/
-
-/**
- * 向指定任务传递一个事件
- *
- * @param task: 目标任务控制块指针
- *
- * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t framework_EventSend(SchedTask_t *task, SchedEvent_t const *evt)
-{
-SchedStatus_t ret;
-SchedCPU_t cpu_sr;
-
-    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
-    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
-    SCHED_ASSERT(SCHED_CORE_RUNNING == framework_CoreStatus,errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING);
-
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        if (SCHED_FALSE != internal_QueueSend(&task->queue, evt))
-        {
-            __framework_TaskRecordReadyTask(task);
-            ret = SCHED_SUCCESS;
-        }
-        else
-        {
-            ret = SCHED_EVENT_SEND_FAILED;
-            SCHED_CHECK(0,chkSCHED_EVENT_SEND_FAILED);
-        }
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-
-    return (ret);
-}
-
-/**
- * 向指定任务传递一个紧急事件
- *
- * @param task: 目标任务控制块指针
- *
- * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t framework_EventSendFront(SchedTask_t *task, SchedEvent_t const *evt)
-{
-SchedStatus_t ret;
-SchedCPU_t cpu_sr;
-
-    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
-    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
-    SCHED_ASSERT(SCHED_CORE_RUNNING == framework_CoreStatus,errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING);
-
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        if (SCHED_FALSE != internal_QueueSendFront(&task->queue, evt))
-        {
-            __framework_TaskRecordReadyTask(task);
-            ret = SCHED_SUCCESS;
-        }
-        else
-        {
-            ret = SCHED_EVENT_SEND_FAILED;
-            SCHED_CHECK(0,chkSCHED_EVENT_SEND_FAILED);
-        }
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-
-    return (ret);
-}
-
-/**
- * 在中断函数中向指定任务传递一个事件
- *
- * @param task: 目标任务控制块指针
- *
- * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t framework_EventSendFromISR(SchedTask_t *task, SchedEvent_t const *evt)
-{
-SchedStatus_t ret;
-SchedCPU_t cpu_sr;
-
-    if (SCHED_CORE_RUNNING == framework_CoreStatus)
-    {
-        SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
-        SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
-        cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
-        {
-            if (SCHED_FALSE != internal_QueueSend(&task->queue, evt))
-            {
-                __framework_TaskRecordReadyTask(task);
-                ret = SCHED_SUCCESS;
-            }
-            else
-            {
-                ret = SCHED_EVENT_SEND_FAILED;
-                SCHED_CHECK(0,chkSCHED_EVENT_SEND_FAILED);
-            }
-        }
-        SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
-    }
-    else
-    {
-        ret = SCHED_EVENT_SEND_FAILED;
-    }
-
-    return (ret);
-}
-
-/**
- * 在中断函数中向指定任务传递一个紧急事件
- *
- * @param task: 目标任务控制块指针
- *
- * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t framework_EventSendFrontFromISR(SchedTask_t *task, SchedEvent_t const *evt)
-{
-SchedStatus_t ret;
-SchedCPU_t cpu_sr;
-
-    if (SCHED_CORE_RUNNING == framework_CoreStatus)
-    {
-        SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
-        SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
-        cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
-        {
-            if (SCHED_FALSE != internal_QueueSendFront(&task->queue, evt))
-            {
-                __framework_TaskRecordReadyTask(task);
-                ret = SCHED_SUCCESS;
-            }
-            else
-            {
-                ret = SCHED_EVENT_SEND_FAILED;
-                SCHED_CHECK(0,chkSCHED_EVENT_SEND_FAILED);
-            }
-        }
-        SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
-    }
-    else
-    {
-        ret = SCHED_EVENT_SEND_FAILED;
-    }
-
-    return (ret);
-}
-
-
-/*******************************************************************************
-
-                                    内部函数
-
-*******************************************************************************/
-
-/**
- * 尝试接收指定任务已接收的事件块(实际上没有接收)
- *
- * @param task: 指定的任务控制块指针
- *
- * @return: SCHED_SUCCESS              表示接收成功
- *          SCHED_EVENT_RECEIVE_FAILED 表示接收失败
- */
-SchedStatus_t __framework_EventTryReceive(SchedTask_t *task)
-{
-SchedStatus_t ret;
-
-    if (SCHED_FALSE != internal_QueueIsEmpty(&task->queue))
-    {
-        ret = SCHED_EVENT_RECEIVE_FAILED;
-    }
-    else
-    {
-        ret = SCHED_SUCCESS;
-    }
-
-    return (ret);
-}
-
-/**
- * 接收指定任务已接收的事件块
- *
- * @param task: 指定的任务控制块指针
- *
- * @param evt: 保存接收事件内容的事件块指针
- *
- * @return: SCHED_SUCCESS              表示接收成功
- *          SCHED_EVENT_RECEIVE_FAILED 表示接收失败
- */
-SchedStatus_t __framework_EventReceive(SchedTask_t *task, SchedEvent_t *evt)
-{
-SchedStatus_t ret;
-
-    if (SCHED_FALSE != internal_QueueReceive(&task->queue, evt))
-    {
-        ret = SCHED_SUCCESS;
-    }
-    else
-    {
-        ret = SCHED_EVENT_RECEIVE_FAILED;
-    }
-
-    return (ret);
-}
-
-#endif  /* SCHED_TASK_EN && (SCHED_TASK_EVENT_METHOD >= 1) */
+/*******************************************************************************
+* 文 件 名: sched_event_queue.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-31
+* 文件说明: 实现事件驱动调度器的核心框架 - 事件管理(消息队列)
+*******************************************************************************/
+
+#include "sched_framework.h"
+
+#if SCHED_TASK_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+
+/*优先级通道号记录在优先级记录表中, 通道数量不能超过记录表容量*/
+SCHED_STATIC_ASSERT((SCHED_TASK_QUEUE_LANES >= 1) && (SCHED_TASK_QUEUE_LANES <= SCHED_PRIOTBL_LOWEST_PRIO+1),
+                    sched_task_queue_lanes_out_of_range);
+
+static SchedStatus_t prvEventQueueSend(SchedTask_t *task, uint8_t lane, SchedEvent_t const *evt, SchedBool_t front);
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+
+/**
+ * 向指定任务传递一个事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSend(SchedTask_t *task, SchedEvent_t const *evt)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+    SCHED_ASSERT(SCHED_CORE_RUNNING == framework_CoreStatus,errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        ret = prvEventQueueSend(task, SCHED_TASK_NORMAL_LANE, evt, SCHED_FALSE);
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (ret);
+}
+
+/**
+ * 向指定任务传递一个紧急事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSendFront(SchedTask_t *task, SchedEvent_t const *evt)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+    SCHED_ASSERT(SCHED_CORE_RUNNING == framework_CoreStatus,errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        ret = prvEventQueueSend(task, SCHED_TASK_NORMAL_LANE, evt, SCHED_TRUE);
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (ret);
+}
+
+/**
+ * 在中断函数中向指定任务传递一个事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSendFromISR(SchedTask_t *task, SchedEvent_t const *evt)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    if (SCHED_CORE_RUNNING == framework_CoreStatus)
+    {
+        SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+        SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+        cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
+        {
+            ret = prvEventQueueSend(task, SCHED_TASK_NORMAL_LANE, evt, SCHED_FALSE);
+        }
+        SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
+    }
+    else
+    {
+        ret = SCHED_EVENT_SEND_FAILED;
+    }
+
+    return (ret);
+}
+
+/**
+ * 在中断函数中向指定任务传递一个紧急事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSendFrontFromISR(SchedTask_t *task, SchedEvent_t const *evt)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    if (SCHED_CORE_RUNNING == framework_CoreStatus)
+    {
+        SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+        SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+        cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
+        {
+            ret = prvEventQueueSend(task, SCHED_TASK_NORMAL_LANE, evt, SCHED_TRUE);
+        }
+        SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
+    }
+    else
+    {
+        ret = SCHED_EVENT_SEND_FAILED;
+    }
+
+    return (ret);
+}
+
+#if SCHED_TASK_QUEUE_LANES > 1
+/**
+ * 向指定任务消息队列的指定通道传递一个事件,
+ * 高优先级通道的事件先于低优先级通道的事件处理, 同一通道内的事件保持先进先出
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param lane: 消息队列通道, 有效范围是0 - SCHED_TASK_QUEUE_LANES-1, 0为最高优先级通道
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSendLane(SchedTask_t *task, uint8_t lane, SchedEvent_t const *evt)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(lane < SCHED_TASK_QUEUE_LANES,errSCHED_PARAM_NOT_ALLOWED);
+    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+    SCHED_ASSERT(SCHED_CORE_RUNNING == framework_CoreStatus,errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        ret = prvEventQueueSend(task, lane, evt, SCHED_FALSE);
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (ret);
+}
+
+/**
+ * 在中断函数中向指定任务消息队列的指定通道传递一个事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param lane: 消息队列通道, 有效范围是0 - SCHED_TASK_QUEUE_LANES-1, 0为最高优先级通道
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSendLaneFromISR(SchedTask_t *task, uint8_t lane, SchedEvent_t const *evt)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    if (SCHED_CORE_RUNNING == framework_CoreStatus)
+    {
+        SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+        SCHED_ASSERT(lane < SCHED_TASK_QUEUE_LANES,errSCHED_PARAM_NOT_ALLOWED);
+        SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+        cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
+        {
+            ret = prvEventQueueSend(task, lane, evt, SCHED_FALSE);
+        }
+        SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
+    }
+    else
+    {
+        ret = SCHED_EVENT_SEND_FAILED;
+    }
+
+    return (ret);
+}
+#endif  /* SCHED_TASK_QUEUE_LANES > 1 */
+
+#if SCHED_TASK_DEFER_EN
+/**
+ * 将事件块保存到指定任务的延迟队列, 延迟的事件块在召回前不会被处理,
+ * 通常在状态函数中延迟当前暂时无法处理的事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待延迟的事件块指针, 通过复制事件块内容进行保存
+ *
+ * @return: SCHED_SUCCESS           表示延迟成功
+ *          SCHED_EVENT_SEND_FAILED 表示延迟队列已满
+ */
+SchedStatus_t framework_EventDefer(SchedTask_t *task, SchedEvent_t const *evt)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        if (SCHED_FALSE != internal_QueueSend(&task->deferQueue, evt))
+        {
+            ret = SCHED_SUCCESS;
+        }
+        else
+        {
+            ret = SCHED_EVENT_SEND_FAILED;
+            SCHED_CHECK(0,chkSCHED_EVENT_SEND_FAILED);
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (ret);
+}
+
+/**
+ * 将指定任务延迟队列中的事件块按原顺序召回到消息队列头部(最高优先级通道),
+ * 消息队列空位不足时只召回最早的部分事件块, 其余事件块继续保留在延迟队列
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @return: 召回的事件块数量
+ */
+EvtPos_t framework_EventRecall(SchedTask_t *task)
+{
+EvtPos_t n;
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        n = internal_QueueRecall(&task->queue[0], &task->deferQueue);
+        if (n > 0)
+        {
+        #if SCHED_TASK_QUEUE_LANES > 1
+            internal_PriotblRecordPrio(&task->laneTable, 0);
+        #endif
+            __framework_TaskRecordReadyTask(task);
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (n);
+}
+
+#if SCHED_QUEUE_POLICY_EN
+/**
+ * 获取指定任务延迟队列的丢弃计数
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @return: 延迟队列已满时被拒绝的延迟事件数量
+ */
+uint32_t framework_EventDeferGetDropCount(SchedTask_t *task)
+{
+uint32_t count;
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        count = internal_QueueGetDropCount(&task->deferQueue);
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (count);
+}
+#endif
+#endif  /* SCHED_TASK_DEFER_EN */
+
+/*******************************************************************************
+
+                                    内部函数
+
+*******************************************************************************/
+
+/**
+ * 尝试接收指定任务已接收的事件块(实际上没有接收)
+ *
+ * @param task: 指定的任务控制块指针
+ *
+ * @return: SCHED_SUCCESS              表示接收成功
+ *          SCHED_EVENT_RECEIVE_FAILED 表示接收失败
+ */
+SchedStatus_t __framework_EventTryReceive(SchedTask_t *task)
+{
+SchedStatus_t ret;
+
+#if SCHED_TASK_QUEUE_LANES > 1
+    if (SCHED_FALSE != internal_PriotblIsEmpty(&task->laneTable))
+#else
+    if (SCHED_FALSE != internal_QueueIsEmpty(&task->queue[0]))
+#endif
+    {
+        ret = SCHED_EVENT_RECEIVE_FAILED;
+    }
+    else
+    {
+        ret = SCHED_SUCCESS;
+    }
+
+    return (ret);
+}
+
+/**
+ * 接收指定任务已接收的事件块
+ *
+ * @param task: 指定的任务控制块指针
+ *
+ * @param evt: 保存接收事件内容的事件块指针
+ *
+ * @return: SCHED_SUCCESS              表示接收成功
+ *          SCHED_EVENT_RECEIVE_FAILED 表示接收失败
+ */
+SchedStatus_t __framework_EventReceive(SchedTask_t *task, SchedEvent_t *evt)
+{
+SchedStatus_t ret;
+#if SCHED_TASK_QUEUE_LANES > 1
+uint8_t lane;
+
+    /*从最高优先级的非空通道接收事件块*/
+    if (SCHED_FALSE != internal_PriotblIsEmpty(&task->laneTable))
+    {
+        ret = SCHED_EVENT_RECEIVE_FAILED;
+    }
+    else
+    {
+        lane = internal_PriotblGetHighestPrio(&task->laneTable);
+        internal_QueueReceive(&task->queue[lane], evt);
+        if (SCHED_FALSE != internal_QueueIsEmpty(&task->queue[lane]))
+        {
+            internal_PriotblResetPrio(&task->laneTable, lane);
+        }
+        ret = SCHED_SUCCESS;
+    }
+#else
+    if (SCHED_FALSE != internal_QueueReceive(&task->queue[0], evt))
+    {
+        ret = SCHED_SUCCESS;
+    }
+    else
+    {
+        ret = SCHED_EVENT_RECEIVE_FAILED;
+    }
+#endif
+
+    return (ret);
+}
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+/**
+ * 向任务消息队列的指定通道插入事件块, 插入成功则记录就绪任务
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param lane: 消息队列通道
+ *
+ * @param evt: 待插入的事件块指针
+ *
+ * @param front: 布尔值(SCHED_TRUE/SCHED_FALSE), 表示是否插入通道头部
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+static SchedStatus_t prvEventQueueSend(SchedTask_t *task, uint8_t lane, SchedEvent_t const *evt, SchedBool_t front)
+{
+SchedStatus_t ret;
+SchedBool_t sent;
+#if SCHED_EVENT_TIMESTAMP_EN
+SchedEvent_t event;
+
+    /*记录事件发送时间戳*/
+    sched_PortEventCopy(&event, evt);
+    event.stamp = SCHED_GetTimestamp();
+    evt = &event;
+#endif
+
+    if (front)
+    {
+        sent = internal_QueueSendFront(&task->queue[lane], evt);
+    }
+    else
+    {
+        sent = internal_QueueSend(&task->queue[lane], evt);
+    }
+
+    if (SCHED_FALSE != sent)
+    {
+    #if SCHED_TASK_QUEUE_LANES > 1
+        internal_PriotblRecordPrio(&task->laneTable, lane);
+    #endif
+        __framework_TaskRecordReadyTask(task);
+        ret = SCHED_SUCCESS;
+    }
+    else
+    {
+        ret = SCHED_EVENT_SEND_FAILED;
+        SCHED_CHECK(0,chkSCHED_EVENT_SEND_FAILED);
+    }
+    return (ret);
+}
+
+#endif  /* SCHED_TASK_EN && (SCHED_TASK_EVENT_METHOD >= 1) */
@@ -1,171 +1,267 @@
-/*******************************************************************************
-* 文 件 名: sched_event_table.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-08-01
-* 文件说明: 实现事件驱动调度器的核心框架 - 事件管理(记录表)
-*******************************************************************************/
-
-#include "sched_framework.h"
-
-#if SCHED_TASK_EN && (SCHED_TASK_EVENT_METHOD == 0)
-/*******************************************************************************
-
-                                    操作函数
-
-*******************************************************************************/
-
-/**
- * 向指定任务传递一个事件
- *
- * @param task: 目标任务控制块指针
- *
- * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t framework_EventSend(SchedTask_t *task, SchedEvent_t const *evt)
-{
-SchedCPU_t cpu_sr;
-
-    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
-    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
-    SCHED_ASSERT(SCHED_CORE_RUNNING == framework_CoreStatus,errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING);
-
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        __framework_TaskRecordReadyTask(task);
-        internal_PriotblRecordPrio(&task->sigtbl, (uint8_t)(evt->sig - SCHED_SIG_USER));
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-
-    return (SCHED_SUCCESS);
-}
-
-/**
- * 向指定任务传递一个紧急事件
- *
- * @param task: 目标任务控制块指针
- *
- * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t framework_EventSendFront(SchedTask_t *task, SchedEvent_t const *evt)
-{
-    return framework_EventSend(task, evt);
-}
-
-/**
- * 在中断函数中向指定任务传递一个事件
- *
- * @param task: 目标任务控制块指针
- *
- * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t framework_EventSendFromISR(SchedTask_t *task, SchedEvent_t const *evt)
-{
-SchedStatus_t ret;
-SchedCPU_t cpu_sr;
-
-    if (SCHED_CORE_RUNNING == framework_CoreStatus)
-    {
-        SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
-        SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
-
-        cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
-        {
-            __framework_TaskRecordReadyTask(task);
-            internal_PriotblRecordPrio(&task->sigtbl, (uint8_t)(evt->sig - SCHED_SIG_USER));
-        }
-        SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
-        ret = SCHED_SUCCESS;
-    }
-    else
-    {
-        ret = SCHED_EVENT_SEND_FAILED;
-    }
-
-    return (ret);
-}
-
-/**
- * 在中断函数中向指定任务传递一个紧急事件
- *
- * @param task: 目标任务控制块指针
- *
- * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t framework_EventSendFrontFromISR(SchedTask_t *task, SchedEvent_t const *evt)
-{
-    return framework_EventSendFromISR(task, evt);
-}
-
-/*******************************************************************************
-
-                                    内部函数
-
-*******************************************************************************/
-
-/**
- * 尝试接收指定任务已接收的事件块(实际上没有接收)
- *
- * @param task: 指定的任务控制块指针
- *
- * @return: SCHED_SUCCESS              表示接收成功
- *          SCHED_EVENT_RECEIVE_FAILED 表示接收失败
- */
-SchedStatus_t __framework_EventTryReceive(SchedTask_t *task)
-{
-SchedStatus_t ret;
-
-    if (SCHED_FALSE != internal_PriotblIsEmpty(&task->sigtbl))
-    {
-        ret = SCHED_EVENT_RECEIVE_FAILED;
-    }
-    else
-    {
-        ret = SCHED_SUCCESS;
-    }
-    return (ret);
-}
-
-/**
- * 接收指定任务已接收的事件块
- *
- * @param task: 指定的任务控制块指针
- *
- * @param evt: 保存接收事件内容的事件块指针
- *
- * @return: SCHED_SUCCESS              表示接收成功
- *          SCHED_EVENT_RECEIVE_FAILED 表示接收失败
- */
-SchedStatus_t __framework_EventReceive(SchedTask_t *task, SchedEvent_t *evt)
-{
-SchedStatus_t ret;
-uint8_t sig;
-
-    if (SCHED_FALSE != internal_PriotblIsEmpty(&task->sigtbl))
-    {
-        ret = SCHED_EVENT_RECEIVE_FAILED;
-    }
-    else
-    {
-        sig = internal_PriotblGetHighestPrio(&task->sigtbl);
-        internal_PriotblResetPrio(&task->sigtbl,sig);
-        evt->sig = (EvtSig_t)sig + SCHED_SIG_USER;
-        evt->msg = 0;
-        ret = SCHED_SUCCESS;
-    }
-    return (ret);
-}
-
-#endif  /* SCHED_TASK_EN && (SCHED_TASK_EVENT_METHOD == 0) */
+/*******************************************************************************
+* 文 件 名: sched_event_table.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-08-01
+* 文件说明: 实现事件驱动调度器的核心框架 - 事件管理(记录表)
+*******************************************************************************/
+
+#include "sched_framework.h"
+
+#if SCHED_TASK_EN && (SCHED_TASK_EVENT_METHOD == 0)
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+
+/**
+ * 在任务的记录表中记录一个事件, 调用前需进入临界区
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待记录的事件块指针
+ *
+ * @note: 使能SCHED_SIGTBL_EXT_EN时同时保存事件的消息, 同一信号在被接收前
+ *        多次发送时只保留最后一次的消息
+ */
+static void prvEventTableRecord(SchedTask_t *task, SchedEvent_t const *evt)
+{
+#if SCHED_SIGTBL_EXT_EN
+uint16_t sig = (uint16_t)(evt->sig - SCHED_SIG_USER);
+
+    internal_SigtblRecordSig(&task->sigtbl, sig);
+    if (sig < SCHED_SIGTBL_SIG_NUM)
+    {
+        task->sigmsg[sig] = evt->msg;
+    }
+#else
+    internal_PriotblRecordPrio(&task->sigtbl, (uint8_t)(evt->sig - SCHED_SIG_USER));
+#endif
+}
+
+/**
+ * 查找任务记录表中下一个待处理的信号(不清除信号)
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param sig: 保存结果的指针, 结果为信号相对SCHED_SIG_USER的偏移量
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示存在待处理的信号
+ *          SCHED_FALSE 表示没有待处理的信号(或者信号均被当前状态屏蔽)
+ */
+static SchedBool_t prvEventTablePeek(SchedTask_t const *task, uint16_t *sig)
+{
+SchedBool_t ret;
+#if SCHED_SIGMASK_METHOD && !SCHED_SIGTBL_EXT_EN
+uint8_t prio;
+#endif
+
+#if SCHED_SIGMASK_METHOD && SCHED_SIGTBL_EXT_EN
+    ret = internal_SigtblGetMaskedSig(&task->sigtbl, task->fsm.sigMask, sig);
+#elif SCHED_SIGMASK_METHOD
+    ret = internal_PriotblGetMaskedPrio(&task->sigtbl, task->fsm.sigMask, &prio);
+    *sig = prio;
+#elif SCHED_SIGTBL_EXT_EN
+    if (SCHED_FALSE != internal_SigtblIsEmpty(&task->sigtbl))
+    {
+        ret = SCHED_FALSE;
+    }
+    else
+    {
+        *sig = internal_SigtblGetHighestSig(&task->sigtbl);
+        ret = SCHED_TRUE;
+    }
+#else
+    if (SCHED_FALSE != internal_PriotblIsEmpty(&task->sigtbl))
+    {
+        ret = SCHED_FALSE;
+    }
+    else
+    {
+        *sig = internal_PriotblGetHighestPrio(&task->sigtbl);
+        ret = SCHED_TRUE;
+    }
+#endif
+    return (ret);
+}
+
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+
+/**
+ * 向指定任务传递一个事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSend(SchedTask_t *task, SchedEvent_t const *evt)
+{
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+    SCHED_ASSERT(SCHED_CORE_RUNNING == framework_CoreStatus,errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        prvEventTableRecord(task, evt);
+    #if SCHED_SIGMASK_METHOD
+        /*被当前状态屏蔽的信号只记录, 不使任务就绪*/
+        if (SCHED_FALSE != framework_FSM_IsAccepted(&task->fsm, evt->sig))
+    #endif
+        {
+            __framework_TaskRecordReadyTask(task);
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    return (SCHED_SUCCESS);
+}
+
+/**
+ * 向指定任务传递一个紧急事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSendFront(SchedTask_t *task, SchedEvent_t const *evt)
+{
+    return framework_EventSend(task, evt);
+}
+
+/**
+ * 在中断函数中向指定任务传递一个事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSendFromISR(SchedTask_t *task, SchedEvent_t const *evt)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    if (SCHED_CORE_RUNNING == framework_CoreStatus)
+    {
+        SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+        SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+
+        cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
+        {
+            prvEventTableRecord(task, evt);
+        #if SCHED_SIGMASK_METHOD
+            /*被当前状态屏蔽的信号只记录, 不使任务就绪*/
+            if (SCHED_FALSE != framework_FSM_IsAccepted(&task->fsm, evt->sig))
+        #endif
+            {
+                __framework_TaskRecordReadyTask(task);
+            }
+        }
+        SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
+        ret = SCHED_SUCCESS;
+    }
+    else
+    {
+        ret = SCHED_EVENT_SEND_FAILED;
+    }
+
+    return (ret);
+}
+
+/**
+ * 在中断函数中向指定任务传递一个紧急事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t framework_EventSendFrontFromISR(SchedTask_t *task, SchedEvent_t const *evt)
+{
+    return framework_EventSendFromISR(task, evt);
+}
+
+/*******************************************************************************
+
+                                    内部函数
+
+*******************************************************************************/
+
+/**
+ * 尝试接收指定任务已接收的事件块(实际上没有接收)
+ *
+ * @param task: 指定的任务控制块指针
+ *
+ * @return: SCHED_SUCCESS              表示接收成功
+ *          SCHED_EVENT_RECEIVE_FAILED 表示接收失败
+ */
+SchedStatus_t __framework_EventTryReceive(SchedTask_t *task)
+{
+SchedStatus_t ret;
+uint16_t sig;
+
+    if (SCHED_FALSE == prvEventTablePeek(task, &sig))
+    {
+        ret = SCHED_EVENT_RECEIVE_FAILED;
+    }
+    else
+    {
+        ret = SCHED_SUCCESS;
+    }
+    return (ret);
+}
+
+/**
+ * 接收指定任务已接收的事件块
+ *
+ * @param task: 指定的任务控制块指针
+ *
+ * @param evt: 保存接收事件内容的事件块指针
+ *
+ * @return: SCHED_SUCCESS              表示接收成功
+ *          SCHED_EVENT_RECEIVE_FAILED 表示接收失败
+ */
+SchedStatus_t __framework_EventReceive(SchedTask_t *task, SchedEvent_t *evt)
+{
+SchedStatus_t ret;
+uint16_t sig;
+
+    if (SCHED_FALSE == prvEventTablePeek(task, &sig))
+    {
+        ret = SCHED_EVENT_RECEIVE_FAILED;
+    }
+    else
+    {
+    #if SCHED_SIGTBL_EXT_EN
+        internal_SigtblResetSig(&task->sigtbl,sig);
+        evt->sig = (EvtSig_t)(sig + SCHED_SIG_USER);
+        evt->msg = task->sigmsg[sig];
+    #else
+        internal_PriotblResetPrio(&task->sigtbl,(uint8_t)sig);
+        evt->sig = (EvtSig_t)sig + SCHED_SIG_USER;
+        evt->msg = 0;
+    #endif
+        ret = SCHED_SUCCESS;
+    }
+    return (ret);
+}
+
+#endif  /* SCHED_TASK_EN && (SCHED_TASK_EVENT_METHOD == 0) */
@@ -1,92 +1,522 @@
-/*******************************************************************************
-* 文 件 名: sched_fsm.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-29
-* 文件说明: 实现事件驱动调度器的核心框架 - 有限状态机
-*******************************************************************************/
-
-#include "sched_framework.h"
-
-#if SCHED_TASK_EN
-/*******************************************************************************
-
-                                    全局变量
-
-*******************************************************************************/
-/*状态机内部事件*/
-const SchedEvent_t internal_event[4] =
-{
-    {SCHED_SIG_EMPTY,   0},
-    {SCHED_SIG_ENTRY,   0},
-    {SCHED_SIG_EXIT,    0},
-    {SCHED_SIG_CYCLE,   0},
-};
-
-/*******************************************************************************
-
-                                    操作函数
-
-*******************************************************************************/
-
-/**
- * 构造状态机
- *
- * @param fsm: 状态机指针
- *
- * @param initial: 状态机初始伪状态
- */
-void framework_FSM_Ctor(SchedFSM_t *fsm, SchedStateFunction_t initial)
-{
-    fsm->state = initial;
-}
-
-/**
- * 初始化状态机, 执行初始化状态转移
- *
- * @param fsm: 状态机指针
- */
-void framework_FSM_Init(SchedFSM_t *fsm)
-{
-SchedBase_t ret;
-
-    /*执行初始化状态转移*/
-    ret = (fsm->state)(fsm, &internal_event[SCHED_SIG_EMPTY]);
-    SCHED_ASSERT(SCHED_RET_TRAN == ret,errSCHED_FSM_INITIAL_NOT_TRAN);
-    /*执行新状态进入动作*/
-    ret = (fsm->state)(fsm, &internal_event[SCHED_SIG_ENTRY]);
-    SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_ENTRY_TRAN);
-    /*消除编译器警告*/
-    ((void) ret);
-}
-
-/**
- * 状态机处理事件
- *
- * @param fsm: 状态机指针
- *
- * @param e: 待处理事件块指针
- */
-void framework_FSM_Dispatch(SchedFSM_t *fsm, SchedEvent_t const *e)
-{
-SchedStateFunction_t    tmp;
-SchedBase_t             ret;
-
-    /*状态机处理事件*/
-    tmp = fsm->state;
-    ret = (fsm->state)(fsm, e);
-    /*发生状态转移*/
-    if (SCHED_RET_TRAN == ret)
-    {
-        /*执行原状态退出动作*/
-        ret = (tmp)(fsm, &internal_event[SCHED_SIG_EXIT]);
-        SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_EXIT_TRAN);
-        /*执行新状态进入动作*/
-        ret = (fsm->state)(fsm, &internal_event[SCHED_SIG_ENTRY]);
-        SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_ENTRY_TRAN);
-        /*消除编译器警告*/
-        ((void) ret);
-    }
-}
-
-#endif  /* SCHED_TASK_EN */
+/*******************************************************************************
+* 文 件 名: sched_fsm.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-29
+* 文件说明: 实现事件驱动调度器的核心框架 - 有限状态机
+*******************************************************************************/
+
+#include "sched_framework.h"
+
+#if SCHED_TASK_EN
+/*******************************************************************************
+
+                                    全局变量
+
+*******************************************************************************/
+/*状态机内部事件*/
+#if SCHED_EVENT_TIMESTAMP_EN
+    #define INTERNAL_EVENT(sig)     {(sig), 0, 0}
+#else
+    #define INTERNAL_EVENT(sig)     {(sig), 0}
+#endif
+const SchedEvent_t internal_event[SCHED_SIG_USER] =
+{
+    INTERNAL_EVENT(SCHED_SIG_EMPTY),
+    INTERNAL_EVENT(SCHED_SIG_ENTRY),
+    INTERNAL_EVENT(SCHED_SIG_EXIT),
+    INTERNAL_EVENT(SCHED_SIG_CYCLE),
+#if SCHED_FSM_HSM_EN
+    INTERNAL_EVENT(SCHED_SIG_INIT),
+#endif
+};
+
+#if SCHED_FSM_HSM_EN
+/*层次状态机转移路径缓存*/
+static SchedHsmPath_t hsmPathCache[SCHED_HSM_PATH_CACHE];
+
+static SchedStateFunction_t prvHsmGetSuper(SchedFSM_t *fsm, SchedStateFunction_t state);
+static SchedHsmPath_t const * prvHsmGetPath(SchedFSM_t *fsm, SchedStateFunction_t source, SchedStateFunction_t target);
+static void prvHsmTransition(SchedFSM_t *fsm, SchedStateFunction_t source, SchedStateFunction_t target);
+#endif
+
+#if SCHED_FSM_TABLE_EN
+static void prvTableEnter(SchedFSM_t *fsm, uint8_t target);
+static SchedBool_t prvTableDispatch(SchedFSM_t *fsm, SchedEvent_t const *e);
+#endif
+
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+
+/**
+ * 构造状态机
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param initial: 状态机初始伪状态
+ */
+void framework_FSM_Ctor(SchedFSM_t *fsm, SchedStateFunction_t initial)
+{
+    fsm->state = initial;
+#if SCHED_SIGMASK_METHOD
+    fsm->sigMask = SCHED_SIGMASK_ALL;
+#endif
+#if SCHED_FSM_TABLE_EN
+    fsm->table = NULL;
+    fsm->row   = NULL;
+#endif
+}
+
+#if SCHED_FSM_TABLE_EN
+/**
+ * 使用状态转移表构造状态机, 并检查表中的目标状态是否有效
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param table: 状态转移表指针, 状态机运行期间必须一直有效
+ */
+void framework_FSM_CtorTable(SchedFSM_t *fsm, SchedFsmTable_t const *table)
+{
+size_t i;
+
+    SCHED_ASSERT(NULL != table,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(table->nSigs >= SCHED_SIG_USER,errSCHED_PARAM_NOT_ALLOWED);
+    SCHED_ASSERT(table->initial < table->nStates,errSCHED_PARAM_NOT_ALLOWED);
+    for (i=0;i<(size_t)table->nStates*table->nSigs;i++)
+    {
+        SCHED_ASSERT((table->cells[i].target < table->nStates)
+                   ||(table->cells[i].target == SCHED_TABLE_NO_TRAN),errSCHED_PARAM_NOT_ALLOWED);
+    }
+    framework_FSM_Ctor(fsm, NULL);
+    fsm->table = table;
+}
+
+/**
+ * 获取状态转移表状态机的当前状态
+ *
+ * @param fsm: 状态机指针
+ *
+ * @return: 当前状态在状态转移表中的序号
+ */
+uint8_t framework_FSM_GetTableState(SchedFSM_t const *fsm)
+{
+    SCHED_ASSERT(NULL != fsm->table,errSCHED_PARAM_NOT_ALLOWED);
+    return ((uint8_t)((fsm->row - fsm->table->cells) / fsm->table->nSigs));
+}
+#endif
+
+/**
+ * 初始化状态机, 执行初始化状态转移
+ *
+ * @param fsm: 状态机指针
+ */
+void framework_FSM_Init(SchedFSM_t *fsm)
+{
+SchedBase_t ret;
+
+#if SCHED_FSM_TABLE_EN
+    /*状态转移表直接进入初始状态*/
+    if (NULL != fsm->table)
+    {
+        prvTableEnter(fsm, fsm->table->initial);
+    #if SCHED_FSM_TRACE_EN
+        __framework_TraceTransition(fsm, SCHED_TRACE_NO_STATE, fsm->table->initial, SCHED_SIG_EMPTY);
+    #endif
+    }
+    else
+#endif
+    {
+        /*执行初始化状态转移*/
+        ret = (fsm->state)(fsm, &internal_event[SCHED_SIG_EMPTY]);
+        SCHED_ASSERT(SCHED_RET_TRAN == ret,errSCHED_FSM_INITIAL_NOT_TRAN);
+#if SCHED_FSM_HSM_EN
+        /*从顶层逐级进入目标状态, 并执行目标状态的初始转移*/
+        prvHsmTransition(fsm, NULL, fsm->state);
+#else
+        /*执行新状态进入动作, 进入动作中可以重新设置信号屏蔽字*/
+#if SCHED_SIGMASK_METHOD
+        fsm->sigMask = SCHED_SIGMASK_ALL;
+#endif
+        ret = (fsm->state)(fsm, &internal_event[SCHED_SIG_ENTRY]);
+        SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_ENTRY_TRAN);
+#endif
+#if SCHED_FSM_TRACE_EN
+        /*记录初始转移, 开始计算初始状态的驻留时间*/
+        __framework_TraceTransition(fsm, SCHED_TRACE_NO_STATE, (SchedTraceState_t)fsm->state, SCHED_SIG_EMPTY);
+#endif
+    }
+    /*消除编译器警告*/
+    ((void) ret);
+}
+
+/**
+ * 状态机处理事件
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param e: 待处理事件块指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE), SCHED_TRUE表示发生了状态转移
+ */
+SchedBool_t framework_FSM_Dispatch(SchedFSM_t *fsm, SchedEvent_t const *e)
+{
+#if SCHED_FSM_HSM_EN
+SchedStateFunction_t    chain[SCHED_HSM_MAX_DEPTH];
+SchedStateFunction_t    state;
+SchedBase_t             ret;
+SchedBool_t             tran = SCHED_FALSE;
+uint8_t                 depth = 0;
+uint8_t                 i;
+#else
+SchedStateFunction_t    tmp;
+SchedBase_t             ret;
+SchedBool_t             tran = SCHED_FALSE;
+#endif
+
+#if SCHED_FSM_TABLE_EN
+    /*状态转移表按(状态, 信号)直接查表*/
+    if (NULL != fsm->table)
+    {
+        tran = prvTableDispatch(fsm, e);
+    }
+    else
+#endif
+    {
+#if SCHED_FSM_HSM_EN
+        /*从当前状态开始处理事件, 未处理的事件逐级冒泡到超状态*/
+        state = fsm->state;
+        for ( ;; )
+        {
+            SCHED_ASSERT(depth<SCHED_HSM_MAX_DEPTH,errSCHED_FSM_HSM_DEPTH_OVERFLOW);
+            chain[depth++] = state;
+            fsm->state = state;
+            ret = (state)(fsm, e);
+            if ((SCHED_RET_SUPER != ret) || (depth >= SCHED_HSM_MAX_DEPTH))
+            {
+                break;
+            }
+            state = fsm->state;
+        }
+        /*发生状态转移*/
+        if (SCHED_RET_TRAN == ret)
+        {
+            /*退出当前状态到转移源状态(不含)之间的各级状态*/
+            for (i=0;i+1<depth;i++)
+            {
+                ret = (chain[i])(fsm, &internal_event[SCHED_SIG_EXIT]);
+                SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_EXIT_TRAN);
+            }
+            prvHsmTransition(fsm, chain[depth-1], fsm->state);
+        #if SCHED_FSM_TRACE_EN
+            __framework_TraceTransition(fsm, (SchedTraceState_t)chain[0], (SchedTraceState_t)fsm->state, e->sig);
+        #endif
+            tran = SCHED_TRUE;
+        }
+        else
+        {
+            fsm->state = chain[0];
+        }
+#else
+        /*状态机处理事件*/
+        tmp = fsm->state;
+        ret = (fsm->state)(fsm, e);
+        /*发生状态转移*/
+        if (SCHED_RET_TRAN == ret)
+        {
+            /*执行原状态退出动作*/
+            ret = (tmp)(fsm, &internal_event[SCHED_SIG_EXIT]);
+            SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_EXIT_TRAN);
+            /*执行新状态进入动作, 进入动作中可以重新设置信号屏蔽字*/
+        #if SCHED_SIGMASK_METHOD
+            fsm->sigMask = SCHED_SIGMASK_ALL;
+        #endif
+            ret = (fsm->state)(fsm, &internal_event[SCHED_SIG_ENTRY]);
+            SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_ENTRY_TRAN);
+            /*消除编译器警告*/
+            ((void) ret);
+        #if SCHED_FSM_TRACE_EN
+            __framework_TraceTransition(fsm, (SchedTraceState_t)tmp, (SchedTraceState_t)fsm->state, e->sig);
+        #endif
+            tran = SCHED_TRUE;
+        }
+#endif
+    }
+    return (tran);
+}
+
+#if SCHED_SIGMASK_METHOD
+/**
+ * 判断状态机当前状态是否接收指定信号
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param sig: 待判断的信号, 内部信号和超出屏蔽字范围的用户信号总是被接收
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示接收信号
+ *          SCHED_FALSE 表示信号被屏蔽
+ */
+SchedBool_t framework_FSM_IsAccepted(SchedFSM_t const *fsm, EvtSig_t sig)
+{
+SchedBool_t ret = SCHED_TRUE;
+
+    if ((sig >= SCHED_SIG_USER) && (sig < SCHED_SIG_USER+32))
+    {
+        if (0 == (fsm->sigMask & SCHED_SIGMASK(sig)))
+        {
+            ret = SCHED_FALSE;
+        }
+    }
+    return (ret);
+}
+#endif
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+#if SCHED_FSM_HSM_EN
+
+/**
+ * 探测指定状态的超状态
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param state: 待探测的状态
+ *
+ * @return: 若状态返回SCHED_SUPER(), 返回其超状态,
+ *          若状态没有超状态(顶层状态), 返回NULL
+ */
+static SchedStateFunction_t prvHsmGetSuper(SchedFSM_t *fsm, SchedStateFunction_t state)
+{
+SchedStateFunction_t super = NULL;
+
+    fsm->state = state;
+    if (SCHED_RET_SUPER == (state)(fsm, &internal_event[SCHED_SIG_EMPTY]))
+    {
+        super = fsm->state;
+    }
+    return (super);
+}
+
+/**
+ * 获取从源状态到目标状态的转移路径, 优先从路径缓存中查找,
+ * 缓存未命中时探测两个状态的各级超状态, 通过最近公共祖先计算退出和进入路径
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param source: 转移源状态, 若为NULL表示从顶层进入目标状态
+ *
+ * @param target: 转移目标状态
+ *
+ * @return: 转移路径指针, 路径在下一次调用本函数前有效
+ */
+static SchedHsmPath_t const * prvHsmGetPath(SchedFSM_t *fsm, SchedStateFunction_t source, SchedStateFunction_t target)
+{
+SchedHsmPath_t         *pPath;
+SchedStateFunction_t    spath[SCHED_HSM_MAX_DEPTH];
+SchedStateFunction_t    state;
+uint8_t                 ns = 0;
+uint8_t                 i,j;
+
+    /*直接映射缓存, 源状态和目标状态相同即命中, 未命中时重新计算路径*/
+    pPath = &hsmPathCache[((size_t)source ^ ((size_t)target>>2)) % SCHED_HSM_PATH_CACHE];
+    if ((pPath->source != source) || (pPath->target != target))
+    {
+        /*探测目标状态的各级超状态, 进入路径保存为从目标状态向上的顺序*/
+        pPath->nEntry = 0;
+        for (state = target;NULL != state;state = prvHsmGetSuper(fsm, state))
+        {
+            SCHED_ASSERT(pPath->nEntry<SCHED_HSM_MAX_DEPTH,errSCHED_FSM_HSM_DEPTH_OVERFLOW);
+            if (pPath->nEntry >= SCHED_HSM_MAX_DEPTH)
+            {
+                break;
+            }
+            pPath->entry[pPath->nEntry++] = state;
+        }
+        /*探测源状态的各级超状态*/
+        for (state = source;NULL != state;state = prvHsmGetSuper(fsm, state))
+        {
+            SCHED_ASSERT(ns<SCHED_HSM_MAX_DEPTH,errSCHED_FSM_HSM_DEPTH_OVERFLOW);
+            if (ns >= SCHED_HSM_MAX_DEPTH)
+            {
+                break;
+            }
+            spath[ns++] = state;
+        }
+
+        if (source == target)
+        {
+            /*自转移, 退出并重新进入源状态*/
+            pPath->exit[0] = source;
+            pPath->nExit   = 1;
+            pPath->nEntry  = 1;
+        }
+        else
+        {
+            /*查找最近公共祖先, 未找到时公共祖先为顶层*/
+            pPath->nExit = ns;
+            for (i=0;i<ns;i++)
+            {
+                for (j=0;j<pPath->nEntry;j++)
+                {
+                    if (spath[i] == pPath->entry[j])
+                    {
+                        break;
+                    }
+                }
+                if (j < pPath->nEntry)
+                {
+                    pPath->nExit  = i;
+                    pPath->nEntry = j;
+                    break;
+                }
+            }
+            for (i=0;i<pPath->nExit;i++)
+            {
+                pPath->exit[i] = spath[i];
+            }
+        }
+        pPath->source = source;
+        pPath->target = target;
+    }
+    return (pPath);
+}
+
+/**
+ * 执行状态转移: 退出源状态到最近公共祖先之间的各级状态, 逐级进入目标状态,
+ * 然后执行目标状态的初始转移(SCHED_SIG_INIT), 直到进入叶子状态
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param source: 转移源状态, 若为NULL表示从顶层进入目标状态
+ *
+ * @param target: 转移目标状态
+ */
+static void prvHsmTransition(SchedFSM_t *fsm, SchedStateFunction_t source, SchedStateFunction_t target)
+{
+SchedHsmPath_t const   *pPath;
+SchedBase_t             ret;
+uint8_t                 i;
+
+    pPath = prvHsmGetPath(fsm, source, target);
+    /*执行退出动作*/
+    for (i=0;i<pPath->nExit;i++)
+    {
+        fsm->state = pPath->exit[i];
+        ret = (pPath->exit[i])(fsm, &internal_event[SCHED_SIG_EXIT]);
+        SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_EXIT_TRAN);
+    }
+    /*执行进入动作, 进入动作中可以重新设置信号屏蔽字*/
+#if SCHED_SIGMASK_METHOD
+    fsm->sigMask = SCHED_SIGMASK_ALL;
+#endif
+    for (i=pPath->nEntry;i>0;i--)
+    {
+        fsm->state = pPath->entry[i-1];
+        ret = (pPath->entry[i-1])(fsm, &internal_event[SCHED_SIG_ENTRY]);
+        SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_ENTRY_TRAN);
+    }
+    /*执行初始转移, 逐级进入子状态*/
+    for ( ;; )
+    {
+        fsm->state = target;
+        if (SCHED_RET_TRAN != (target)(fsm, &internal_event[SCHED_SIG_INIT]))
+        {
+            break;
+        }
+        source = target;
+        target = fsm->state;
+        pPath  = prvHsmGetPath(fsm, source, target);
+        /*初始转移的目标必须是当前状态的子状态*/
+        SCHED_ASSERT((0 == pPath->nExit) && (source != target),errSCHED_FSM_HSM_INIT_NOT_SUBSTATE);
+        for (i=pPath->nEntry;i>0;i--)
+        {
+            fsm->state = pPath->entry[i-1];
+            ret = (pPath->entry[i-1])(fsm, &internal_event[SCHED_SIG_ENTRY]);
+            SCHED_ASSERT(SCHED_RET_TRAN != ret,errSCHED_FSM_ENTRY_TRAN);
+        }
+    }
+    fsm->state = target;
+    /*消除编译器警告*/
+    ((void) ret);
+}
+#endif  /* SCHED_FSM_HSM_EN */
+
+#if SCHED_FSM_TABLE_EN
+/**
+ * 进入状态转移表的指定状态, 并执行其进入动作
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param target: 目标状态序号
+ */
+static void prvTableEnter(SchedFSM_t *fsm, uint8_t target)
+{
+SchedTableAction_t action;
+
+    fsm->row = &fsm->table->cells[(size_t)target*fsm->table->nSigs];
+    /*执行新状态进入动作, 进入动作中可以重新设置信号屏蔽字*/
+#if SCHED_SIGMASK_METHOD
+    fsm->sigMask = SCHED_SIGMASK_ALL;
+#endif
+    action = fsm->row[SCHED_SIG_ENTRY].action;
+    if (NULL != action)
+    {
+        action(fsm, &internal_event[SCHED_SIG_ENTRY]);
+    }
+}
+
+/**
+ * 状态转移表状态机处理事件, 以信号值为下标在当前状态行中查表,
+ * 不对信号值进行分支判断, 超出状态转移表信号数量的信号被忽略
+ *
+ * @param fsm: 状态机指针
+ *
+ * @param e: 待处理事件块指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE), SCHED_TRUE表示发生了状态转移
+ */
+static SchedBool_t prvTableDispatch(SchedFSM_t *fsm, SchedEvent_t const *e)
+{
+SchedFsmCell_t const   *pCell;
+SchedTableAction_t      action;
+SchedBool_t             tran = SCHED_FALSE;
+#if SCHED_FSM_TRACE_EN
+SchedTraceState_t       from;
+#endif
+
+    if (e->sig < fsm->table->nSigs)
+    {
+        pCell = &fsm->row[e->sig];
+        if (NULL != pCell->action)
+        {
+            (pCell->action)(fsm, e);
+        }
+        if (SCHED_TABLE_NO_TRAN != pCell->target)
+        {
+            /*执行原状态退出动作*/
+            action = fsm->row[SCHED_SIG_EXIT].action;
+            if (NULL != action)
+            {
+                action(fsm, &internal_event[SCHED_SIG_EXIT]);
+            }
+        #if SCHED_FSM_TRACE_EN
+            from = framework_FSM_GetTableState(fsm);
+        #endif
+            prvTableEnter(fsm, pCell->target);
+        #if SCHED_FSM_TRACE_EN
+            __framework_TraceTransition(fsm, from, pCell->target, e->sig);
+        #endif
+            tran = SCHED_TRUE;
+        }
+    }
+    return (tran);
+}
+#endif  /* SCHED_FSM_TABLE_EN */
+
+#endif  /* SCHED_TASK_EN */
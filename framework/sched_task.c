@@ -1,323 +1,906 @@
-/*******************************************************************************
-* 文 件 名: sched_task.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-29
-* 文件说明: 实现事件驱动调度器的核心框架 - 任务管理
-*******************************************************************************/
-
-#include "sched_framework.h"
-
-#if SCHED_TASK_EN
-/*******************************************************************************
-
-                                    全局变量
-
-*******************************************************************************/
-/*任务优先级管理*/
-static SchedTask_t * taskPrioGroup[SCHED_LOWEST_PRIORITY+1];
-static SchedPrioTable_t taskReadyTable;
-
-static SchedTask_t * prvGetHighestPriorityReadyTask(void);
-/*******************************************************************************
-
-                                    操作函数
-
-*******************************************************************************/
-/*任务管理环境初始化*/
-void framework_TaskEnvirInit(void)
-{
-uint8_t i;
-
-    for (i=0;i<=SCHED_LOWEST_PRIORITY;i++)
-    {
-        taskPrioGroup[i] = NULL;
-    }
-    internal_PriotblInit(&taskReadyTable);
-}
-
-/**
- * 创建一个新任务, 仅允许在调度器启动前创建新任务
- *
- * @param prio: 任务优先级
- *
- * @param queueLen: 消息队列长度, 在SCHED_TASK_EVENT_METHOD>0时有效
- *
- * @param initial: 状态机初始伪状态
- *
- * @return: 创建成功返回任务控制块指针, 创建失败返回NULL
- */
-SchedTask_t *framework_TaskCreate(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial)
-{
-SchedTask_t *pTask = NULL;
-
-    /*参数检验*/
-    SCHED_ASSERT(prio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
-    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_TASK_NOT_CREATED_BEFORE_CORE_RUNNING);
-    /*分配任务控制块*/
-    pTask = (SchedTask_t *)sched_PortMalloc(sizeof(SchedTask_t));
-    if (NULL != pTask)
-    {
-        /*构建FSM*/
-        framework_FSM_Ctor(&pTask->fsm, initial);
-        /*设置优先级*/
-        pTask->prio = prio;
-        SCHED_ASSERT(NULL == taskPrioGroup[prio],errSCHED_TASK_PRIO_IS_ALLOCATED);
-        taskPrioGroup[prio] = pTask;
-        /*初始化周期循环信号*/
-        #if SCHED_TASK_CYCLE_EN
-        {
-            pTask->cycleFlag   = 0;
-            pTask->cyclePeriod = 0;
-            pTask->cycleTick   = 0;
-            internal_ListInit(&pTask->cycleListItem, SCHED_LIST_CYCLE);
-        }
-        #endif
-        /*初始化消息队列或事件表*/
-        #if SCHED_TASK_EVENT_METHOD == 0
-        {
-            internal_PriotblInit(&pTask->sigtbl);
-        }
-        #else
-        {
-        SchedEvent_t *pEvents = NULL;
-
-            /*分配事件块数组*/
-            if (queueLen>0)
-            {
-                pEvents = (SchedEvent_t *)sched_PortMalloc((size_t)queueLen*sizeof(SchedEvent_t));
-            }
-            if (NULL == pEvents)
-            {
-                queueLen = 0;
-            }
-            /*初始化消息队列*/
-            internal_QueueInit(&pTask->queue,pEvents,queueLen);
-        }
-        #endif
-    }
-    return (pTask);
-}
-
-#if SCHED_TASK_CYCLE_EN
-/**
- * 设置任务周期循环信号产生的周期, 并复位周期循环信号节拍计数
- *
- * @param task: 任务控制块指针
- *
- * @param period: 周期循环信号产生的周期, 若为0则不产生周期循环信号
- *
- * @param immedTRIG: 设置是否立即触发信号(SCHED_TRUE/SCHED_FALSE)
- */
-void framework_TaskSetCyclePeriod(SchedTask_t *task, SchedTick_t period, SchedBool_t immedTRIG)
-{
-SchedCPU_t cpu_sr;
-
-    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
-    SCHED_ASSERT((SCHED_FALSE == immedTRIG)||(SCHED_TRUE == immedTRIG),errSCHED_PARAM_NOT_ALLOWED);
-
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        internal_ListRemove(&task->cycleListItem);
-        task->cycleFlag   = 0;
-        task->cycleTick   = 0;
-        task->cyclePeriod = period;
-        /*直接触发信号*/
-        if (immedTRIG)
-        {
-            task->cycleFlag = 1;
-            __framework_TaskRecordReadyTask(task);
-        }
-        /*添加延时对象*/
-        if (period > 0)
-        {
-            __framework_CoreTimeManagerAddDelay(&task->cycleListItem, period);
-        }
-        __framework_CoreTimeManagerUpdate();
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-}
-
-/**
- * 获取指定任务的周期循环信号节拍计数
- *
- * @param task: 指定任务的控制块指针
- *
- * @return: 周期循环信号节拍计数
- */
-SchedTick_t framework_TaskGetCycleTick(SchedTask_t *task)
-{
-SchedCPU_t cpu_sr;
-SchedTick_t tick;
-
-    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        tick = task->cycleTick;
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-    return (tick);
-}
-#endif  /* SCHED_TASK_CYCLE_EN */
-
-/*初始化所有任务*/
-void framework_TaskInitialiseAll(void)
-{
-SchedTask_t *pTask;
-uint8_t i;
-
-    for (i=0;i<=SCHED_LOWEST_PRIORITY;i++)
-    {
-        pTask = taskPrioGroup[i];
-        if (NULL != pTask)
-        {
-            framework_FSM_Init(&pTask->fsm);
-        }
-    }
-}
-
-/**
- * 实现一次任务调度
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE)
- *          SCHED_TRUE  表示完成一次任务调度
- *          SCHED_FALSE 表示没有就绪任务,进行了一次空操作
- */
-SchedBool_t framework_TaskExecute(void)
-{
-SchedBool_t     ret;
-SchedCPU_t      cpu_sr;
-SchedTask_t    *pTask;
-SchedEvent_t    event;
-
-    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
-    {
-        pTask = prvGetHighestPriorityReadyTask();
-        if (NULL != pTask)
-        {
-            /*获取未处理事件*/
-            #if SCHED_TASK_CYCLE_EN
-            if (pTask->cycleFlag)
-            {
-                pTask->cycleFlag = 0;
-                sched_PortEventCopy(&event, &internal_event[SCHED_SIG_CYCLE]);
-                event.msg = (EvtMsg_t)(pTask->cycleTick);
-                ret = SCHED_TRUE;
-            } else
-            #endif
-            if (SCHED_SUCCESS == __framework_EventReceive(pTask,&event))
-            {
-                ret = SCHED_TRUE;
-            }
-            else
-            {
-                ret = SCHED_FALSE;
-            }
-            /*判断是否剩余事件未处理*/
-            if (SCHED_EVENT_RECEIVE_FAILED == __framework_EventTryReceive(pTask))
-            {
-                __framework_TaskResetReadyTask(pTask);
-            }
-        }
-        else
-        {
-            ret = SCHED_FALSE;
-        }
-    }
-    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
-
-    /*状态机处理事件*/
-    if (ret)
-    {
-        framework_FSM_Dispatch(&pTask->fsm,&event);
-    }
-
-    return (ret);
-}
-
-/*******************************************************************************
-
-                                    内部函数
-
-*******************************************************************************/
-/**
- * 记录就绪任务
- *
- * @param task: 待记录的任务控制块指针
- */
-void __framework_TaskRecordReadyTask(SchedTask_t const *task)
-{
-uint8_t prio = task->prio;
-
-    SCHED_ASSERT(prio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
-    internal_PriotblRecordPrio(&taskReadyTable,prio);
-}
-
-/**
- * 清除就绪任务
- *
- * @param task: 待清除的任务控制块指针
- */
-void __framework_TaskResetReadyTask(SchedTask_t const *task)
-{
-uint8_t prio = task->prio;
-
-    SCHED_ASSERT(prio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
-    internal_PriotblResetPrio(&taskReadyTable,prio);
-}
-
-#if SCHED_TASK_CYCLE_EN
-/**
- * 时间管理器的对象延时到时回调函数
- *
- * @param pArrivalListItem: 结束延时的对象的链表项指针
- *
- * @return: 返回0表示时间管理器无进一步动作,
- *          返回非零值表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
- */
-SchedTick_t __framework_TaskTimeArrivalHandler(SchedList_t *pArrivalListItem)
-{
-SchedTask_t *pTask;
-
-    pTask = internal_ListEntry(pArrivalListItem,SchedTask_t,cycleListItem);
-    if (pTask->cyclePeriod > 0)
-    {
-        pTask->cycleFlag = 1;
-        pTask->cycleTick++;
-        __framework_TaskRecordReadyTask(pTask);
-    }
-    return (pTask->cyclePeriod);
-}
-#endif  /* SCHED_TASK_CYCLE_EN */
-
-/*******************************************************************************
-
-                                    私有函数
-
-*******************************************************************************/
-/**
- * 获取最高优先级的就绪任务
- *
- * @return: 若存在就绪任务,则返回最高优先级的就绪任务控制块指针,
- *          若当前无就绪任务,则返回NULL
- */
-static SchedTask_t * prvGetHighestPriorityReadyTask(void)
-{
-SchedTask_t *pTask;
-uint8_t highestPrio;
-
-    if (SCHED_FALSE == internal_PriotblIsEmpty(&taskReadyTable))
-    {
-        highestPrio = internal_PriotblGetHighestPrio(&taskReadyTable);
-        SCHED_ASSERT(highestPrio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
-        pTask = taskPrioGroup[highestPrio];
-        SCHED_ASSERT(NULL != pTask,errSCHED_TASK_NOT_EXISTED);
-    }
-    else
-    {
-        pTask = NULL;
-    }
-    return (pTask);
-}
-
-#endif  /* SCHED_TASK_EN */
+/*******************************************************************************
+* 文 件 名: sched_task.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-29
+* 文件说明: 实现事件驱动调度器的核心框架 - 任务管理
+*******************************************************************************/
+
+#include "sched_framework.h"
+
+#if SCHED_TASK_EN
+/*******************************************************************************
+
+                                    全局变量
+
+*******************************************************************************/
+/*任务优先级管理*/
+#if SCHED_TASK_TABLE_EN
+/*任务控制块按优先级连续存放, 冷数据单独存放, 未创建的任务优先级为SCHED_TASK_NO_PRIO*/
+#define SCHED_TASK_NO_PRIO          ( 0xFF )
+SCHED_STATIC_ASSERT(SCHED_LOWEST_PRIORITY < SCHED_TASK_NO_PRIO, sched_task_table_prio_overflow);
+static SchedTask_t taskTable[SCHED_LOWEST_PRIORITY+1];
+#if SCHED_TASK_COLD_EN
+static SchedTaskCold_t taskColdTable[SCHED_LOWEST_PRIORITY+1];
+#define prvTaskCold(task)           ( &taskColdTable[(task)->prio] )
+#endif
+#else
+static SchedTask_t * taskPrioGroup[SCHED_LOWEST_PRIORITY+1];
+#define prvTaskCold(task)           ( &(task)->cold )
+#endif
+static SchedPrioTable_t taskReadyTable;
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN
+/*共享事件节点池*/
+static SchedEventNode_t taskEventNodes[SCHED_EVENT_POOL_SIZE];
+static SchedEventPool_t taskEventPool;
+
+/*节点池的空闲计数(nFree/nMinFree)为EvtPos_t, 节点池大小不能超出其表示范围*/
+SCHED_STATIC_ASSERT((unsigned long)SCHED_EVENT_POOL_SIZE <= (unsigned long)(EvtPos_t)-1,
+                    sched_event_pool_size_over_evtpos);
+#endif
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_TASK_DEFER_EN && !SCHED_EVENT_POOL_EN
+/*使能SCHED_QUEUE_POW2_EN时, 延迟队列长度必须是2的幂*/
+SCHED_STATIC_ASSERT((0 == SCHED_QUEUE_POW2_EN) || (0 == (SCHED_TASK_DEFER_LEN & (SCHED_TASK_DEFER_LEN-1))),
+                    sched_task_defer_len_not_pow2);
+#endif
+
+static void prvTaskInit(SchedTask_t *task, uint8_t prio, EvtPos_t queueLen,
+                        SchedEvent_t *queueBuf, SchedStateFunction_t initial);
+static SchedTask_t * prvGetHighestPriorityReadyTask(void);
+#if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+static SchedBool_t prvTaskCheckLatency(SchedTask_t *task, SchedEvent_t const *evt);
+#endif
+#if (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_EVENT_POOL_EN && SCHED_QUEUE_POW2_EN && SCHED_DYNAMIC_ALLOC_EN
+static EvtPos_t prvQueueLengthToPow2(EvtPos_t len);
+#endif
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+/*任务管理环境初始化*/
+void framework_TaskEnvirInit(void)
+{
+uint8_t i;
+
+    for (i=0;i<=SCHED_LOWEST_PRIORITY;i++)
+    {
+    #if SCHED_TASK_TABLE_EN
+        taskTable[i].prio = SCHED_TASK_NO_PRIO;
+    #else
+        taskPrioGroup[i] = NULL;
+    #endif
+    }
+    internal_PriotblInit(&taskReadyTable);
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN
+    internal_EventPoolInit(&taskEventPool, taskEventNodes, SCHED_EVENT_POOL_SIZE);
+#endif
+}
+
+#if SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建一个新任务, 仅允许在调度器启动前创建新任务
+ *
+ * @param prio: 任务优先级
+ *
+ * @param queueLen: 消息队列长度, 在SCHED_TASK_EVENT_METHOD>0时有效,
+ *                  若使能共享事件节点池, 表示任务允许占用的最大节点数量
+ *
+ * @param initial: 状态机初始伪状态
+ *
+ * @return: 创建成功返回任务控制块指针, 创建失败返回NULL
+ */
+SchedTask_t *framework_TaskCreate(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial)
+{
+SchedTask_t *pTask = NULL;
+SchedEvent_t *pEvents = NULL;
+#if (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_EVENT_POOL_EN && SCHED_QUEUE_POW2_EN
+EvtPos_t pow2Len;
+#endif
+
+    /*参数检验*/
+    SCHED_ASSERT(prio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
+    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_TASK_NOT_CREATED_BEFORE_CORE_RUNNING);
+#if (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_EVENT_POOL_EN && SCHED_QUEUE_POW2_EN
+    /*消息队列长度向上取整为2的幂, 超出EvtPos_t的表示范围时创建失败*/
+    pow2Len = prvQueueLengthToPow2(queueLen);
+    SCHED_ASSERT((0 == queueLen) || (pow2Len > 0),errSCHED_PARAM_NOT_ALLOWED);
+    if ((0 == queueLen) || (pow2Len > 0))
+#endif
+    {
+    #if (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_EVENT_POOL_EN && SCHED_QUEUE_POW2_EN
+        queueLen = pow2Len;
+    #endif
+        /*分配任务控制块*/
+    #if SCHED_TASK_TABLE_EN
+        pTask = &taskTable[prio];
+    #else
+        pTask = (SchedTask_t *)sched_PortMalloc(sizeof(SchedTask_t));
+    #endif
+    }
+    if (NULL != pTask)
+    {
+    #if (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_EVENT_POOL_EN
+        /*分配各通道消息队列和延迟队列的事件块数组*/
+        if (SCHED_TASK_QUEUE_BUF_LEN(queueLen) > 0)
+        {
+            pEvents = (SchedEvent_t *)sched_PortMalloc((size_t)SCHED_TASK_QUEUE_BUF_LEN(queueLen)*sizeof(SchedEvent_t));
+        }
+    #endif
+        prvTaskInit(pTask, prio, queueLen, pEvents, initial);
+    }
+    return (pTask);
+}
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+/**
+ * 使用调用者提供的存储空间创建一个新任务, 仅允许在调度器启动前创建新任务
+ *
+ * @param prio: 任务优先级
+ *
+ * @param queueLen: 消息队列长度, 同framework_TaskCreate(),
+ *                  若使能SCHED_QUEUE_POW2_EN, 长度必须是2的幂
+ *
+ * @param initial: 状态机初始伪状态
+ *
+ * @param taskBuf: 任务控制块存储空间, 若使能SCHED_TASK_TABLE_EN, 必须为NULL
+ *
+ * @param queueBuf: 消息队列存储空间, 长度为SCHED_TASK_QUEUE_BUF_LEN(queueLen)个事件块,
+ *                  长度为0时可以为NULL
+ *
+ * @return: 任务控制块指针
+ */
+SchedTask_t *framework_TaskCreateStatic(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial,
+                                        SchedTask_t *taskBuf, SchedEvent_t *queueBuf)
+{
+    /*参数检验*/
+#if SCHED_TASK_TABLE_EN
+    SCHED_ASSERT(NULL == taskBuf,errSCHED_PARAM_NOT_ALLOWED);
+#else
+    SCHED_ASSERT(NULL != taskBuf,errSCHED_PARAM_PTR_IS_NULL);
+#endif
+    SCHED_ASSERT(prio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
+    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_TASK_NOT_CREATED_BEFORE_CORE_RUNNING);
+    SCHED_ASSERT((0 == SCHED_TASK_QUEUE_BUF_LEN(queueLen)) || (NULL != queueBuf),errSCHED_PARAM_PTR_IS_NULL);
+#if (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_EVENT_POOL_EN && SCHED_QUEUE_POW2_EN
+    SCHED_ASSERT(0 == (queueLen & (queueLen-1)),errSCHED_PARAM_NOT_ALLOWED);
+#endif
+#if SCHED_TASK_TABLE_EN
+    taskBuf = &taskTable[prio];
+#endif
+    prvTaskInit(taskBuf, prio, queueLen, queueBuf, initial);
+    return (taskBuf);
+}
+#endif
+
+#if SCHED_FSM_TABLE_EN
+#if SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建使用状态转移表的新任务
+ *
+ * @param prio: 任务优先级
+ *
+ * @param queueLen: 消息队列长度, 同framework_TaskCreate()
+ *
+ * @param table: 状态转移表指针
+ *
+ * @return: 创建成功返回任务控制块指针, 创建失败返回NULL
+ */
+SchedTask_t *framework_TaskCreateTable(uint8_t prio, EvtPos_t queueLen, SchedFsmTable_t const *table)
+{
+SchedTask_t *pTask;
+
+    SCHED_ASSERT(NULL != table,errSCHED_PARAM_PTR_IS_NULL);
+    pTask = framework_TaskCreate(prio, queueLen, NULL);
+    if (NULL != pTask)
+    {
+        framework_FSM_CtorTable(&pTask->fsm, table);
+    }
+    return (pTask);
+}
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+/**
+ * 使用调用者提供的存储空间创建使用状态转移表的新任务
+ *
+ * @param prio: 任务优先级
+ *
+ * @param queueLen: 消息队列长度, 同framework_TaskCreateStatic()
+ *
+ * @param table: 状态转移表指针
+ *
+ * @param taskBuf: 任务控制块存储空间
+ *
+ * @param queueBuf: 消息队列存储空间, 同framework_TaskCreateStatic()
+ *
+ * @return: 任务控制块指针
+ */
+SchedTask_t *framework_TaskCreateTableStatic(uint8_t prio, EvtPos_t queueLen, SchedFsmTable_t const *table,
+                                             SchedTask_t *taskBuf, SchedEvent_t *queueBuf)
+{
+SchedTask_t *pTask;
+
+    SCHED_ASSERT(NULL != table,errSCHED_PARAM_PTR_IS_NULL);
+    pTask = framework_TaskCreateStatic(prio, queueLen, NULL, taskBuf, queueBuf);
+    framework_FSM_CtorTable(&pTask->fsm, table);
+    return (pTask);
+}
+#endif
+#endif
+
+#if SCHED_TASK_CYCLE_EN
+/**
+ * 设置任务周期循环信号产生的周期, 并复位周期循环信号节拍计数
+ *
+ * @param task: 任务控制块指针
+ *
+ * @param period: 周期循环信号产生的周期, 若为0则不产生周期循环信号
+ *
+ * @param immedTRIG: 设置是否立即触发信号(SCHED_TRUE/SCHED_FALSE)
+ */
+void framework_TaskSetCyclePeriod(SchedTask_t *task, SchedTick_t period, SchedBool_t immedTRIG)
+{
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT((SCHED_FALSE == immedTRIG)||(SCHED_TRUE == immedTRIG),errSCHED_PARAM_NOT_ALLOWED);
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        internal_ListRemove(&prvTaskCold(task)->cycleListItem);
+        task->cycleFlag = 0;
+        prvTaskCold(task)->cycleTick   = 0;
+        prvTaskCold(task)->cyclePeriod = period;
+        /*直接触发信号*/
+        if (immedTRIG)
+        {
+            task->cycleFlag = 1;
+            __framework_TaskRecordReadyTask(task);
+        }
+        /*添加延时对象*/
+        if (period > 0)
+        {
+            __framework_CoreTimeManagerAddDelay(&prvTaskCold(task)->cycleListItem, period);
+        }
+        __framework_CoreTimeManagerUpdate();
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+}
+
+/**
+ * 获取指定任务的周期循环信号节拍计数
+ *
+ * @param task: 指定任务的控制块指针
+ *
+ * @return: 周期循环信号节拍计数
+ */
+SchedTick_t framework_TaskGetCycleTick(SchedTask_t *task)
+{
+SchedCPU_t cpu_sr;
+SchedTick_t tick;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        tick = prvTaskCold(task)->cycleTick;
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    return (tick);
+}
+#endif  /* SCHED_TASK_CYCLE_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_QUEUE_POLICY_EN
+/**
+ * 设置任务消息队列溢出策略, 仅允许在调度器启动前设置
+ *
+ * @param task: 任务控制块指针
+ *
+ * @param policy: 消息队列溢出策略
+ *                SCHED_QUEUE_REJECT      表示拒绝新事件
+ *                SCHED_QUEUE_DROP_OLDEST 表示丢弃队列中最早的事件
+ *                SCHED_QUEUE_COALESCE    表示替换队列中相同信号的事件
+ */
+void framework_TaskSetOverflowPolicy(SchedTask_t *task, uint8_t policy)
+{
+uint8_t i;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(policy<=SCHED_QUEUE_COALESCE,errSCHED_PARAM_NOT_ALLOWED);
+    SCHED_ASSERT(SCHED_CORE_STOP == framework_CoreStatus,errSCHED_TASK_NOT_CONFIGURED_BEFORE_CORE_RUNNING);
+    for (i=0;i<SCHED_TASK_QUEUE_LANES;i++)
+    {
+        internal_QueueSetPolicy(&task->queue[i], policy);
+    }
+}
+
+/**
+ * 获取任务消息队列丢弃计数
+ *
+ * @param task: 任务控制块指针
+ *
+ * @return: 消息队列溢出时被丢弃或者被替换的事件数量
+ */
+uint32_t framework_TaskGetDropCount(SchedTask_t *task)
+{
+SchedCPU_t cpu_sr;
+uint32_t count = 0;
+uint8_t i;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        for (i=0;i<SCHED_TASK_QUEUE_LANES;i++)
+        {
+            count += internal_QueueGetDropCount(&task->queue[i]);
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    return (count);
+}
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_QUEUE_POLICY_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN
+/**
+ * 获取共享事件节点池空闲节点最小量
+ *
+ * @return: 空闲节点最小量, 用于评估SCHED_EVENT_POOL_SIZE是否合适
+ */
+EvtPos_t framework_EventPoolGetMinFree(void)
+{
+SchedCPU_t cpu_sr;
+EvtPos_t nMinFree;
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        nMinFree = internal_EventPoolGetMinFree(&taskEventPool);
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    return (nMinFree);
+}
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_CONFLATE_EN
+/**
+ * 设置任务的指定信号是否合并,
+ * 合并信号在消息队列中最多只有一个等待的事件, 新事件直接更新等待事件的消息
+ *
+ * @param task: 任务控制块指针
+ *
+ * @param sig: 设置的信号, 有效范围是SCHED_SIG_USER - SCHED_SIG_USER+SCHED_CONFLATE_SIG_NUM-1
+ *
+ * @param enable: 布尔值(SCHED_TRUE/SCHED_FALSE), 表示是否合并信号
+ */
+void framework_TaskSetConflate(SchedTask_t *task, EvtSig_t sig, SchedBool_t enable)
+{
+SchedCPU_t cpu_sr;
+uint8_t i;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT((SCHED_FALSE == enable)||(SCHED_TRUE == enable),errSCHED_PARAM_NOT_ALLOWED);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        for (i=0;i<SCHED_TASK_QUEUE_LANES;i++)
+        {
+            internal_QueueSetConflate(&task->queue[i], sig, enable);
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+}
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_CONFLATE_EN */
+
+#if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+/**
+ * 设置任务事件有效期, 排队时间超过有效期的事件在处理前被丢弃
+ *
+ * @param task: 任务控制块指针
+ *
+ * @param ttl: 事件有效期, 单位与SCHED_GetTimestamp()一致, 若为0则事件永久有效
+ */
+void framework_TaskSetEventTTL(SchedTask_t *task, SchedTimestamp_t ttl)
+{
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        prvTaskCold(task)->eventTTL = ttl;
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+}
+
+/**
+ * 获取任务超过有效期被丢弃的事件数量
+ *
+ * @param task: 任务控制块指针
+ *
+ * @return: 超过有效期被丢弃的事件数量
+ */
+uint32_t framework_TaskGetExpiredCount(SchedTask_t *task)
+{
+SchedCPU_t cpu_sr;
+uint32_t count;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        count = prvTaskCold(task)->nExpired;
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    return (count);
+}
+
+#if SCHED_LATENCY_STAT_EN
+/**
+ * 获取任务排队延时直方图的指定分档计数
+ *
+ * @param task: 任务控制块指针
+ *
+ * @param bin: 直方图分档, 有效范围是0 - SCHED_LATENCY_BINS-1,
+ *             分档0统计延时为0的事件, 分档n统计延时为2^(n-1) - 2^n-1的事件,
+ *             最后一个分档同时统计所有更大的延时
+ *
+ * @return: 指定分档的事件数量
+ */
+uint32_t framework_TaskGetLatencyCount(SchedTask_t *task, uint8_t bin)
+{
+SchedCPU_t cpu_sr;
+uint32_t count = 0;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(bin < SCHED_LATENCY_BINS,errSCHED_PARAM_NOT_ALLOWED);
+    if (bin < SCHED_LATENCY_BINS)
+    {
+        cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+        {
+            count = prvTaskCold(task)->latHist[bin];
+        }
+        SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    }
+    return (count);
+}
+
+/**
+ * 获取任务最大排队延时
+ *
+ * @param task: 任务控制块指针
+ *
+ * @return: 最大排队延时, 单位与SCHED_GetTimestamp()一致
+ */
+SchedTimestamp_t framework_TaskGetLatencyMax(SchedTask_t *task)
+{
+SchedCPU_t cpu_sr;
+SchedTimestamp_t latMax;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        latMax = prvTaskCold(task)->latMax;
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    return (latMax);
+}
+#endif  /* SCHED_LATENCY_STAT_EN */
+#endif  /* SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1) */
+
+#if SCHED_SIGMASK_METHOD
+/**
+ * 设置任务当前状态接收的用户信号屏蔽字, 状态转移时屏蔽字恢复为全部接收,
+ * 通常在状态的进入动作中设置
+ *
+ * @param task: 任务控制块指针
+ *
+ * @param mask: 信号屏蔽字, 第n位为0表示屏蔽信号SCHED_SIG_USER+n
+ */
+void framework_TaskSetSigMask(SchedTask_t *task, SchedSigMask_t mask)
+{
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        task->fsm.sigMask = mask;
+    #if SCHED_TASK_EVENT_METHOD == 0
+        /*记录表中之前被屏蔽的信号可能重新被接收*/
+        if (SCHED_SUCCESS == __framework_EventTryReceive(task))
+        {
+            __framework_TaskRecordReadyTask(task);
+        }
+    #endif
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+}
+#endif  /* SCHED_SIGMASK_METHOD */
+
+/*初始化所有任务*/
+void framework_TaskInitialiseAll(void)
+{
+SchedTask_t *pTask;
+uint8_t i;
+
+    for (i=0;i<=SCHED_LOWEST_PRIORITY;i++)
+    {
+    #if SCHED_TASK_TABLE_EN
+        pTask = (i == taskTable[i].prio) ? &taskTable[i] : NULL;
+    #else
+        pTask = taskPrioGroup[i];
+    #endif
+        if (NULL != pTask)
+        {
+            framework_FSM_Init(&pTask->fsm);
+        }
+    }
+}
+
+/**
+ * 实现一次任务调度
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE)
+ *          SCHED_TRUE  表示完成一次任务调度
+ *          SCHED_FALSE 表示没有就绪任务,进行了一次空操作
+ */
+SchedBool_t framework_TaskExecute(void)
+{
+SchedBool_t     ret;
+SchedCPU_t      cpu_sr;
+SchedTask_t    *pTask;
+SchedEvent_t    event;
+SchedBool_t     accepted = SCHED_TRUE;
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        pTask = prvGetHighestPriorityReadyTask();
+        if (NULL != pTask)
+        {
+            /*获取未处理事件*/
+            #if SCHED_TASK_CYCLE_EN
+            if (pTask->cycleFlag)
+            {
+                pTask->cycleFlag = 0;
+                sched_PortEventCopy(&event, &internal_event[SCHED_SIG_CYCLE]);
+                event.msg = (EvtMsg_t)(prvTaskCold(pTask)->cycleTick);
+                ret = SCHED_TRUE;
+            } else
+            #endif
+            if (SCHED_SUCCESS == __framework_EventReceive(pTask,&event))
+            {
+                ret = SCHED_TRUE;
+            #if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+                /*统计排队延时, 超过有效期的事件直接丢弃*/
+                accepted = prvTaskCheckLatency(pTask, &event);
+            #endif
+            }
+            else
+            {
+                ret = SCHED_FALSE;
+            }
+            #if SCHED_SIGMASK_METHOD && (SCHED_TASK_EVENT_METHOD >= 1)
+            /*当前状态屏蔽的事件不交给状态机处理, 直接丢弃或者保存到延迟队列*/
+            if (ret && accepted && (SCHED_FALSE == framework_FSM_IsAccepted(&pTask->fsm, event.sig)))
+            {
+                accepted = SCHED_FALSE;
+            #if SCHED_SIGMASK_METHOD == 2
+                if (SCHED_FALSE == internal_QueueSend(&pTask->deferQueue, &event))
+                {
+                    SCHED_CHECK(0,chkSCHED_EVENT_SEND_FAILED);
+                }
+            #endif
+            }
+            #endif
+            /*判断是否剩余事件未处理*/
+            if (SCHED_EVENT_RECEIVE_FAILED == __framework_EventTryReceive(pTask))
+            {
+                __framework_TaskResetReadyTask(pTask);
+            }
+        }
+        else
+        {
+            ret = SCHED_FALSE;
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    /*状态机处理事件*/
+#if SCHED_SIGMASK_METHOD
+    if (ret && accepted)
+    {
+        /*状态转移后信号屏蔽字改变, 重新处理之前被屏蔽的事件*/
+        if (SCHED_FALSE != framework_FSM_Dispatch(&pTask->fsm,&event))
+        {
+        #if SCHED_TASK_EVENT_METHOD == 0
+            framework_TaskSetSigMask(pTask, pTask->fsm.sigMask);
+        #elif SCHED_SIGMASK_METHOD == 2
+            (void)framework_EventRecall(pTask);
+        #endif
+        }
+    }
+#else
+    if (ret && accepted)
+    {
+        (void)framework_FSM_Dispatch(&pTask->fsm,&event);
+    }
+#endif
+
+    return (ret);
+}
+
+/*******************************************************************************
+
+                                    内部函数
+
+*******************************************************************************/
+/**
+ * 记录就绪任务
+ *
+ * @param task: 待记录的任务控制块指针
+ */
+void __framework_TaskRecordReadyTask(SchedTask_t const *task)
+{
+uint8_t prio = task->prio;
+
+    SCHED_ASSERT(prio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
+    internal_PriotblRecordPrio(&taskReadyTable,prio);
+}
+
+/**
+ * 清除就绪任务
+ *
+ * @param task: 待清除的任务控制块指针
+ */
+void __framework_TaskResetReadyTask(SchedTask_t const *task)
+{
+uint8_t prio = task->prio;
+
+    SCHED_ASSERT(prio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
+    internal_PriotblResetPrio(&taskReadyTable,prio);
+}
+
+#if SCHED_TASK_CYCLE_EN
+/**
+ * 时间管理器的对象延时到时回调函数
+ *
+ * @param pArrivalListItem: 结束延时的对象的链表项指针
+ *
+ * @return: 返回0表示时间管理器无进一步动作,
+ *          返回非零值表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
+ */
+SchedTick_t __framework_TaskTimeArrivalHandler(SchedList_t *pArrivalListItem)
+{
+SchedTask_t *pTask;
+SchedTaskCold_t *pCold;
+
+    pCold = internal_ListEntry(pArrivalListItem,SchedTaskCold_t,cycleListItem);
+#if SCHED_TASK_TABLE_EN
+    pTask = &taskTable[pCold - taskColdTable];
+#else
+    pTask = internal_ListEntry(pCold,SchedTask_t,cold);
+#endif
+    if (pCold->cyclePeriod > 0)
+    {
+        pTask->cycleFlag = 1;
+        pCold->cycleTick++;
+        __framework_TaskRecordReadyTask(pTask);
+    }
+    return (pCold->cyclePeriod);
+}
+#endif  /* SCHED_TASK_CYCLE_EN */
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+/**
+ * 初始化任务控制块并登记任务优先级
+ *
+ * @param task: 任务控制块指针
+ *
+ * @param prio: 任务优先级
+ *
+ * @param queueLen: 消息队列长度
+ *
+ * @param queueBuf: 消息队列事件块数组, 长度为SCHED_TASK_QUEUE_BUF_LEN(queueLen),
+ *                  为NULL时消息队列长度为0
+ *
+ * @param initial: 状态机初始伪状态
+ */
+static void prvTaskInit(SchedTask_t *task, uint8_t prio, EvtPos_t queueLen,
+                        SchedEvent_t *queueBuf, SchedStateFunction_t initial)
+{
+    /*登记任务优先级*/
+#if SCHED_TASK_TABLE_EN
+    SCHED_ASSERT(SCHED_TASK_NO_PRIO == task->prio,errSCHED_TASK_PRIO_IS_ALLOCATED);
+#else
+    SCHED_ASSERT(NULL == taskPrioGroup[prio],errSCHED_TASK_PRIO_IS_ALLOCATED);
+    taskPrioGroup[prio] = task;
+#endif
+    /*构建FSM*/
+    framework_FSM_Ctor(&task->fsm, initial);
+    /*设置优先级*/
+    task->prio = prio;
+    /*初始化事件有效期和排队延时统计*/
+    #if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+    {
+        prvTaskCold(task)->eventTTL = 0;
+        prvTaskCold(task)->nExpired = 0;
+    #if SCHED_LATENCY_STAT_EN
+    {
+    uint8_t i;
+
+        for (i=0;i<SCHED_LATENCY_BINS;i++)
+        {
+            prvTaskCold(task)->latHist[i] = 0;
+        }
+        prvTaskCold(task)->latMax = 0;
+    }
+    #endif
+    }
+    #endif
+    /*初始化周期循环信号*/
+    #if SCHED_TASK_CYCLE_EN
+    {
+        task->cycleFlag = 0;
+        prvTaskCold(task)->cyclePeriod = 0;
+        prvTaskCold(task)->cycleTick   = 0;
+        internal_ListInit(&prvTaskCold(task)->cycleListItem, SCHED_LIST_CYCLE);
+    }
+    #endif
+    /*初始化消息队列或事件表*/
+    #if (SCHED_TASK_EVENT_METHOD == 0) && SCHED_SIGTBL_EXT_EN
+    {
+        (void)queueLen;
+        (void)queueBuf;
+        internal_SigtblInit(&task->sigtbl);
+    }
+    #elif SCHED_TASK_EVENT_METHOD == 0
+    {
+        (void)queueLen;
+        (void)queueBuf;
+        internal_PriotblInit(&task->sigtbl);
+    }
+    #elif SCHED_EVENT_POOL_EN
+    {
+    uint8_t i;
+
+        /*消息队列节点从共享事件节点池中分配, 每个通道的容量上限均为queueLen*/
+        SCHED_ASSERT(NULL == queueBuf,errSCHED_PARAM_NOT_ALLOWED);
+        for (i=0;i<SCHED_TASK_QUEUE_LANES;i++)
+        {
+            internal_QueueInit(&task->queue[i],&taskEventPool,queueLen);
+        }
+    }
+    #else
+    {
+    uint8_t i;
+
+        /*每个通道的长度均为queueLen, 延迟队列存储在各通道之后*/
+        if (NULL == queueBuf)
+        {
+            queueLen = 0;
+        }
+        for (i=0;i<SCHED_TASK_QUEUE_LANES;i++)
+        {
+            internal_QueueInit(&task->queue[i],(queueLen > 0) ? &queueBuf[(size_t)i*queueLen] : NULL,queueLen);
+        }
+    }
+    #endif
+    #if (SCHED_TASK_EVENT_METHOD >= 1) && (SCHED_TASK_QUEUE_LANES > 1)
+    {
+        internal_PriotblInit(&task->laneTable);
+    }
+    #endif
+    /*初始化延迟队列*/
+    #if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_TASK_DEFER_EN
+    {
+    #if SCHED_EVENT_POOL_EN
+        internal_QueueInit(&task->deferQueue,&taskEventPool,SCHED_TASK_DEFER_LEN);
+    #else
+        internal_QueueInit(&task->deferQueue,(NULL != queueBuf) ? &queueBuf[(size_t)queueLen*SCHED_TASK_QUEUE_LANES] : NULL,
+                           (NULL != queueBuf) ? SCHED_TASK_DEFER_LEN : 0);
+    #endif
+    }
+    #endif
+}
+
+/**
+ * 获取最高优先级的就绪任务
+ *
+ * @return: 若存在就绪任务,则返回最高优先级的就绪任务控制块指针,
+ *          若当前无就绪任务,则返回NULL
+ */
+static SchedTask_t * prvGetHighestPriorityReadyTask(void)
+{
+SchedTask_t *pTask;
+uint8_t highestPrio;
+
+    if (SCHED_FALSE == internal_PriotblIsEmpty(&taskReadyTable))
+    {
+        highestPrio = internal_PriotblGetHighestPrio(&taskReadyTable);
+        SCHED_ASSERT(highestPrio<=SCHED_LOWEST_PRIORITY,errSCHED_TASK_PRIO_OVER_LOWEST);
+    #if SCHED_TASK_TABLE_EN
+        pTask = &taskTable[highestPrio];
+        SCHED_ASSERT(highestPrio == pTask->prio,errSCHED_TASK_NOT_EXISTED);
+    #else
+        pTask = taskPrioGroup[highestPrio];
+        SCHED_ASSERT(NULL != pTask,errSCHED_TASK_NOT_EXISTED);
+    #endif
+    }
+    else
+    {
+        pTask = NULL;
+    }
+    return (pTask);
+}
+
+#if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+/**
+ * 统计事件的排队延时并检查事件是否超过有效期, 调用前需进入临界区
+ *
+ * @param task: 接收事件的任务控制块指针
+ *
+ * @param evt: 从消息队列接收的事件块指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示事件有效, 需要交给状态机处理
+ *          SCHED_FALSE 表示事件超过有效期, 已被丢弃
+ */
+static SchedBool_t prvTaskCheckLatency(SchedTask_t *task, SchedEvent_t const *evt)
+{
+SchedBool_t ret = SCHED_TRUE;
+SchedTaskCold_t *pCold = prvTaskCold(task);
+SchedTimestamp_t latency;
+#if SCHED_LATENCY_STAT_EN
+uint8_t bin;
+#endif
+
+    /*时间戳可能窄于int, 差值需转换回时间戳类型才能正确处理回绕*/
+    latency = (SchedTimestamp_t)(SCHED_GetTimestamp() - evt->stamp);
+#if SCHED_LATENCY_STAT_EN
+    /*按照延时的二进制位数分档*/
+    for (bin=0;(bin<SCHED_LATENCY_BINS-1)&&(0 != (latency>>bin));bin++)
+    {
+    }
+    pCold->latHist[bin]++;
+    if (latency > pCold->latMax)
+    {
+        pCold->latMax = latency;
+    }
+#endif
+    if ((0 != pCold->eventTTL) && (latency > pCold->eventTTL))
+    {
+        pCold->nExpired++;
+        ret = SCHED_FALSE;
+    }
+    return (ret);
+}
+#endif
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_EVENT_POOL_EN && SCHED_QUEUE_POW2_EN && SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 将消息队列长度向上取整为2的幂, 使得队列可以使用掩码计算环形偏移量
+ *
+ * @param len: 消息队列长度
+ *
+ * @return: 不小于len的最小的2的幂, 若len为0或者结果超出EvtPos_t的表示范围, 返回0
+ */
+static EvtPos_t prvQueueLengthToPow2(EvtPos_t len)
+{
+EvtPos_t pow2 = 1;
+
+    if (0 == len)
+    {
+        pow2 = 0;
+    }
+    else
+    {
+        while ((0 != pow2) && (pow2 < len))
+        {
+            pow2 = (EvtPos_t)(pow2 << 1);
+        }
+    }
+    return (pow2);
+}
+#endif
+
+#endif  /* SCHED_TASK_EN */
@@ -0,0 +1,295 @@
+/*******************************************************************************
+* 文 件 名: sched_timer.c
+* 创 建 者: agent
+* 版    本: V1.0
+* 创建日期: 2026-10-19
+* 文件说明: 实现事件驱动调度器的核心框架 - 延时事件管理
+*******************************************************************************/
+
+#include "sched_framework.h"
+
+#if SCHED_TASK_EN && SCHED_TIMER_EVENT_EN
+/*******************************************************************************
+
+                                    全局变量
+
+*******************************************************************************/
+/*定时节点池*/
+static SchedTimer_t timerNodes[SCHED_TIMER_NODE_NUM];
+static SchedList_t timerFreeList;
+static uint16_t timerNodeFree;
+static uint16_t timerNodeMinFree;
+
+static SchedTimer_t * prvTimerAlloc(void);
+static void prvTimerFree(SchedTimer_t *timer);
+static SchedStatus_t prvTimerSendDelayed(SchedTask_t *task, SchedEvent_t const *evt, SchedTick_t delay);
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+/*延时事件管理环境初始化*/
+void framework_TimerEnvirInit(void)
+{
+uint16_t i;
+
+    internal_ListInit(&timerFreeList, SCHED_LIST_HEAD);
+    for (i=0;i<SCHED_TIMER_NODE_NUM;i++)
+    {
+        internal_ListInit(&timerNodes[i].timerListItem, SCHED_LIST_TIMER);
+        internal_ListInsertEnd(&timerFreeList, &timerNodes[i].timerListItem);
+    }
+    timerNodeFree    = SCHED_TIMER_NODE_NUM;
+    timerNodeMinFree = SCHED_TIMER_NODE_NUM;
+}
+
+/**
+ * 延时向指定任务传递一个事件, 延时期间占用一个定时节点, 到时发送事件后自动释放
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @param delay: 延时节拍数, 若为0则立即发送事件
+ *
+ * @return: SCHED_SUCCESS           表示发送成功(或者已开始延时)
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败(或者定时节点已用完)
+ */
+SchedStatus_t framework_EventSendDelayed(SchedTask_t *task, SchedEvent_t const *evt, SchedTick_t delay)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+    SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+    SCHED_ASSERT(SCHED_CORE_RUNNING == framework_CoreStatus,errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING);
+
+    if (0 == delay)
+    {
+        ret = framework_EventSend(task, evt);
+    }
+    else
+    {
+        cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+        {
+            ret = prvTimerSendDelayed(task, evt, delay);
+        }
+        SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    }
+
+    return (ret);
+}
+
+/**
+ * 在中断函数中延时向指定任务传递一个事件
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针, 通过复制事件块内容进行传递
+ *
+ * @param delay: 延时节拍数, 若为0则立即发送事件
+ *
+ * @return: SCHED_SUCCESS           表示发送成功(或者已开始延时)
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败(或者定时节点已用完)
+ */
+SchedStatus_t framework_EventSendDelayedFromISR(SchedTask_t *task, SchedEvent_t const *evt, SchedTick_t delay)
+{
+SchedStatus_t ret;
+SchedCPU_t cpu_sr;
+
+    if (0 == delay)
+    {
+        ret = framework_EventSendFromISR(task, evt);
+    }
+    else if (SCHED_CORE_RUNNING == framework_CoreStatus)
+    {
+        SCHED_ASSERT(NULL != task,errSCHED_PARAM_PTR_IS_NULL);
+        SCHED_ASSERT(evt->sig >= SCHED_SIG_USER,errSCHED_EVENT_SEND_NOT_USER_SIGNAL);
+
+        cpu_sr = SCHED_EnterCriticalFromISR();  /*进入临界区*/
+        {
+            ret = prvTimerSendDelayed(task, evt, delay);
+        }
+        SCHED_ExitCriticalFromISR(cpu_sr);      /*退出临界区*/
+    }
+    else
+    {
+        ret = SCHED_EVENT_SEND_FAILED;
+    }
+
+    return (ret);
+}
+
+/**
+ * 获取定时节点池空闲节点最小量
+ *
+ * @return: 空闲节点最小量, 用于评估SCHED_TIMER_NODE_NUM是否合适
+ */
+uint16_t framework_TimerGetMinFree(void)
+{
+uint16_t nMinFree;
+SchedCPU_t cpu_sr;
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        nMinFree = timerNodeMinFree;
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    return (nMinFree);
+}
+
+/*******************************************************************************
+
+                                    内部函数
+
+*******************************************************************************/
+
+/**
+ * 时间管理器的对象延时到时回调函数
+ *
+ * @param pArrivalListItem: 结束延时的对象的链表项指针
+ *
+ * @return: 返回0表示时间管理器无进一步动作,
+ *          返回非零值表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
+ */
+SchedTick_t __framework_TimerTimeArrivalHandler(SchedList_t *pArrivalListItem)
+{
+SchedTimer_t *pTimer;
+
+    pTimer = internal_ListEntry(pArrivalListItem,SchedTimer_t,timerListItem);
+#if SCHED_DAEMON_EN && SCHED_DAEMON_QUEUE_EN
+    if (NULL == pTimer->task)
+    {
+        if (SCHED_SUCCESS != framework_DaemonCallFromISR(pTimer->daemon, &pTimer->event, 0))
+        {
+            /*调用队列已满(或者守护任务不允许调用), 到时的延时调用丢失*/
+            SCHED_CHECK(0,chkSCHED_DAEMON_CALL_FAILED);
+        }
+    }
+    else
+    {
+        framework_EventSendFromISR(pTimer->task, &pTimer->event);
+    }
+#else
+    framework_EventSendFromISR(pTimer->task, &pTimer->event);
+#endif
+    prvTimerFree(pTimer);
+    return (0);
+}
+
+#if SCHED_DAEMON_EN && SCHED_DAEMON_QUEUE_EN
+/**
+ * 分配定时节点延时调用守护任务, 到时将事件加入守护任务调用队列,
+ * 调用前需进入临界区
+ *
+ * @param daemon: 目标守护任务控制块指针
+ *
+ * @param evt: 守护任务待执行的事件
+ *
+ * @param delay: 延时节拍数, 必须大于0
+ *
+ * @return: SCHED_SUCCESS            表示已开始延时
+ *          SCHED_DAEMON_CALL_FAILED 表示定时节点已用完
+ */
+SchedStatus_t __framework_TimerDaemonCall(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay)
+{
+SchedStatus_t ret;
+SchedTimer_t *pTimer;
+
+    pTimer = prvTimerAlloc();
+    if (NULL != pTimer)
+    {
+        pTimer->task   = NULL;
+        pTimer->daemon = daemon;
+        sched_PortEventCopy(&pTimer->event, evt);
+        __framework_CoreTimeManagerAddDelay(&pTimer->timerListItem, delay);
+        ret = SCHED_SUCCESS;
+    }
+    else
+    {
+        ret = SCHED_DAEMON_CALL_FAILED;
+        SCHED_CHECK(0,chkSCHED_TIMER_NODE_EXHAUSTED);
+    }
+    return (ret);
+}
+#endif
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+
+/**
+ * 从定时节点池中分配一个节点, 调用前需进入临界区
+ *
+ * @return: 若分配成功, 返回定时节点指针
+ *          若节点池已空, 返回NULL
+ */
+static SchedTimer_t * prvTimerAlloc(void)
+{
+SchedTimer_t *pTimer = NULL;
+SchedList_t *pListItem;
+
+    if (SCHED_FALSE == internal_ListIsEmpty(&timerFreeList))
+    {
+        pListItem = internal_ListNext(&timerFreeList);
+        internal_ListRemove(pListItem);
+        pTimer = internal_ListEntry(pListItem,SchedTimer_t,timerListItem);
+        timerNodeFree--;
+        if (timerNodeFree < timerNodeMinFree)
+        {
+            timerNodeMinFree = timerNodeFree;
+        }
+    }
+    return (pTimer);
+}
+
+/**
+ * 向定时节点池归还一个节点, 调用前需进入临界区
+ *
+ * @param timer: 待归还的定时节点指针, 节点必须已从延时链表中移除
+ */
+static void prvTimerFree(SchedTimer_t *timer)
+{
+    internal_ListInsertEnd(&timerFreeList, &timer->timerListItem);
+    timerNodeFree++;
+}
+
+/**
+ * 分配定时节点并添加到时间管理器, 调用前需进入临界区
+ *
+ * @param task: 目标任务控制块指针
+ *
+ * @param evt: 待传递的事件块指针
+ *
+ * @param delay: 延时节拍数, 必须大于0
+ *
+ * @return: SCHED_SUCCESS           表示已开始延时
+ *          SCHED_EVENT_SEND_FAILED 表示定时节点已用完
+ */
+static SchedStatus_t prvTimerSendDelayed(SchedTask_t *task, SchedEvent_t const *evt, SchedTick_t delay)
+{
+SchedStatus_t ret;
+SchedTimer_t *pTimer;
+
+    pTimer = prvTimerAlloc();
+    if (NULL != pTimer)
+    {
+        pTimer->task = task;
+    #if SCHED_DAEMON_EN && SCHED_DAEMON_QUEUE_EN
+        pTimer->daemon = NULL;
+    #endif
+        sched_PortEventCopy(&pTimer->event, evt);
+        __framework_CoreTimeManagerAddDelay(&pTimer->timerListItem, delay);
+        ret = SCHED_SUCCESS;
+    }
+    else
+    {
+        ret = SCHED_EVENT_SEND_FAILED;
+        SCHED_CHECK(0,chkSCHED_TIMER_NODE_EXHAUSTED);
+    }
+    return (ret);
+}
+
+#endif  /* SCHED_TASK_EN && SCHED_TIMER_EVENT_EN */
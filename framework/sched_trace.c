@@ -0,0 +1,193 @@
+/*******************************************************************************
+* 文 件 名: sched_trace.c
+* 创 建 者: agent
+* 版    本: V1.0
+* 创建日期: 2026-10-19
+* 文件说明: 实现事件驱动调度器的核心框架 - 状态转移跟踪
+*******************************************************************************/
+
+#include "sched_framework.h"
+
+#if SCHED_TASK_EN && SCHED_FSM_TRACE_EN
+/*******************************************************************************
+
+                                    全局变量
+
+*******************************************************************************/
+/*状态转移跟踪缓冲区*/
+SchedTrace_t framework_Trace;
+
+static SchedTraceResidency_t * prvTraceFindResidency(SchedTaskHandle_t task, SchedTraceState_t state);
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+/*状态转移跟踪环境初始化*/
+void framework_TraceEnvirInit(void)
+{
+    framework_Trace.magic     = SCHED_TRACE_MAGIC;
+    framework_Trace.recordLen = SCHED_TRACE_LEN;
+    framework_Trace.stateNum  = SCHED_TRACE_STATE_NUM;
+    framework_TraceReset();
+}
+
+/**
+ * 清除跟踪记录和驻留时间统计, 各状态机当前状态的计时不受影响
+ */
+void framework_TraceReset(void)
+{
+    framework_Trace.head   = 0;
+    framework_Trace.count  = 0;
+    framework_Trace.nState = 0;
+    framework_Trace.nLost  = 0;
+    framework_Trace.total  = 0;
+}
+
+/**
+ * 按时间顺序读取跟踪记录, 最早的记录在前
+ *
+ * @param buf: 保存跟踪记录的缓冲区
+ *
+ * @param max: 缓冲区能保存的最大记录数量, 记录较多时只读取最近的max条记录
+ *
+ * @return: 读取的记录数量
+ */
+uint16_t framework_TraceRead(SchedTraceRecord_t *buf, uint16_t max)
+{
+uint16_t n;
+uint16_t pos;
+uint16_t i;
+
+    SCHED_ASSERT(NULL != buf,errSCHED_PARAM_PTR_IS_NULL);
+    n = (framework_Trace.count < max) ? framework_Trace.count : max;
+    /*跳过较早的记录, 从第n条最近的记录开始读取*/
+    pos = (uint16_t)((framework_Trace.head + SCHED_TRACE_LEN - n) % SCHED_TRACE_LEN);
+    for (i=0;i<n;i++)
+    {
+        buf[i] = framework_Trace.record[pos];
+        pos = (uint16_t)((pos + 1) % SCHED_TRACE_LEN);
+    }
+    return (n);
+}
+
+/**
+ * 读取驻留时间统计
+ *
+ * @param buf: 保存统计项的缓冲区
+ *
+ * @param max: 缓冲区能保存的最大统计项数量
+ *
+ * @return: 读取的统计项数量
+ */
+uint16_t framework_TraceGetResidency(SchedTraceResidency_t *buf, uint16_t max)
+{
+uint16_t n;
+uint16_t i;
+
+    SCHED_ASSERT(NULL != buf,errSCHED_PARAM_PTR_IS_NULL);
+    n = (framework_Trace.nState < max) ? framework_Trace.nState : max;
+    for (i=0;i<n;i++)
+    {
+        buf[i] = framework_Trace.residency[i];
+    }
+    return (n);
+}
+
+/*******************************************************************************
+
+                                    内部函数
+
+*******************************************************************************/
+
+/**
+ * 记录一次状态转移, 并累计原状态的驻留时间,
+ * 只在任务环境中由状态机调用, 不需要进入临界区
+ *
+ * @param fsm: 发生状态转移的状态机指针
+ *
+ * @param from: 原状态标识, SCHED_TRACE_NO_STATE表示初始转移
+ *
+ * @param to: 新状态标识
+ *
+ * @param sig: 触发状态转移的信号
+ */
+void __framework_TraceTransition(SchedFSM_t *fsm, SchedTraceState_t from, SchedTraceState_t to, EvtSig_t sig)
+{
+SchedTraceRecord_t      *pRecord;
+SchedTraceResidency_t   *pResidency;
+SchedTimestamp_t         now;
+
+    now = SCHED_GetTimestamp();
+    /*写入环形缓冲区, 缓冲区满时覆盖最早的记录*/
+    pRecord = &framework_Trace.record[framework_Trace.head];
+    pRecord->task  = (SchedTaskHandle_t)fsm;
+    pRecord->from  = from;
+    pRecord->to    = to;
+    pRecord->stamp = now;
+    pRecord->sig   = sig;
+    framework_Trace.head = (uint16_t)((framework_Trace.head + 1) % SCHED_TRACE_LEN);
+    if (framework_Trace.count < SCHED_TRACE_LEN)
+    {
+        framework_Trace.count++;
+    }
+    framework_Trace.total++;
+    /*累计原状态驻留时间*/
+    if (SCHED_TRACE_NO_STATE != from)
+    {
+        pResidency = prvTraceFindResidency((SchedTaskHandle_t)fsm, from);
+        if (NULL != pResidency)
+        {
+            /*差值先转换回时间戳类型, 节拍计数回绕时驻留时间仍然正确*/
+            pResidency->time += (uint32_t)(SchedTimestamp_t)(now - fsm->enterStamp);
+            pResidency->count++;
+        }
+        else
+        {
+            framework_Trace.nLost++;
+        }
+    }
+    fsm->enterStamp = now;
+}
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+
+/**
+ * 查找状态的驻留时间统计项, 未找到时分配新的统计项
+ *
+ * @param task: 状态所属任务
+ *
+ * @param state: 状态标识
+ *
+ * @return: 统计项指针, 若统计项已用完返回NULL
+ */
+static SchedTraceResidency_t * prvTraceFindResidency(SchedTaskHandle_t task, SchedTraceState_t state)
+{
+SchedTraceResidency_t *pResidency = NULL;
+uint16_t i;
+
+    for (i=0;i<framework_Trace.nState;i++)
+    {
+        if ((framework_Trace.residency[i].task == task)
+          &&(framework_Trace.residency[i].state == state))
+        {
+            pResidency = &framework_Trace.residency[i];
+            break;
+        }
+    }
+    if ((NULL == pResidency) && (framework_Trace.nState < SCHED_TRACE_STATE_NUM))
+    {
+        pResidency = &framework_Trace.residency[framework_Trace.nState++];
+        pResidency->task  = task;
+        pResidency->state = state;
+        pResidency->time  = 0;
+        pResidency->count = 0;
+    }
+    return (pResidency);
+}
+
+#endif  /* SCHED_TASK_EN && SCHED_FSM_TRACE_EN */
@@ -1,287 +1,807 @@
-/*******************************************************************************
-* 文 件 名: sched.h
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-08-03
-* 文件说明: 事件驱动调度器的API函数定义
-*******************************************************************************/
-
-#ifndef __SCHED_H
-#define __SCHED_H
-
-#include "sched_port.h"
-
-/*******************************************************************************
-
-                                  调度核心管理
-
-*******************************************************************************/
-/**
- * 调度器初始化
- *
- * @note: 在执行任何API前必须先调用本函数
- */
-void sched_Init(void);
-
-/**
- * 启动调度器
- *
- * @note: 调用本函数后永远不会返回
- */
-void sched_Start(void);
-
-/**
- * 调度器节拍处理函数
- *
- * @note: 以SCHED_TICK_HZ的频率, 在节拍中断中调用本函数
- */
-void sched_CoreTickHandler(void);
-
-#if SCHED_TASK_EN
-/*******************************************************************************
-
-                                    任务管理
-
-*******************************************************************************/
-/**
- * 创建一个任务并返回任务句柄, 仅允许在调用sched_Start()启动调度器前创建新任务
- *
- * @param prio: 任务优先级(0 - SCHED_LOWEST_PRIORITY)
- *
- * @param queueLen: 配置SCHED_TASK_EVENT_METHOD>=1时, 表示消息队列的长度;
- *                  配置SCHED_TASK_EVENT_METHOD =0时, 参数queueLen无效
- *
- * @param initial: 状态机初始伪状态函数
- *
- * @return: 返回任务句柄, 若为NULL则表示创建失败
- */
-SchedTaskHandle_t sched_TaskCreate(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial);
-
-#if SCHED_TASK_CYCLE_EN
-/**
- * 设置任务的周期循环信号触发周期, 并复位周期信号节拍计数
- *
- * @param task: 指定任务的任务句柄
- *
- * @param period: 设置周期循环信号触发的周期, 0表示不产生周期循环信号
- *
- * @param immedTRIG: 布尔值(SCHED_TRUE/SCHED_FALSE),
- *                   SCHED_TRUE  表示立即触发信号,
- *                   SCHED_FALSE 表示第一个周期结束时触发第一个信号
- */
-void sched_TaskSetCyclePeriod(SchedTaskHandle_t task, SchedTick_t period, SchedBool_t immedTRIG);
-
-/**
- * 获取任务的周期循环信号节拍计数
- *
- * @param task: 指定任务的任务句柄
- *
- * @return: 返回指定任务的周期循环信号节拍计数
- */
-SchedTick_t sched_TaskGetCycleTick(SchedTaskHandle_t task);
-#endif  /* SCHED_TASK_CYCLE_EN */
-
-/*******************************************************************************
-
-                                    事件管理
-
-*******************************************************************************/
-/**
- * 向指定任务传递一个事件
- *
- * @param task: 目标任务的任务句柄
- *
- * @param evtSig: 待传递的事件信号
- *
- * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0, 参数无效
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t sched_EventSend(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
-
-/**
- * 向指定任务传递一个紧急事件
- *
- * @param task: 目标任务的任务句柄
- *
- * @param evtSig: 待传递的事件信号
- *
- * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0, 参数无效
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t sched_EventSendFront(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
-
-/**
- * 在中断函数中向指定任务传递一个事件
- *
- * @param task: 目标任务的任务句柄
- *
- * @param evtSig: 待传递的事件信号
- *
- * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0, 参数无效
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t sched_EventSendFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
-
-/**
- * 在中断函数中向指定任务传递一个紧急事件
- *
- * @param task: 目标任务的任务句柄
- *
- * @param evtSig: 待传递的事件信号
- *
- * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0, 参数无效
- *
- * @return: SCHED_SUCCESS           表示发送成功
- *          SCHED_EVENT_SEND_FAILED 表示发送失败
- */
-SchedStatus_t sched_EventSendFrontFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
-
-#if SCHED_TASK_ALARM_EN
-/*******************************************************************************
-
-                                    闹钟管理
-
-*******************************************************************************/
-/**
- * 创建新闹钟, 仅允许在调用sched_Start()启动调度器前创建闹钟
- *
- * @param task: 闹钟目标任务的任务句柄
- *
- * @param evtSig: 闹钟到时触发的事件信号
- *
- * @param evtMsg: 闹钟到时触发的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0, 参数无效
- *
- * @return: 返回闹钟句柄, 若返回NULL表示创建失败
- */
-SchedAlarmHandle_t sched_AlarmCreate(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
-
-/**
- * 设置闹钟事件
- *
- * @param alarm: 待操作的闹钟句柄
- *
- * @param evtSig: 闹钟到时触发的事件信号
- *
- * @param evtMsg: 闹钟到时触发的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0, 参数无效
- */
-void sched_AlarmSetEvent(SchedAlarmHandle_t alarm, EvtSig_t evtSig, EvtMsg_t evtMsg);
-
-/**
- * 取消闹钟响应, 必须在调度器启动后调用
- *
- * @param alarm: 待操作的闹钟句柄
- */
-void sched_AlarmCancel(SchedAlarmHandle_t alarm);
-
-/**
- * 设置并重启闹钟, 必须在调度器启动后调用
- *
- * @param alarm: 待操作的闹钟句柄
- *
- * @param period: 闹钟到时周期, 若为0则立即触发闹钟事件
- */
-void sched_AlarmSet(SchedAlarmHandle_t alarm, SchedTick_t period);
-
-/**
- * 获取闹钟状态
- *
- * @param alarm: 待操作的闹钟句柄
- *
- * @return: SCHED_ALARM_STOP    表示闹钟停止(闹钟已取消)
- *          SCHED_ALARM_RUNNING 表示闹钟正在运行
- *          SCHED_ALARM_ARRIVED 表示闹钟已到时(此时闹钟停止)
- */
-SchedStatus_t sched_AlarmGetStatus(SchedAlarmHandle_t alarm);
-#endif  /* SCHED_TASK_ALARM_EN */
-
-#endif  /* SCHED_TASK_EN */
-
-#if SCHED_DAEMON_EN
-/*******************************************************************************
-
-                                  守护任务管理
-
-*******************************************************************************/
-/**
- * 创建新的守护任务, 仅允许在调用sched_Start()启动调度器前创建守护任务
- *
- * @param daemonFunc: 守护任务函数指针
- *
- * @return: 返回守护任务句柄, 若返回NULL表示创建失败
- */
-SchedDaemonHandle_t sched_DaemonCreate(SchedDaemonFunction_t daemonFunc);
-
-/**
- * 终止指定的守护任务, 使得指定的守护任务进入休眠状态
- *
- * @param daemon: 守护任务句柄
- */
-void sched_DaemonAbort(SchedDaemonHandle_t daemon);
-
-/**
- * 唤醒守护任务并执行给定的事件
- *
- * @note: 当守护任务处于休眠状态(SCHED_DAEMON_DORMANT)或者
- *        运行状态(SCHED_DAEMON_RUNNING)时,允许唤醒守护任务
- *
- * @param daemon: 待唤醒的守护任务句柄
- *
- * @param evtSig: 守护任务唤醒的事件信号
- *
- * @param evtMsg: 守护任务唤醒的事件消息
- *
- * @param delay: 守护任务执行延时, 延时为0表示守护任务立即就绪
- *
- * @return: SCHED_SUCCESS            表示守护任务唤醒成功
- *          SCHED_DAEMON_CALL_FAILED 表示守护任务唤醒失败
- */
-SchedStatus_t sched_DaemonCall(SchedDaemonHandle_t daemon, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay);
-
-/**
- * 获取指定守护任务的状态
- *
- * @param daemon: 守护任务句柄
- *
- * @return: SCHED_DAEMON_RUNNING 表示守护任务正在运行
- *          SCHED_DAEMON_ACTIVE  表示守护任务已被唤醒
- *          SCHED_DAEMON_DORMANT 表示守护任务处于休眠
- */
-SchedStatus_t sched_DaemonGetStatus(SchedDaemonHandle_t daemon);
-
-/**
- * 在中断函数中唤醒守护任务并执行给定的事件
- *
- * @note: 仅当守护任务处于休眠状态(SCHED_DAEMON_DORMANT), 允许唤醒守护任务
- *
- * @param daemon: 待唤醒的守护任务句柄
- *
- * @param evtSig: 守护任务唤醒的事件信号
- *
- * @param evtMsg: 守护任务唤醒的事件消息
- *
- * @param delay: 守护任务执行延时, 延时为0表示守护任务立即就绪
- *
- * @return: SCHED_SUCCESS            表示守护任务唤醒成功
- *          SCHED_DAEMON_CALL_FAILED 表示守护任务唤醒失败
- */
-SchedStatus_t sched_DaemonCallFromISR(SchedDaemonHandle_t daemon, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay);
-
-/**
- * 在中断函数中获取指定守护任务的状态
- *
- * @param daemon: 守护任务句柄
- *
- * @return: SCHED_DAEMON_RUNNING 表示守护任务正在运行
- *          SCHED_DAEMON_ACTIVE  表示守护任务已被唤醒
- *          SCHED_DAEMON_DORMANT 表示守护任务处于休眠
- */
-SchedStatus_t sched_DaemonGetStatusFromISR(SchedDaemonHandle_t daemon);
-#endif  /* SCHED_DAEMON_EN */
-
-#endif  /* __SCHED_H */
+/*******************************************************************************
+* 文 件 名: sched.h
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-08-03
+* 文件说明: 事件驱动调度器的API函数定义
+*******************************************************************************/
+
+#ifndef __SCHED_H
+#define __SCHED_H
+
+#include "sched_port.h"
+
+/*******************************************************************************
+
+                                  调度核心管理
+
+*******************************************************************************/
+/**
+ * 调度器初始化
+ *
+ * @note: 在执行任何API前必须先调用本函数
+ */
+void sched_Init(void);
+
+/**
+ * 启动调度器
+ *
+ * @note: 调用本函数后永远不会返回
+ */
+void sched_Start(void);
+
+/**
+ * 调度器节拍处理函数
+ *
+ * @note: 以SCHED_TICK_HZ的频率, 在节拍中断中调用本函数
+ */
+void sched_CoreTickHandler(void);
+
+#if SCHED_TASK_EN
+/*******************************************************************************
+
+                                    任务管理
+
+*******************************************************************************/
+#if SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建一个任务并返回任务句柄, 仅允许在调用sched_Start()启动调度器前创建新任务
+ *
+ * @param prio: 任务优先级(0 - SCHED_LOWEST_PRIORITY)
+ *
+ * @param queueLen: 配置SCHED_TASK_EVENT_METHOD>=1时, 表示消息队列的长度;
+ *                  配置SCHED_TASK_EVENT_METHOD =0时, 参数queueLen无效;
+ *                  若使能SCHED_EVENT_POOL_EN, 表示任务允许从共享事件节点池
+ *                  占用的最大节点数量;
+ *                  若SCHED_TASK_QUEUE_LANES>1, 每个优先级通道的长度均为queueLen;
+ *                  若使能SCHED_QUEUE_POW2_EN, 长度向上取整为2的幂,
+ *                  取整后超出EvtPos_t的表示范围时创建失败
+ *
+ * @param initial: 状态机初始伪状态函数
+ *
+ * @return: 返回任务句柄, 若为NULL则表示创建失败
+ *
+ * @note: 配置SCHED_TASK_EVENT_METHOD=0且使能SCHED_SIGTBL_EXT_EN时, 每个任务
+ *        额外占用SCHED_SIGTBL_SIG_NUM*sizeof(EvtMsg_t)字节保存各信号的消息
+ *        (默认64个信号, 共256字节), 需要相应增大SCHED_TOTAL_HEAP_SIZE
+ *
+ * @note: 若使能SCHED_FSM_HSM_EN, 状态机为层次状态机: 状态函数对未处理的事件
+ *        返回SCHED_SUPER(父状态)交给父状态处理, 不返回SCHED_SUPER的状态为顶层状态;
+ *        状态转移时自动按最近公共祖先依次执行退出和进入动作, 转移路径缓存在
+ *        SCHED_HSM_PATH_CACHE个路径缓存中; 进入目标状态后向其发送SCHED_SIG_INIT,
+ *        状态函数可以返回SCHED_TRAN(子状态)继续进入默认子状态
+ */
+SchedTaskHandle_t sched_TaskCreate(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial);
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+/**
+ * 使用调用者提供的存储空间创建一个任务, 不从调度器内存中分配,
+ * 仅允许在调用sched_Start()启动调度器前创建新任务
+ *
+ * @param prio: 任务优先级(0 - SCHED_LOWEST_PRIORITY)
+ *
+ * @param queueLen: 同sched_TaskCreate(), 若使能SCHED_QUEUE_POW2_EN, 长度必须是2的幂
+ *
+ * @param initial: 状态机初始伪状态函数
+ *
+ * @param taskBuf: 任务控制块存储空间, 需要包含sched_framework.h获得SchedTaskStatic_t的完整定义;
+ *                 若使能SCHED_TASK_TABLE_EN, 任务控制块存放在调度器的任务表中, 必须为NULL
+ *
+ * @param queueBuf: 消息队列存储空间, 长度为SCHED_TASK_QUEUE_BUF_LEN(queueLen)个事件块,
+ *                  长度为0时可以为NULL
+ *
+ * @return: 返回任务句柄
+ *
+ * @note: 存储空间在任务存续期间(即调度器运行期间)必须有效, 通常定义为静态变量,
+ *        可以通过链接脚本放置在指定的内存段
+ */
+SchedTaskHandle_t sched_TaskCreateStatic(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial,
+                                         SchedTaskStatic_t *taskBuf, SchedEvent_t *queueBuf);
+#endif
+
+#if SCHED_FSM_TABLE_EN
+#if SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建一个使用状态转移表的任务并返回任务句柄, 状态机按(状态, 信号)查表处理事件,
+ * 仅允许在调用sched_Start()启动调度器前创建新任务
+ *
+ * @param prio: 任务优先级(0 - SCHED_LOWEST_PRIORITY)
+ *
+ * @param queueLen: 同sched_TaskCreate()
+ *
+ * @param table: 状态转移表指针, 通常由SCHED_TABLE_DEFINE()定义,
+ *               或者由C++头文件sched_fsm_table.hpp在编译期生成;
+ *               表中每个单元执行动作后转移到目标状态, 转移时依次执行原状态行
+ *               SCHED_SIG_EXIT单元和新状态行SCHED_SIG_ENTRY单元的动作;
+ *               不小于表的信号数量的信号被忽略
+ *
+ * @return: 返回任务句柄, 若为NULL则表示创建失败
+ */
+SchedTaskHandle_t sched_TaskCreateTable(uint8_t prio, EvtPos_t queueLen, SchedFsmTable_t const *table);
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+/**
+ * 使用调用者提供的存储空间创建一个使用状态转移表的任务
+ *
+ * @param prio: 任务优先级(0 - SCHED_LOWEST_PRIORITY)
+ *
+ * @param queueLen: 同sched_TaskCreateStatic()
+ *
+ * @param table: 同sched_TaskCreateTable()
+ *
+ * @param taskBuf: 同sched_TaskCreateStatic()
+ *
+ * @param queueBuf: 同sched_TaskCreateStatic()
+ *
+ * @return: 返回任务句柄
+ */
+SchedTaskHandle_t sched_TaskCreateTableStatic(uint8_t prio, EvtPos_t queueLen, SchedFsmTable_t const *table,
+                                              SchedTaskStatic_t *taskBuf, SchedEvent_t *queueBuf);
+#endif
+
+/**
+ * 获取使用状态转移表的任务的当前状态
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @return: 当前状态在状态转移表中的序号
+ */
+uint8_t sched_TaskGetTableState(SchedTaskHandle_t task);
+#endif
+
+#if SCHED_TASK_CYCLE_EN
+/**
+ * 设置任务的周期循环信号触发周期, 并复位周期信号节拍计数
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @param period: 设置周期循环信号触发的周期, 0表示不产生周期循环信号
+ *
+ * @param immedTRIG: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *                   SCHED_TRUE  表示立即触发信号,
+ *                   SCHED_FALSE 表示第一个周期结束时触发第一个信号
+ */
+void sched_TaskSetCyclePeriod(SchedTaskHandle_t task, SchedTick_t period, SchedBool_t immedTRIG);
+
+/**
+ * 获取任务的周期循环信号节拍计数
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @return: 返回指定任务的周期循环信号节拍计数
+ */
+SchedTick_t sched_TaskGetCycleTick(SchedTaskHandle_t task);
+#endif  /* SCHED_TASK_CYCLE_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_QUEUE_POLICY_EN
+/**
+ * 设置任务消息队列已满时的溢出策略, 仅允许在调用sched_Start()启动调度器前设置
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @param policy: SCHED_QUEUE_REJECT      表示拒绝新事件(默认策略)
+ *                SCHED_QUEUE_DROP_OLDEST 表示丢弃队列中最早的事件, 新事件发送成功;
+ *                                        若使能SCHED_EVENT_POOL_EN且本任务队列为空
+ *                                        (节点池被其他任务用完), 新事件发送失败,
+ *                                        不计入丢弃计数
+ *                SCHED_QUEUE_COALESCE    表示替换队列中相同信号的事件, 若不存在
+ *                                        相同信号的事件则拒绝新事件
+ */
+void sched_TaskSetOverflowPolicy(SchedTaskHandle_t task, uint8_t policy);
+
+/**
+ * 获取任务消息队列的丢弃计数
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @return: 消息队列溢出时被拒绝, 丢弃或者替换的事件数量
+ */
+uint32_t sched_TaskGetDropCount(SchedTaskHandle_t task);
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_QUEUE_POLICY_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_CONFLATE_EN
+/**
+ * 设置任务的指定信号是否合并
+ *
+ * @note: 合并信号在消息队列中最多只有一个等待的事件,
+ *        发送已在队列中等待的合并信号时, 直接更新等待事件的消息, 事件位置不变;
+ *        sched_EventRecall()召回的事件不与等待事件合并, 若此前没有等待事件,
+ *        之后的发送更新最后召回的同信号事件
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @param sig: 设置的信号, 有效范围是SCHED_SIG_USER - SCHED_SIG_USER+SCHED_CONFLATE_SIG_NUM-1
+ *
+ * @param enable: 布尔值(SCHED_TRUE/SCHED_FALSE), 表示是否合并信号
+ */
+void sched_TaskSetConflate(SchedTaskHandle_t task, EvtSig_t sig, SchedBool_t enable);
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_CONFLATE_EN */
+
+#if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+/**
+ * 设置任务的事件有效期, 在消息队列中等待时间超过有效期的事件不会交给状态函数处理
+ *
+ * @note: 事件发送时记录SCHED_GetTimestamp()时间戳, 默认使用调度器节拍计数,
+ *        可在cpu.h中定义CPU_GetTimestamp()使用周期计数器
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @param ttl: 事件有效期, 单位与时间戳一致, 若为0则事件永久有效
+ */
+void sched_TaskSetEventTTL(SchedTaskHandle_t task, SchedTimestamp_t ttl);
+
+/**
+ * 获取任务超过有效期被丢弃的事件数量
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @return: 超过有效期被丢弃的事件数量
+ */
+uint32_t sched_TaskGetExpiredCount(SchedTaskHandle_t task);
+
+#if SCHED_LATENCY_STAT_EN
+/**
+ * 获取任务事件排队延时(从发送到处理)直方图的指定分档计数
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @param bin: 直方图分档(0 - SCHED_LATENCY_BINS-1), 分档0统计延时为0的事件,
+ *             分档n统计延时为2^(n-1) - 2^n-1的事件, 最后一个分档同时统计所有更大的延时
+ *
+ * @return: 指定分档的事件数量
+ */
+uint32_t sched_TaskGetLatencyCount(SchedTaskHandle_t task, uint8_t bin);
+
+/**
+ * 获取任务事件的最大排队延时
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @return: 最大排队延时, 单位与时间戳一致
+ */
+SchedTimestamp_t sched_TaskGetLatencyMax(SchedTaskHandle_t task);
+#endif  /* SCHED_LATENCY_STAT_EN */
+#endif  /* SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1) */
+
+#if SCHED_SIGMASK_METHOD
+/**
+ * 设置任务当前状态接收的用户信号, 被屏蔽的事件不会交给状态函数处理
+ *
+ * @note: 状态转移时屏蔽字恢复为SCHED_SIGMASK_ALL, 通常在状态的进入动作中调用,
+ *        例如sched_TaskSetSigMask(me, SCHED_SIGMASK(SIG_A)|SCHED_SIGMASK(SIG_B));
+ *        屏蔽字只覆盖SCHED_SIG_USER - SCHED_SIG_USER+31, 其余信号总是被接收;
+ *        使用消息队列时, SCHED_SIGMASK_METHOD=1丢弃被屏蔽的事件,
+ *        SCHED_SIGMASK_METHOD=2将被屏蔽的事件保存到延迟队列(需使能SCHED_TASK_DEFER_EN),
+ *        并在状态转移后自动召回; 该延迟队列与sched_EventDefer()共用, 状态转移后
+ *        通过sched_EventDefer()延迟的事件也会一并被召回;
+ *        使用记录表时, 被屏蔽的信号保留在记录表中, 直到状态接收该信号才使任务就绪
+ *
+ * @param task: 指定任务的任务句柄
+ *
+ * @param mask: 信号屏蔽字, 第n位为0表示屏蔽信号SCHED_SIG_USER+n
+ */
+void sched_TaskSetSigMask(SchedTaskHandle_t task, SchedSigMask_t mask);
+#endif  /* SCHED_SIGMASK_METHOD */
+
+#if SCHED_FSM_TRACE_EN
+/**
+ * 按时间顺序读取最近的状态转移跟踪记录, 最早的记录在前
+ *
+ * @param buf: 保存跟踪记录的缓冲区
+ *
+ * @param max: 缓冲区能保存的最大记录数量
+ *
+ * @return: 读取的记录数量
+ *
+ * @note: 记录中的状态标识为状态函数地址, 使用状态转移表的任务为状态序号,
+ *        主机工具也可以通过调试接口直接读取全局变量framework_Trace
+ */
+uint16_t sched_TraceRead(SchedTraceRecord_t *buf, uint16_t max);
+
+/**
+ * 读取各状态的累计驻留时间, 时间单位与SCHED_GetTimestamp()相同,
+ * 只统计已离开状态的驻留时间
+ *
+ * @param buf: 保存统计项的缓冲区
+ *
+ * @param max: 缓冲区能保存的最大统计项数量(不超过SCHED_TRACE_STATE_NUM)
+ *
+ * @return: 读取的统计项数量
+ */
+uint16_t sched_TraceGetResidency(SchedTraceResidency_t *buf, uint16_t max);
+
+/**
+ * 清除状态转移跟踪记录和驻留时间统计
+ */
+void sched_TraceReset(void);
+#endif  /* SCHED_FSM_TRACE_EN */
+
+/*******************************************************************************
+
+                                    事件管理
+
+*******************************************************************************/
+/**
+ * 向指定任务传递一个事件
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param evtSig: 待传递的事件信号
+ *
+ * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0且未使能SCHED_SIGTBL_EXT_EN, 参数无效
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t sched_EventSend(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
+
+/**
+ * 向指定任务传递一个紧急事件
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param evtSig: 待传递的事件信号
+ *
+ * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0且未使能SCHED_SIGTBL_EXT_EN, 参数无效
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t sched_EventSendFront(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
+
+/**
+ * 在中断函数中向指定任务传递一个事件
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param evtSig: 待传递的事件信号
+ *
+ * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0且未使能SCHED_SIGTBL_EXT_EN, 参数无效
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t sched_EventSendFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
+
+/**
+ * 在中断函数中向指定任务传递一个紧急事件
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param evtSig: 待传递的事件信号
+ *
+ * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0且未使能SCHED_SIGTBL_EXT_EN, 参数无效
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t sched_EventSendFrontFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && (SCHED_TASK_QUEUE_LANES > 1)
+/**
+ * 向指定任务消息队列的指定优先级通道传递一个事件
+ *
+ * @note: 任务总是先处理高优先级通道中的事件, 同一通道内的事件保持先进先出;
+ *        sched_EventSend()和sched_EventSendFront()使用最低优先级通道
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param lane: 消息队列通道(0 - SCHED_TASK_QUEUE_LANES-1), 0为最高优先级通道
+ *
+ * @param evtSig: 待传递的事件信号
+ *
+ * @param evtMsg: 待传递的事件消息
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t sched_EventSendLane(SchedTaskHandle_t task, uint8_t lane, EvtSig_t evtSig, EvtMsg_t evtMsg);
+
+/**
+ * 在中断函数中向指定任务消息队列的指定优先级通道传递一个事件
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param lane: 消息队列通道(0 - SCHED_TASK_QUEUE_LANES-1), 0为最高优先级通道
+ *
+ * @param evtSig: 待传递的事件信号
+ *
+ * @param evtMsg: 待传递的事件消息
+ *
+ * @return: SCHED_SUCCESS           表示发送成功
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败
+ */
+SchedStatus_t sched_EventSendLaneFromISR(SchedTaskHandle_t task, uint8_t lane, EvtSig_t evtSig, EvtMsg_t evtMsg);
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && (SCHED_TASK_QUEUE_LANES > 1) */
+
+#if SCHED_TIMER_EVENT_EN
+/**
+ * 延时向指定任务传递一个事件, 无需预先创建闹钟
+ *
+ * @note: 延时期间占用一个定时节点(共SCHED_TIMER_NODE_NUM个), 事件发送后自动释放;
+ *        延时事件发出后不可取消, 需要取消的超时请使用闹钟
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param evtSig: 待传递的事件信号
+ *
+ * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0且未使能SCHED_SIGTBL_EXT_EN, 参数无效
+ *
+ * @param delay: 延时节拍数, 若为0则立即发送事件
+ *
+ * @return: SCHED_SUCCESS           表示发送成功(或者已开始延时)
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败(或者定时节点已用完)
+ */
+SchedStatus_t sched_EventSendDelayed(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay);
+
+/**
+ * 在中断函数中延时向指定任务传递一个事件
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param evtSig: 待传递的事件信号
+ *
+ * @param evtMsg: 待传递的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0且未使能SCHED_SIGTBL_EXT_EN, 参数无效
+ *
+ * @param delay: 延时节拍数, 若为0则立即发送事件
+ *
+ * @return: SCHED_SUCCESS           表示发送成功(或者已开始延时)
+ *          SCHED_EVENT_SEND_FAILED 表示发送失败(或者定时节点已用完)
+ */
+SchedStatus_t sched_EventSendDelayedFromISR(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay);
+
+/**
+ * 获取定时节点池自调度器初始化以来的空闲节点最小量
+ *
+ * @return: 空闲节点最小量, 用于评估SCHED_TIMER_NODE_NUM是否合适,
+ *          若为0则表示定时节点曾被用完, 期间的延时发送可能已经失败
+ */
+uint16_t sched_TimerGetMinFree(void);
+#endif  /* SCHED_TIMER_EVENT_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_TASK_DEFER_EN
+/**
+ * 延迟指定任务的事件, 事件保存在任务的延迟队列中, 召回前不会被状态机处理
+ *
+ * @note: 通常在状态函数中调用sched_EventDefer(me, e)延迟当前暂时无法处理的事件,
+ *        并在能够处理的状态(例如ENTRY动作)中调用sched_EventRecall(me)召回;
+ *        若SCHED_SIGMASK_METHOD=2, 被屏蔽的事件也保存在同一个延迟队列中,
+ *        每次状态转移后延迟队列中的全部事件(包括本函数延迟的事件)都会被自动召回
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @param evt: 待延迟的事件块指针, 只允许延迟用户信号
+ *
+ * @return: SCHED_SUCCESS           表示延迟成功
+ *          SCHED_EVENT_SEND_FAILED 表示延迟队列已满
+ */
+SchedStatus_t sched_EventDefer(SchedTaskHandle_t task, SchedEvent_t const *evt);
+
+/**
+ * 召回指定任务的全部延迟事件, 召回的事件按原顺序插入消息队列头部(最高优先级通道)
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @return: 召回的事件数量, 消息队列空位不足时剩余的事件继续保留在延迟队列
+ */
+EvtPos_t sched_EventRecall(SchedTaskHandle_t task);
+
+#if SCHED_QUEUE_POLICY_EN
+/**
+ * 获取指定任务延迟队列的丢弃计数, 不包含在sched_TaskGetDropCount()中
+ *
+ * @param task: 目标任务的任务句柄
+ *
+ * @return: 延迟队列已满时被拒绝的延迟事件数量,
+ *          包括SCHED_SIGMASK_METHOD=2时无法保存的被屏蔽事件
+ */
+uint32_t sched_EventDeferGetDropCount(SchedTaskHandle_t task);
+#endif
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_TASK_DEFER_EN */
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN
+/**
+ * 获取共享事件节点池自调度器初始化以来的空闲节点最小量
+ *
+ * @return: 空闲节点最小量, 用于评估SCHED_EVENT_POOL_SIZE是否合适,
+ *          若为0则表示节点池曾被用完, 期间的发送可能已经失败
+ */
+EvtPos_t sched_EventPoolGetMinFree(void);
+#endif  /* (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN */
+
+#if SCHED_TASK_ALARM_EN
+/*******************************************************************************
+
+                                    闹钟管理
+
+*******************************************************************************/
+#if SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建新闹钟, 仅允许在调用sched_Start()启动调度器前创建闹钟
+ *
+ * @param task: 闹钟目标任务的任务句柄
+ *
+ * @param evtSig: 闹钟到时触发的事件信号
+ *
+ * @param evtMsg: 闹钟到时触发的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0且未使能SCHED_SIGTBL_EXT_EN, 参数无效
+ *
+ * @return: 返回闹钟句柄, 若返回NULL表示创建失败
+ */
+SchedAlarmHandle_t sched_AlarmCreate(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg);
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+/**
+ * 使用调用者提供的存储空间创建新闹钟, 仅允许在调用sched_Start()启动调度器前创建闹钟
+ *
+ * @param task: 闹钟目标任务的任务句柄
+ *
+ * @param evtSig: 闹钟到时触发的事件信号
+ *
+ * @param evtMsg: 同sched_AlarmCreate()
+ *
+ * @param alarmBuf: 闹钟控制块存储空间
+ *
+ * @return: 返回闹钟句柄
+ */
+SchedAlarmHandle_t sched_AlarmCreateStatic(SchedTaskHandle_t task, EvtSig_t evtSig, EvtMsg_t evtMsg,
+                                           SchedAlarmStatic_t *alarmBuf);
+#endif
+
+/**
+ * 设置闹钟事件
+ *
+ * @param alarm: 待操作的闹钟句柄
+ *
+ * @param evtSig: 闹钟到时触发的事件信号
+ *
+ * @param evtMsg: 闹钟到时触发的事件消息, 若配置SCHED_TASK_EVENT_METHOD=0且未使能SCHED_SIGTBL_EXT_EN, 参数无效
+ */
+void sched_AlarmSetEvent(SchedAlarmHandle_t alarm, EvtSig_t evtSig, EvtMsg_t evtMsg);
+
+/**
+ * 取消闹钟响应, 必须在调度器启动后调用
+ *
+ * @param alarm: 待操作的闹钟句柄
+ */
+void sched_AlarmCancel(SchedAlarmHandle_t alarm);
+
+/**
+ * 设置并重启闹钟, 必须在调度器启动后调用
+ *
+ * @param alarm: 待操作的闹钟句柄
+ *
+ * @param period: 闹钟到时周期, 若为0则立即触发闹钟事件
+ */
+void sched_AlarmSet(SchedAlarmHandle_t alarm, SchedTick_t period);
+
+/**
+ * 获取闹钟状态
+ *
+ * @param alarm: 待操作的闹钟句柄
+ *
+ * @return: SCHED_ALARM_STOP    表示闹钟停止(闹钟已取消)
+ *          SCHED_ALARM_RUNNING 表示闹钟正在运行
+ *          SCHED_ALARM_ARRIVED 表示闹钟已到时(此时闹钟停止)
+ */
+SchedStatus_t sched_AlarmGetStatus(SchedAlarmHandle_t alarm);
+#endif  /* SCHED_TASK_ALARM_EN */
+
+#endif  /* SCHED_TASK_EN */
+
+#if SCHED_DAEMON_EN
+/*******************************************************************************
+
+                                  守护任务管理
+
+*******************************************************************************/
+#if SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建新的守护任务, 仅允许在调用sched_Start()启动调度器前创建守护任务
+ *
+ * @param daemonFunc: 守护任务函数指针
+ *
+ * @return: 返回守护任务句柄, 若返回NULL表示创建失败
+ *
+ * @note: 若使能SCHED_DAEMON_PRIO_EN, 守护任务的优先级为SCHED_DAEMON_LOWEST_PRIO
+ */
+SchedDaemonHandle_t sched_DaemonCreate(SchedDaemonFunction_t daemonFunc);
+#endif
+
+#if SCHED_DAEMON_PRIO_EN && SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建指定优先级的新守护任务, 仅允许在调用sched_Start()启动调度器前创建守护任务,
+ * 调度器总是先执行优先级最高的就绪守护任务, 相同优先级的守护任务按就绪顺序执行
+ *
+ * @param daemonFunc: 守护任务函数指针
+ *
+ * @param prio: 守护任务优先级(0 - SCHED_DAEMON_LOWEST_PRIO), 0为最高优先级
+ *
+ * @return: 返回守护任务句柄, 若返回NULL表示创建失败
+ */
+SchedDaemonHandle_t sched_DaemonCreatePrio(SchedDaemonFunction_t daemonFunc, uint8_t prio);
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+/**
+ * 使用调用者提供的存储空间创建新的守护任务, 仅允许在调用sched_Start()启动调度器前创建
+ *
+ * @param daemonFunc: 守护任务函数指针
+ *
+ * @param daemonBuf: 守护任务控制块存储空间
+ *
+ * @param queueBuf: 调用队列存储空间, 长度为SCHED_DAEMON_QUEUE_BUF_LEN,
+ *                  未使能SCHED_DAEMON_QUEUE_EN时必须为NULL
+ *
+ * @return: 返回守护任务句柄
+ *
+ * @note: 若使能SCHED_DAEMON_PRIO_EN, 守护任务的优先级为SCHED_DAEMON_LOWEST_PRIO
+ */
+SchedDaemonHandle_t sched_DaemonCreateStatic(SchedDaemonFunction_t daemonFunc,
+                                             SchedDaemonStatic_t *daemonBuf, SchedDaemonQueueItem_t *queueBuf);
+
+#if SCHED_DAEMON_PRIO_EN
+/**
+ * 使用调用者提供的存储空间创建指定优先级的新守护任务
+ *
+ * @param daemonFunc: 守护任务函数指针
+ *
+ * @param prio: 守护任务优先级(0 - SCHED_DAEMON_LOWEST_PRIO), 0为最高优先级
+ *
+ * @param daemonBuf: 守护任务控制块存储空间
+ *
+ * @param queueBuf: 同sched_DaemonCreateStatic()
+ *
+ * @return: 返回守护任务句柄
+ */
+SchedDaemonHandle_t sched_DaemonCreatePrioStatic(SchedDaemonFunction_t daemonFunc, uint8_t prio,
+                                                 SchedDaemonStatic_t *daemonBuf, SchedDaemonQueueItem_t *queueBuf);
+#endif
+#endif
+
+/**
+ * 终止指定的守护任务, 使得指定的守护任务进入休眠状态
+ *
+ * @param daemon: 守护任务句柄
+ */
+void sched_DaemonAbort(SchedDaemonHandle_t daemon);
+
+#if SCHED_DAEMON_OFFLOAD_EN && SCHED_DYNAMIC_ALLOC_EN
+/**
+ * 创建卸载到工作线程执行的新守护任务, 仅允许在调用sched_Start()启动调度器前创建,
+ * 守护任务被调度时事件作为作业提交到工作线程池, 作业完成后以卸载函数的返回值
+ * 为消息向指定任务发送完成事件
+ *
+ * @param offloadFunc: 在工作线程中执行的卸载函数, 不允许调用调度器接口
+ *
+ * @param task: 接收完成事件的任务句柄, NULL表示不发送完成事件
+ *
+ * @param doneSig: 完成事件信号, 必须是用户信号
+ *
+ * @return: 返回守护任务句柄, 若返回NULL表示创建失败
+ *
+ * @note: 作业执行期间守护任务处于运行状态(SCHED_DAEMON_RUNNING),
+ *        完成事件由守护任务调度函数发送, 不会在工作线程中发送
+ */
+SchedDaemonHandle_t sched_DaemonCreateOffload(SchedOffloadFunction_t offloadFunc, SchedTaskHandle_t task, EvtSig_t doneSig);
+#endif
+
+/**
+ * 唤醒守护任务并执行给定的事件
+ *
+ * @note: 当守护任务处于休眠状态(SCHED_DAEMON_DORMANT)或者
+ *        运行状态(SCHED_DAEMON_RUNNING)时,允许唤醒守护任务;
+ *        使能SCHED_DAEMON_QUEUE_EN时, 只要调用队列未满即允许调用,
+ *        每次调用执行一次守护任务, 延时调用由定时节点实现(需使能SCHED_TIMER_EVENT_EN)
+ *
+ * @param daemon: 待唤醒的守护任务句柄
+ *
+ * @param evtSig: 守护任务唤醒的事件信号
+ *
+ * @param evtMsg: 守护任务唤醒的事件消息
+ *
+ * @param delay: 守护任务执行延时, 延时为0表示守护任务立即就绪
+ *
+ * @return: SCHED_SUCCESS            表示守护任务唤醒成功
+ *          SCHED_DAEMON_CALL_FAILED 表示守护任务唤醒失败
+ */
+SchedStatus_t sched_DaemonCall(SchedDaemonHandle_t daemon, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay);
+
+/**
+ * 获取指定守护任务的状态
+ *
+ * @param daemon: 守护任务句柄
+ *
+ * @return: SCHED_DAEMON_RUNNING 表示守护任务正在运行
+ *          SCHED_DAEMON_ACTIVE  表示守护任务已被唤醒
+ *          SCHED_DAEMON_DORMANT 表示守护任务处于休眠
+ */
+SchedStatus_t sched_DaemonGetStatus(SchedDaemonHandle_t daemon);
+
+/**
+ * 在中断函数中唤醒守护任务并执行给定的事件
+ *
+ * @note: 仅当守护任务处于休眠状态(SCHED_DAEMON_DORMANT), 允许唤醒守护任务;
+ *        使能SCHED_DAEMON_QUEUE_EN时, 只要调用队列未满即允许调用
+ *
+ * @param daemon: 待唤醒的守护任务句柄
+ *
+ * @param evtSig: 守护任务唤醒的事件信号
+ *
+ * @param evtMsg: 守护任务唤醒的事件消息
+ *
+ * @param delay: 守护任务执行延时, 延时为0表示守护任务立即就绪
+ *
+ * @return: SCHED_SUCCESS            表示守护任务唤醒成功
+ *          SCHED_DAEMON_CALL_FAILED 表示守护任务唤醒失败
+ */
+SchedStatus_t sched_DaemonCallFromISR(SchedDaemonHandle_t daemon, EvtSig_t evtSig, EvtMsg_t evtMsg, SchedTick_t delay);
+
+/**
+ * 在中断函数中获取指定守护任务的状态
+ *
+ * @param daemon: 守护任务句柄
+ *
+ * @return: SCHED_DAEMON_RUNNING 表示守护任务正在运行
+ *          SCHED_DAEMON_ACTIVE  表示守护任务已被唤醒
+ *          SCHED_DAEMON_DORMANT 表示守护任务处于休眠
+ */
+SchedStatus_t sched_DaemonGetStatusFromISR(SchedDaemonHandle_t daemon);
+
+#if SCHED_DAEMON_CYCLE_EN
+/**
+ * 设置守护任务周期调用的周期, 每个周期以SCHED_SIG_CYCLE信号调用一次守护任务
+ *
+ * @param daemon: 守护任务句柄
+ *
+ * @param period: 周期调用的周期, 0表示停止周期调用
+ *
+ * @param immedTRIG: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *                   SCHED_TRUE  表示立即调用一次守护任务,
+ *                   SCHED_FALSE 表示第一个周期结束时第一次调用
+ *
+ * @note: 到时守护任务不允许被调用(或者调用队列已满)时跳过本次调用,
+ *        周期调用不受sched_DaemonAbort()影响
+ */
+void sched_DaemonSetCyclePeriod(SchedDaemonHandle_t daemon, SchedTick_t period, SchedBool_t immedTRIG);
+#endif  /* SCHED_DAEMON_CYCLE_EN */
+
+#if SCHED_DAEMON_CO_EN
+/*
+    以下函数供协程宏函数SCHED_CO_BEGIN()/YIELD()/SLEEP()/WAIT()/END()使用,
+    除sched_DaemonCoGetLine()外, 只允许在守护任务自身的守护任务函数中调用
+*/
+/**
+ * 获取协程断点行号
+ *
+ * @param daemon: 守护任务句柄
+ *
+ * @return: 断点行号, 0表示从头执行
+ */
+uint16_t sched_DaemonCoGetLine(SchedDaemonHandle_t daemon);
+
+/**
+ * 设置协程断点行号, 守护任务返回后休眠, 下次被调用时从断点继续执行
+ *
+ * @param daemon: 当前运行的守护任务句柄
+ *
+ * @param line: 断点行号, 0表示下次从头执行
+ */
+void sched_DaemonCoSetLine(SchedDaemonHandle_t daemon, uint16_t line);
+
+/**
+ * 设置协程断点行号并让出, 守护任务返回后重新就绪, 从断点继续处理原事件
+ *
+ * @param daemon: 当前运行的守护任务句柄
+ *
+ * @param line: 断点行号
+ *
+ * @param delay: 让出延时节拍数, 0表示立即重新就绪
+ */
+void sched_DaemonCoYield(SchedDaemonHandle_t daemon, uint16_t line, SchedTick_t delay);
+#endif  /* SCHED_DAEMON_CO_EN */
+#endif  /* SCHED_DAEMON_EN */
+
+#endif  /* __SCHED_H */
@@ -0,0 +1,286 @@
+/*******************************************************************************
+* 文 件 名: sched.hpp
+* 创 建 者: agent
+* 版    本: V1.0
+* 创建日期: 2026-10-19
+* 文件说明: 事件驱动调度器的C++封装(需要C++17), 仅头文件,
+*           不使用RTTI和异常, 除任务创建时的sched_PortMalloc()外不分配内存
+*******************************************************************************/
+
+#ifndef __SCHED_HPP
+#define __SCHED_HPP
+
+/* 头文件 --------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+extern "C" {
+#include "sched.h"
+}
+
+#if SCHED_TASK_EN
+
+namespace sched {
+
+/*状态函数返回值*/
+using Ret = SchedBase_t;
+
+/*内部信号*/
+inline constexpr EvtSig_t SigEmpty = SCHED_SIG_EMPTY;
+inline constexpr EvtSig_t SigEntry = SCHED_SIG_ENTRY;
+inline constexpr EvtSig_t SigExit  = SCHED_SIG_EXIT;
+inline constexpr EvtSig_t SigCycle = SCHED_SIG_CYCLE;
+#if SCHED_FSM_HSM_EN
+inline constexpr EvtSig_t SigInit  = SCHED_SIG_INIT;
+#endif
+
+namespace detail {
+
+/*载荷类型检查, 无载荷(void)总是允许*/
+template <class Payload>
+inline constexpr bool payload_fits = std::is_trivially_copyable_v<Payload>
+                                  && (sizeof(Payload) <= sizeof(EvtMsg_t));
+template <>
+inline constexpr bool payload_fits<void> = true;
+
+} /* namespace detail */
+
+/*
+    类型化信号, 把信号值和消息载荷类型绑定, 用法:
+
+    enum class MySig : EvtSig_t { Start = SCHED_SIG_USER, Stop };
+    using Start = sched::Signal<MySig::Start, std::uint16_t>;
+    using Stop  = sched::Signal<MySig::Stop>;
+
+    载荷必须可平凡复制且不大于EvtMsg_t, 通过按字节复制存入事件消息
+*/
+template <auto SigValue, class Payload = void>
+struct Signal
+{
+    static_assert(std::is_enum_v<decltype(SigValue)> || std::is_integral_v<decltype(SigValue)>,
+                  "signal value must be an enum or integer");
+    static_assert(detail::payload_fits<Payload>,
+                  "payload must be trivially copyable and fit in EvtMsg_t");
+
+    static constexpr EvtSig_t value = static_cast<EvtSig_t>(SigValue);
+    using payload_type = Payload;
+
+    static_assert(value >= SCHED_SIG_USER, "user signals start at SCHED_SIG_USER");
+};
+
+namespace detail {
+
+/*把载荷按字节复制到事件消息*/
+template <class Payload>
+inline EvtMsg_t pack(Payload const &payload)
+{
+    EvtMsg_t msg = 0;
+    std::memcpy(&msg, &payload, sizeof(Payload));
+    return msg;
+}
+
+/*从事件消息中取出载荷*/
+template <class Payload>
+inline Payload unpack(EvtMsg_t msg)
+{
+    Payload payload;
+    std::memcpy(&payload, &msg, sizeof(Payload));
+    return payload;
+}
+
+} /* namespace detail */
+
+/*状态函数接收的事件, 按值传递, 只包含事件块指针*/
+class Event
+{
+public:
+    explicit Event(SchedEvent_t const &e) : e_(&e) {}
+
+    EvtSig_t sig() const { return e_->sig; }
+    EvtMsg_t msg() const { return e_->msg; }
+    SchedEvent_t const &raw() const { return *e_; }
+
+    /*判断是否为指定的类型化信号*/
+    template <class S>
+    bool is() const { return e_->sig == S::value; }
+
+    /*取出指定类型化信号的载荷, 调用前应确认信号类型*/
+    template <class S>
+    typename S::payload_type payload() const
+    {
+        static_assert(!std::is_void_v<typename S::payload_type>, "signal carries no payload");
+        return detail::unpack<typename S::payload_type>(e_->msg);
+    }
+
+private:
+    SchedEvent_t const *e_;
+};
+
+/*
+    CRTP活动对象基类, 用法:
+
+    class Blinky : public sched::Active<Blinky>
+    {
+    public:
+        Ret initial(Event e) { return tran<&Blinky::off>(); }
+        Ret off(Event e)
+        {
+            switch (e.sig())
+            {
+                case sched::SigEntry: ...; return handled();
+                case Start::value:    ...; return tran<&Blinky::on>();
+            }
+            return ignored();
+        }
+        ...
+    };
+
+    static Blinky blinky;
+    blinky.start(prio, queueLen);
+
+    每个状态对应一个成员函数, 由模板为其生成C状态函数, 状态函数指针在编译期确定,
+    编译器可以内联状态处理函数; 每个派生类只允许一个实例, 需要多个实例时
+    可以用模板参数区分派生类; 若initial()为私有成员, 派生类需要声明
+    friend class sched::Active<Derived>
+*/
+template <class Derived>
+class Active
+{
+public:
+    using Ret   = sched::Ret;
+    using Event = sched::Event;
+    using State = Ret (Derived::*)(Event);
+
+    Active() = default;
+    Active(Active const &) = delete;
+    Active &operator=(Active const &) = delete;
+
+#if SCHED_DYNAMIC_ALLOC_EN
+    /*创建任务, 仅允许在sched_Start()之前调用, 返回是否创建成功*/
+    bool start(std::uint8_t prio, EvtPos_t queueLen)
+    {
+        /*每个派生类只允许一个实例, 重复启动同一实例是允许的*/
+        SCHED_ASSERT((nullptr == self_) || (static_cast<Derived *>(this) == self_),errSCHED_PARAM_NOT_ALLOWED);
+        self_ = static_cast<Derived *>(this);
+        handle_ = sched_TaskCreate(prio, queueLen, &thunk<&Derived::initial>);
+        return (nullptr != handle_);
+    }
+#endif
+
+#if SCHED_STATIC_ALLOC_EN
+    /*使用调用者提供的存储空间创建任务, 存储空间要求同sched_TaskCreateStatic()*/
+    bool start(std::uint8_t prio, EvtPos_t queueLen, SchedTaskStatic_t *taskBuf, SchedEvent_t *queueBuf)
+    {
+        SCHED_ASSERT((nullptr == self_) || (static_cast<Derived *>(this) == self_),errSCHED_PARAM_NOT_ALLOWED);
+        self_ = static_cast<Derived *>(this);
+        handle_ = sched_TaskCreateStatic(prio, queueLen, &thunk<&Derived::initial>, taskBuf, queueBuf);
+        return (nullptr != handle_);
+    }
+#endif
+
+    SchedTaskHandle_t handle() const { return handle_; }
+
+    /*发送类型化信号, 载荷类型在编译期检查*/
+    template <class S, class... A>
+    SchedStatus_t post(A const &... payload) const
+    {
+        return sched_EventSend(handle_, S::value, message<S>(payload...));
+    }
+
+    template <class S, class... A>
+    SchedStatus_t postFront(A const &... payload) const
+    {
+        return sched_EventSendFront(handle_, S::value, message<S>(payload...));
+    }
+
+    template <class S, class... A>
+    SchedStatus_t postFromISR(A const &... payload) const
+    {
+        return sched_EventSendFromISR(handle_, S::value, message<S>(payload...));
+    }
+
+#if SCHED_TIMER_EVENT_EN
+    template <class S, class... A>
+    SchedStatus_t postDelayed(SchedTick_t delay, A const &... payload) const
+    {
+        return sched_EventSendDelayed(handle_, S::value, message<S>(payload...), delay);
+    }
+#endif
+
+#if SCHED_TASK_CYCLE_EN
+    void setCyclePeriod(SchedTick_t period, bool immediate = false) const
+    {
+        sched_TaskSetCyclePeriod(handle_, period, immediate ? SCHED_TRUE : SCHED_FALSE);
+    }
+#endif
+
+#if SCHED_SIGMASK_METHOD
+    void setSigMask(SchedSigMask_t mask) const { sched_TaskSetSigMask(handle_, mask); }
+#endif
+
+    /*判断当前是否处于指定状态*/
+    template <State S>
+    bool isIn() const
+    {
+        return *reinterpret_cast<SchedStateFunction_t const *>(handle_) == &thunk<S>;
+    }
+
+protected:
+    static constexpr Ret handled() { return SCHED_RET_HANDLED; }
+    static constexpr Ret ignored() { return SCHED_RET_IGNORED; }
+
+    /*状态转移, 与SCHED_TRAN()相同*/
+    template <State S>
+    Ret tran() const
+    {
+        *reinterpret_cast<SchedStateFunction_t *>(handle_) = &thunk<S>;
+        return SCHED_RET_TRAN;
+    }
+
+#if SCHED_FSM_HSM_EN
+    /*交给超状态处理, 与SCHED_SUPER()相同*/
+    template <State S>
+    Ret super() const
+    {
+        *reinterpret_cast<SchedStateFunction_t *>(handle_) = &thunk<S>;
+        return SCHED_RET_SUPER;
+    }
+#endif
+
+private:
+    /*为每个状态成员函数生成的C状态函数*/
+    template <State S>
+    static SchedBase_t thunk(SchedTaskHandle_t me, SchedEvent_t const *e)
+    {
+        static_cast<void>(me);
+        return (self_->*S)(Event(*e));
+    }
+
+    template <class S, class... A>
+    static EvtMsg_t message(A const &... payload)
+    {
+        using P = typename S::payload_type;
+
+        if constexpr (std::is_void_v<P>)
+        {
+            static_assert(sizeof...(A) == 0, "signal carries no payload");
+            return 0;
+        }
+        else
+        {
+            static_assert(sizeof...(A) == 1, "signal requires exactly one payload");
+            return detail::pack<P>(static_cast<P>(payload)...);
+        }
+    }
+
+    inline static Derived *self_ = nullptr;
+    SchedTaskHandle_t handle_ = nullptr;
+};
+
+} /* namespace sched */
+
+#endif  /* SCHED_TASK_EN */
+
+#endif  /* __SCHED_HPP */
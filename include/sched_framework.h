@@ -1,255 +1,585 @@
-/*******************************************************************************
-* 文 件 名: sched_framework.h
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-26
-* 文件说明: 定义事件驱动调度器的核心框架
-*******************************************************************************/
-
-#ifndef __SCHED_FRAMEWORK_H
-#define __SCHED_FRAMEWORK_H
-
-#include "sched_port.h"
-#include "sched_internal.h"
-
-/*******************************************************************************
-
-                                    调度核心
-
-*******************************************************************************/
-/* 全局变量 ------------------------------------------------------------------*/
-/*调度器核心当前状态*/
-extern SchedStatus_t framework_CoreStatus;
-
-/* 操作函数 ------------------------------------------------------------------*/
-/*调度器初始化*/
-void framework_CoreInit(void);
-/*启动调度器*/
-void framework_CoreStart(void);
-
-/* 内部函数 ------------------------------------------------------------------*/
-/*
-    向时间管理器添加延时对象
-    确保添加的延时对象链表项是孤立的!
-    若延时时间为0,则不执行任何操作
-*/
-void __framework_CoreTimeManagerAddDelay(SchedList_t *pListItem, SchedTick_t delay);
-/*
-    更新时间管理器,用于优化节拍中断执行效率
-    当对象链表项可能从延时链表中删除时,建议调用本函数
-*/
-void __framework_CoreTimeManagerUpdate(void);
-
-#if SCHED_TASK_EN
-/*******************************************************************************
-
-                                     状态机
-
-*******************************************************************************/
-/* 全局变量 ------------------------------------------------------------------*/
-/*状态机内部事件*/
-extern const SchedEvent_t internal_event[4];
-
-/* 数据结构 ------------------------------------------------------------------*/
-typedef struct sched_fsm SchedFSM_t;
-struct sched_fsm
-{
-    SchedStateFunction_t    state;  /*有限状态机当前状态*/
-};
-
-/* 操作函数 ------------------------------------------------------------------*/
-/*构造状态机*/
-void framework_FSM_Ctor(SchedFSM_t *fsm, SchedStateFunction_t initial);
-/*初始化状态机*/
-void framework_FSM_Init(SchedFSM_t *fsm);
-/*状态机处理事件*/
-void framework_FSM_Dispatch(SchedFSM_t *fsm, SchedEvent_t const *e);
-
-/*******************************************************************************
-
-                                    任务管理
-
-*******************************************************************************/
-/* 数据结构 ------------------------------------------------------------------*/
-typedef struct sched_task SchedTask_t;
-struct sched_task
-{
-    SchedFSM_t              fsm;            /*有限状态机,偏移量必须为0  */
-#if SCHED_TASK_EVENT_METHOD == 0            /*使用优先级记录表记录事件  */
-    SchedPrioTable_t        sigtbl;         /*记录事件的优先级记录表    */
-#else                                       /*使用消息队列记录事件      */
-    SchedQueue_t            queue;          /*记录事件的消息队列        */
-#endif
-
-    uint8_t                 prio;           /*任务优先级,0为最高优先级  */
-
-#if SCHED_TASK_CYCLE_EN
-    uint8_t     volatile    cycleFlag;      /*周期循环信号触发标志      */
-    SchedTick_t             cyclePeriod;    /*周期循环信号产生的周期    */
-    SchedTick_t volatile    cycleTick;      /*周期循环信号节拍计数      */
-    SchedList_t             cycleListItem;  /*周期循环信号对象管理链表项*/
-#endif
-};
-
-/* 操作函数 ------------------------------------------------------------------*/
-/*任务管理环境初始化*/
-void framework_TaskEnvirInit(void);
-/*创建新任务*/
-SchedTask_t *framework_TaskCreate(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial);
-
-#if SCHED_TASK_CYCLE_EN
-/*
-    设置任务周期循环信号产生的周期,
-    周期为0表示不产生周期循环信号,
-    复位周期循环信号节拍计数,
-    可以选择是否立即产生信号(节拍0对应的信号)
-*/
-void framework_TaskSetCyclePeriod(SchedTask_t *task, SchedTick_t period, SchedBool_t immedTRIG);
-/*获取周期循环信号节拍计数*/
-SchedTick_t framework_TaskGetCycleTick(SchedTask_t *task);
-#endif
-
-/*初始化所有任务*/
-void framework_TaskInitialiseAll(void);
-/*
-    任务调度函数,
-    返回SCHED_TRUE表示完成一次任务调度,
-    返回SCHED_FALSE表示没有就绪任务,进行了一次空操作
-*/
-SchedBool_t framework_TaskExecute(void);
-
-/* 内部函数 ------------------------------------------------------------------*/
-/*记录就绪任务*/
-void __framework_TaskRecordReadyTask(SchedTask_t const *task);
-/*清除就绪任务*/
-void __framework_TaskResetReadyTask(SchedTask_t const *task);
-
-#if SCHED_TASK_CYCLE_EN
-/*
-    时间管理器的延时对象到时回调函数,
-    返回0表示时间管理器无进一步动作,
-    返回非0表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
-*/
-SchedTick_t __framework_TaskTimeArrivalHandler(SchedList_t *pArrivalListItem);
-#endif
-
-/*******************************************************************************
-
-                                    事件管理
-
-*******************************************************************************/
-/* 操作函数 ------------------------------------------------------------------*/
-/*向指定任务发送事件块*/
-SchedStatus_t framework_EventSend(SchedTask_t *task, SchedEvent_t const *evt);
-/*向指定任务发送紧急事件块*/
-SchedStatus_t framework_EventSendFront(SchedTask_t *task, SchedEvent_t const *evt);
-
-/*在中断函数中向指定任务发送事件块*/
-SchedStatus_t framework_EventSendFromISR(SchedTask_t *task, SchedEvent_t const *evt);
-/*在中断函数中向指定任务发送紧急事件块*/
-SchedStatus_t framework_EventSendFrontFromISR(SchedTask_t *task, SchedEvent_t const *evt);
-
-/* 内部函数 ------------------------------------------------------------------*/
-/*尝试接收指定任务的事件块(实际上没有接收)*/
-SchedStatus_t __framework_EventTryReceive(SchedTask_t *task);
-/*接收指定任务的事件块*/
-SchedStatus_t __framework_EventReceive(SchedTask_t *task, SchedEvent_t *evt);
-
-#if SCHED_TASK_ALARM_EN
-/*******************************************************************************
-
-                                    闹钟管理
-
-*******************************************************************************/
-/* 数据结构 ------------------------------------------------------------------*/
-typedef struct sched_alarm SchedAlarm_t;
-struct sched_alarm
-{
-    SchedTask_t            *task;           /*闹钟所属任务指针  */
-    SchedEvent_t            event;          /*闹钟到时事件      */
-    SchedList_t             alarmListItem;  /*闹钟对象管理链表项*/
-    uint8_t      volatile   flag;           /*闹钟到时标志      */
-};
-
-/* 操作函数 ------------------------------------------------------------------*/
-/*创建新闹钟*/
-SchedAlarm_t *framework_AlarmCreate(SchedTask_t *task, SchedEvent_t const *evt);
-
-/*设置闹钟事件*/
-void framework_AlarmSetEvent(SchedAlarm_t *alarm, SchedEvent_t const *evt);
-/*取消闹钟响应*/
-void framework_AlarmCancel(SchedAlarm_t *alarm);
-/*设置并重启闹钟*/
-void framework_AlarmSet(SchedAlarm_t *alarm, SchedTick_t period);
-/*获取闹钟状态*/
-SchedStatus_t framework_AlarmGetStatus(SchedAlarm_t *alarm);
-
-/* 内部函数 ------------------------------------------------------------------*/
-/*
-    时间管理器的延时对象到时回调函数,
-    返回0表示时间管理器无进一步动作,
-    返回非0表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
-*/
-SchedTick_t __framework_AlarmTimeArrivalHandler(SchedList_t *pArrivalListItem);
-
-#endif  /* SCHED_TASK_ALARM_EN */
-
-#endif  /* SCHED_TASK_EN */
-
-#if SCHED_DAEMON_EN
-/*******************************************************************************
-
-                                  守护任务管理
-
-*******************************************************************************/
-/* 数据结构 ------------------------------------------------------------------*/
-typedef struct sched_daemon SchedDaemon_t;
-struct sched_daemon
-{
-    SchedDaemonFunction_t   daemonFunc;     /*守护任务处理函数*/
-    SchedEvent_t            event;          /*守护任务响应事件*/
-    SchedList_t             daemonListItem; /*对象管理链表项  */
-};
-
-/* 操作函数 ------------------------------------------------------------------*/
-/*守护任务管理环境初始化*/
-void framework_DaemonEnvirInit(void);
-/*创建新守护任务*/
-SchedDaemon_t *framework_DaemonCreate(SchedDaemonFunction_t daemonFunc);
-
-/*
-    唤醒守护任务并执行给定的事件,
-    当守护任务处于休眠状态(SCHED_DAEMON_DORMANT)或者运行状态(SCHED_DAEMON_RUNNING)时,允许唤醒守护任务
-*/
-SchedStatus_t framework_DaemonCall(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay);
-/*终止指定的守护任务*/
-void framework_DaemonAbort(SchedDaemon_t *daemon);
-/*获取指定守护任务的状态*/
-SchedStatus_t framework_DaemonGetStatus(SchedDaemon_t *daemon);
-
-/*
-    在中断函数中唤醒守护任务并执行给定的事件,
-    仅当守护任务处于休眠状态(SCHED_DAEMON_DORMANT), 允许在中断中唤醒守护任务
-*/
-SchedStatus_t framework_DaemonCallFromISR(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay);
-/*在中断函数中获取指定守护任务的状态*/
-SchedStatus_t framework_DaemonGetStatusFromISR(SchedDaemon_t *daemon);
-
-/*
-    守护任务调度函数,
-    返回SCHED_TRUE表示完成一次任务调度,
-    返回SCHED_FALSE表示没有就绪任务,进行了一次空操作
-*/
-SchedBool_t framework_DaemonExecute(void);
-
-/* 内部函数 ------------------------------------------------------------------*/
-/*
-    时间管理器的延时对象到时回调函数,
-    返回0表示时间管理器无进一步动作,
-    返回非0表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
-*/
-SchedTick_t __framework_DaemonTimeArrivalHandler(SchedList_t *pArrivalListItem);
-
-#endif  /* SCHED_DAEMON_EN */
-
-#endif  /* __SCHED_FRAMEWORK_H */
+/*******************************************************************************
+* 文 件 名: sched_framework.h
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-26
+* 文件说明: 定义事件驱动调度器的核心框架
+*******************************************************************************/
+
+#ifndef __SCHED_FRAMEWORK_H
+#define __SCHED_FRAMEWORK_H
+
+#include "sched_port.h"
+#include "sched_internal.h"
+
+/* 配置检查 ------------------------------------------------------------------*/
+#if (SCHED_SIGMASK_METHOD == 2) && (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_TASK_DEFER_EN
+    #error "SCHED_SIGMASK_METHOD == 2 requires SCHED_TASK_DEFER_EN"
+#endif
+#if SCHED_DAEMON_EN && SCHED_DAEMON_QUEUE_EN && !(SCHED_TASK_EN && SCHED_TIMER_EVENT_EN)
+    /*调用队列模式下延时调用由定时节点实现*/
+    #error "SCHED_DAEMON_QUEUE_EN requires SCHED_TASK_EN and SCHED_TIMER_EVENT_EN"
+#endif
+
+/*******************************************************************************
+
+                                    调度核心
+
+*******************************************************************************/
+/* 全局变量 ------------------------------------------------------------------*/
+/*调度器核心当前状态*/
+extern SchedStatus_t framework_CoreStatus;
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*调度器初始化*/
+void framework_CoreInit(void);
+/*启动调度器*/
+void framework_CoreStart(void);
+/*获取调度器节拍计数*/
+SchedTick_t framework_CoreGetTick(void);
+
+/* 内部函数 ------------------------------------------------------------------*/
+/*
+    向时间管理器添加延时对象
+    确保添加的延时对象链表项是孤立的!
+    若延时时间为0,则不执行任何操作
+*/
+void __framework_CoreTimeManagerAddDelay(SchedList_t *pListItem, SchedTick_t delay);
+/*
+    更新时间管理器,用于优化节拍中断执行效率
+    当对象链表项可能从延时链表中删除时,建议调用本函数
+*/
+void __framework_CoreTimeManagerUpdate(void);
+
+#if SCHED_TASK_EN
+/*******************************************************************************
+
+                                     状态机
+
+*******************************************************************************/
+/* 全局变量 ------------------------------------------------------------------*/
+/*状态机内部事件*/
+extern const SchedEvent_t internal_event[SCHED_SIG_USER];
+
+/* 数据结构 ------------------------------------------------------------------*/
+typedef struct sched_fsm SchedFSM_t;
+struct sched_fsm
+{
+    SchedStateFunction_t    state;  /*有限状态机当前状态*/
+#if SCHED_SIGMASK_METHOD
+    SchedSigMask_t          sigMask;/*当前状态接收的用户信号屏蔽字*/
+#endif
+#if SCHED_FSM_TABLE_EN
+    SchedFsmTable_t const  *table;  /*状态转移表, NULL表示使用状态函数*/
+    SchedFsmCell_t const   *row;    /*当前状态在状态转移表中对应的行*/
+#endif
+#if SCHED_FSM_TRACE_EN
+    SchedTimestamp_t        enterStamp; /*进入当前状态的时间戳*/
+#endif
+};
+
+#if SCHED_FSM_HSM_EN
+/*层次状态机转移路径, 退出路径由源状态向上排列, 进入路径由目标状态向上排列*/
+typedef struct sched_hsm_path SchedHsmPath_t;
+struct sched_hsm_path
+{
+    SchedStateFunction_t    source;                         /*转移源状态    */
+    SchedStateFunction_t    target;                         /*转移目标状态  */
+    uint8_t                 nExit;                          /*退出状态数量  */
+    uint8_t                 nEntry;                         /*进入状态数量  */
+    SchedStateFunction_t    exit[SCHED_HSM_MAX_DEPTH];      /*依次退出的状态*/
+    SchedStateFunction_t    entry[SCHED_HSM_MAX_DEPTH];     /*逆序进入的状态*/
+};
+#endif
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*构造状态机*/
+void framework_FSM_Ctor(SchedFSM_t *fsm, SchedStateFunction_t initial);
+/*初始化状态机*/
+void framework_FSM_Init(SchedFSM_t *fsm);
+/*状态机处理事件, 返回是否发生状态转移*/
+SchedBool_t framework_FSM_Dispatch(SchedFSM_t *fsm, SchedEvent_t const *e);
+#if SCHED_FSM_TABLE_EN
+/*使用状态转移表构造状态机*/
+void framework_FSM_CtorTable(SchedFSM_t *fsm, SchedFsmTable_t const *table);
+/*获取状态转移表状态机的当前状态*/
+uint8_t framework_FSM_GetTableState(SchedFSM_t const *fsm);
+#endif
+#if SCHED_SIGMASK_METHOD
+/*判断状态机当前状态是否接收指定信号*/
+SchedBool_t framework_FSM_IsAccepted(SchedFSM_t const *fsm, EvtSig_t sig);
+#endif
+
+#if SCHED_FSM_TRACE_EN
+/*******************************************************************************
+
+                                  状态转移跟踪
+
+*******************************************************************************/
+/* 常量定义 ------------------------------------------------------------------*/
+/*跟踪缓冲区标识, 便于主机工具在内存转储中定位跟踪缓冲区("STRC")*/
+#define SCHED_TRACE_MAGIC           ( (uint32_t)0x43525453 )
+
+/* 数据结构 ------------------------------------------------------------------*/
+typedef struct sched_trace SchedTrace_t;
+struct sched_trace
+{
+    uint32_t                magic;      /*跟踪缓冲区标识SCHED_TRACE_MAGIC   */
+    uint16_t                recordLen;  /*跟踪记录环形缓冲区长度            */
+    uint16_t                stateNum;   /*驻留时间统计项数量                */
+    uint16_t                head;       /*下一条跟踪记录的写入位置          */
+    uint16_t                count;      /*有效跟踪记录数量                  */
+    uint16_t                nState;     /*已使用的驻留时间统计项数量        */
+    uint16_t                nLost;      /*统计项用完后未能统计的状态离开次数*/
+    uint32_t                total;      /*状态转移总次数                    */
+    SchedTraceRecord_t      record[SCHED_TRACE_LEN];        /*跟踪记录环形缓冲区*/
+    SchedTraceResidency_t   residency[SCHED_TRACE_STATE_NUM];/*驻留时间统计项 */
+};
+
+/* 全局变量 ------------------------------------------------------------------*/
+/*状态转移跟踪缓冲区, 布局固定, 主机工具可以通过调试接口直接读取*/
+extern SchedTrace_t framework_Trace;
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*状态转移跟踪环境初始化*/
+void framework_TraceEnvirInit(void);
+/*清除跟踪记录和驻留时间统计*/
+void framework_TraceReset(void);
+/*按时间顺序读取跟踪记录, 返回读取的记录数量*/
+uint16_t framework_TraceRead(SchedTraceRecord_t *buf, uint16_t max);
+/*读取驻留时间统计, 返回读取的统计项数量*/
+uint16_t framework_TraceGetResidency(SchedTraceResidency_t *buf, uint16_t max);
+
+/* 内部函数 ------------------------------------------------------------------*/
+/*
+    记录一次状态转移, 并累计原状态的驻留时间,
+    原状态为SCHED_TRACE_NO_STATE表示初始转移, 只开始计时
+*/
+void __framework_TraceTransition(SchedFSM_t *fsm, SchedTraceState_t from, SchedTraceState_t to, EvtSig_t sig);
+#endif  /* SCHED_FSM_TRACE_EN */
+
+/*******************************************************************************
+
+                                    任务管理
+
+*******************************************************************************/
+/* 常量定义 ------------------------------------------------------------------*/
+/*普通事件使用的消息队列通道(最低优先级通道), 通道0为最高优先级通道*/
+#define SCHED_TASK_NORMAL_LANE      ( SCHED_TASK_QUEUE_LANES-1 )
+
+/*是否存在任务冷数据*/
+#define SCHED_TASK_COLD_EN          ( (SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)) \
+                                   || SCHED_TASK_CYCLE_EN )
+
+/* 数据结构 ------------------------------------------------------------------*/
+#if SCHED_TASK_COLD_EN
+/*任务冷数据, 只在设置、统计和节拍处理时访问, 使能SCHED_TASK_TABLE_EN时与任务控制块分开存放*/
+typedef struct sched_task_cold SchedTaskCold_t;
+struct sched_task_cold
+{
+#if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+    SchedTimestamp_t        eventTTL;       /*事件有效期,0表示永久有效  */
+    uint32_t                nExpired;       /*超过有效期被丢弃的事件数量*/
+#if SCHED_LATENCY_STAT_EN
+    uint32_t                latHist[SCHED_LATENCY_BINS];    /*排队延时直方图*/
+    SchedTimestamp_t        latMax;         /*最大排队延时              */
+#endif
+#endif
+
+#if SCHED_TASK_CYCLE_EN
+    SchedTick_t             cyclePeriod;    /*周期循环信号产生的周期    */
+    SchedTick_t volatile    cycleTick;      /*周期循环信号节拍计数      */
+    SchedList_t             cycleListItem;  /*周期循环信号对象管理链表项*/
+#endif
+};
+#endif
+
+typedef struct sched_task SchedTask_t;
+struct sched_task
+{
+    SchedFSM_t              fsm;            /*有限状态机,偏移量必须为0  */
+#if (SCHED_TASK_EVENT_METHOD == 0) && SCHED_SIGTBL_EXT_EN
+    SchedSigTable_t         sigtbl;         /*记录事件的多级信号记录表  */
+    EvtMsg_t                sigmsg[SCHED_SIGTBL_SIG_NUM];   /*各信号最新的消息*/
+#elif SCHED_TASK_EVENT_METHOD == 0          /*使用优先级记录表记录事件  */
+    SchedPrioTable_t        sigtbl;         /*记录事件的优先级记录表    */
+#else                                       /*使用消息队列记录事件      */
+    SchedQueue_t            queue[SCHED_TASK_QUEUE_LANES];  /*各优先级通道的消息队列*/
+#if SCHED_TASK_QUEUE_LANES > 1
+    SchedPrioTable_t        laneTable;      /*非空消息队列通道记录表    */
+#endif
+#if SCHED_TASK_DEFER_EN
+    SchedQueue_t            deferQueue;     /*保存延迟事件的延迟队列    */
+#endif
+#endif
+
+    uint8_t                 prio;           /*任务优先级,0为最高优先级  */
+#if SCHED_TASK_CYCLE_EN
+    uint8_t     volatile    cycleFlag;      /*周期循环信号触发标志      */
+#endif
+
+#if SCHED_TASK_COLD_EN && !SCHED_TASK_TABLE_EN
+    SchedTaskCold_t         cold;           /*任务冷数据                */
+#endif
+};
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*任务管理环境初始化*/
+void framework_TaskEnvirInit(void);
+#if SCHED_DYNAMIC_ALLOC_EN
+/*创建新任务*/
+SchedTask_t *framework_TaskCreate(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial);
+#if SCHED_FSM_TABLE_EN
+/*创建使用状态转移表的新任务*/
+SchedTask_t *framework_TaskCreateTable(uint8_t prio, EvtPos_t queueLen, SchedFsmTable_t const *table);
+#endif
+#endif
+#if SCHED_STATIC_ALLOC_EN
+/*使用调用者提供的存储空间创建新任务*/
+SchedTask_t *framework_TaskCreateStatic(uint8_t prio, EvtPos_t queueLen, SchedStateFunction_t initial,
+                                        SchedTask_t *taskBuf, SchedEvent_t *queueBuf);
+#if SCHED_FSM_TABLE_EN
+/*使用调用者提供的存储空间创建使用状态转移表的新任务*/
+SchedTask_t *framework_TaskCreateTableStatic(uint8_t prio, EvtPos_t queueLen, SchedFsmTable_t const *table,
+                                             SchedTask_t *taskBuf, SchedEvent_t *queueBuf);
+#endif
+#endif
+
+#if SCHED_TASK_CYCLE_EN
+/*
+    设置任务周期循环信号产生的周期,
+    周期为0表示不产生周期循环信号,
+    复位周期循环信号节拍计数,
+    可以选择是否立即产生信号(节拍0对应的信号)
+*/
+void framework_TaskSetCyclePeriod(SchedTask_t *task, SchedTick_t period, SchedBool_t immedTRIG);
+/*获取周期循环信号节拍计数*/
+SchedTick_t framework_TaskGetCycleTick(SchedTask_t *task);
+#endif
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_QUEUE_POLICY_EN
+/*设置任务消息队列溢出策略, 仅允许在调度器启动前设置*/
+void framework_TaskSetOverflowPolicy(SchedTask_t *task, uint8_t policy);
+/*获取任务消息队列丢弃计数*/
+uint32_t framework_TaskGetDropCount(SchedTask_t *task);
+#endif
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_POOL_EN
+/*获取共享事件节点池空闲节点最小量*/
+EvtPos_t framework_EventPoolGetMinFree(void);
+#endif
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_EVENT_CONFLATE_EN
+/*设置任务的指定信号是否合并*/
+void framework_TaskSetConflate(SchedTask_t *task, EvtSig_t sig, SchedBool_t enable);
+#endif
+#if SCHED_EVENT_TIMESTAMP_EN && (SCHED_TASK_EVENT_METHOD >= 1)
+/*设置任务事件有效期*/
+void framework_TaskSetEventTTL(SchedTask_t *task, SchedTimestamp_t ttl);
+/*获取任务超过有效期被丢弃的事件数量*/
+uint32_t framework_TaskGetExpiredCount(SchedTask_t *task);
+#if SCHED_LATENCY_STAT_EN
+/*获取任务排队延时直方图的指定分档计数*/
+uint32_t framework_TaskGetLatencyCount(SchedTask_t *task, uint8_t bin);
+/*获取任务最大排队延时*/
+SchedTimestamp_t framework_TaskGetLatencyMax(SchedTask_t *task);
+#endif
+#endif
+#if SCHED_SIGMASK_METHOD
+/*设置任务当前状态接收的用户信号屏蔽字*/
+void framework_TaskSetSigMask(SchedTask_t *task, SchedSigMask_t mask);
+#endif
+
+/*初始化所有任务*/
+void framework_TaskInitialiseAll(void);
+/*
+    任务调度函数,
+    返回SCHED_TRUE表示完成一次任务调度,
+    返回SCHED_FALSE表示没有就绪任务,进行了一次空操作
+*/
+SchedBool_t framework_TaskExecute(void);
+
+/* 内部函数 ------------------------------------------------------------------*/
+/*记录就绪任务*/
+void __framework_TaskRecordReadyTask(SchedTask_t const *task);
+/*清除就绪任务*/
+void __framework_TaskResetReadyTask(SchedTask_t const *task);
+
+#if SCHED_TASK_CYCLE_EN
+/*
+    时间管理器的延时对象到时回调函数,
+    返回0表示时间管理器无进一步动作,
+    返回非0表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
+*/
+SchedTick_t __framework_TaskTimeArrivalHandler(SchedList_t *pArrivalListItem);
+#endif
+
+/*******************************************************************************
+
+                                    事件管理
+
+*******************************************************************************/
+/* 操作函数 ------------------------------------------------------------------*/
+/*向指定任务发送事件块*/
+SchedStatus_t framework_EventSend(SchedTask_t *task, SchedEvent_t const *evt);
+/*向指定任务发送紧急事件块*/
+SchedStatus_t framework_EventSendFront(SchedTask_t *task, SchedEvent_t const *evt);
+
+/*在中断函数中向指定任务发送事件块*/
+SchedStatus_t framework_EventSendFromISR(SchedTask_t *task, SchedEvent_t const *evt);
+/*在中断函数中向指定任务发送紧急事件块*/
+SchedStatus_t framework_EventSendFrontFromISR(SchedTask_t *task, SchedEvent_t const *evt);
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && (SCHED_TASK_QUEUE_LANES > 1)
+/*向指定任务消息队列的指定通道发送事件块*/
+SchedStatus_t framework_EventSendLane(SchedTask_t *task, uint8_t lane, SchedEvent_t const *evt);
+/*在中断函数中向指定任务消息队列的指定通道发送事件块*/
+SchedStatus_t framework_EventSendLaneFromISR(SchedTask_t *task, uint8_t lane, SchedEvent_t const *evt);
+#endif
+
+#if (SCHED_TASK_EVENT_METHOD >= 1) && SCHED_TASK_DEFER_EN
+/*将事件块保存到指定任务的延迟队列*/
+SchedStatus_t framework_EventDefer(SchedTask_t *task, SchedEvent_t const *evt);
+/*将指定任务延迟队列中的事件块召回到消息队列头部*/
+EvtPos_t framework_EventRecall(SchedTask_t *task);
+#if SCHED_QUEUE_POLICY_EN
+/*获取指定任务延迟队列的丢弃计数*/
+uint32_t framework_EventDeferGetDropCount(SchedTask_t *task);
+#endif
+#endif
+
+/* 内部函数 ------------------------------------------------------------------*/
+/*尝试接收指定任务的事件块(实际上没有接收)*/
+SchedStatus_t __framework_EventTryReceive(SchedTask_t *task);
+/*接收指定任务的事件块*/
+SchedStatus_t __framework_EventReceive(SchedTask_t *task, SchedEvent_t *evt);
+
+#if SCHED_TASK_ALARM_EN
+/*******************************************************************************
+
+                                    闹钟管理
+
+*******************************************************************************/
+/* 数据结构 ------------------------------------------------------------------*/
+typedef struct sched_alarm SchedAlarm_t;
+struct sched_alarm
+{
+    SchedTask_t            *task;           /*闹钟所属任务指针  */
+    SchedEvent_t            event;          /*闹钟到时事件      */
+    SchedList_t             alarmListItem;  /*闹钟对象管理链表项*/
+    uint8_t      volatile   flag;           /*闹钟到时标志      */
+};
+
+/* 操作函数 ------------------------------------------------------------------*/
+#if SCHED_DYNAMIC_ALLOC_EN
+/*创建新闹钟*/
+SchedAlarm_t *framework_AlarmCreate(SchedTask_t *task, SchedEvent_t const *evt);
+#endif
+/*使用调用者提供的存储空间创建新闹钟*/
+SchedAlarm_t *framework_AlarmCreateStatic(SchedTask_t *task, SchedEvent_t const *evt, SchedAlarm_t *alarmBuf);
+
+/*设置闹钟事件*/
+void framework_AlarmSetEvent(SchedAlarm_t *alarm, SchedEvent_t const *evt);
+/*取消闹钟响应*/
+void framework_AlarmCancel(SchedAlarm_t *alarm);
+/*设置并重启闹钟*/
+void framework_AlarmSet(SchedAlarm_t *alarm, SchedTick_t period);
+/*获取闹钟状态*/
+SchedStatus_t framework_AlarmGetStatus(SchedAlarm_t *alarm);
+
+/* 内部函数 ------------------------------------------------------------------*/
+/*
+    时间管理器的延时对象到时回调函数,
+    返回0表示时间管理器无进一步动作,
+    返回非0表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
+*/
+SchedTick_t __framework_AlarmTimeArrivalHandler(SchedList_t *pArrivalListItem);
+
+#endif  /* SCHED_TASK_ALARM_EN */
+
+#if SCHED_TIMER_EVENT_EN
+/*******************************************************************************
+
+                                  延时事件管理
+
+*******************************************************************************/
+/* 数据结构 ------------------------------------------------------------------*/
+typedef struct sched_timer SchedTimer_t;
+struct sched_timer
+{
+    SchedTask_t            *task;           /*延时事件目标任务指针  */
+#if SCHED_DAEMON_EN && SCHED_DAEMON_QUEUE_EN
+    struct sched_daemon    *daemon;         /*延时调用目标守护任务指针, task为NULL时有效*/
+#endif
+    SchedEvent_t            event;          /*延时到时发送的事件    */
+    SchedList_t             timerListItem;  /*定时节点对象管理链表项*/
+};
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*延时事件管理环境初始化*/
+void framework_TimerEnvirInit(void);
+/*延时向指定任务发送事件块*/
+SchedStatus_t framework_EventSendDelayed(SchedTask_t *task, SchedEvent_t const *evt, SchedTick_t delay);
+/*在中断函数中延时向指定任务发送事件块*/
+SchedStatus_t framework_EventSendDelayedFromISR(SchedTask_t *task, SchedEvent_t const *evt, SchedTick_t delay);
+/*获取定时节点池空闲节点最小量*/
+uint16_t framework_TimerGetMinFree(void);
+
+/* 内部函数 ------------------------------------------------------------------*/
+/*
+    时间管理器的延时对象到时回调函数,
+    返回0表示时间管理器无进一步动作,
+    返回非0表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
+*/
+SchedTick_t __framework_TimerTimeArrivalHandler(SchedList_t *pArrivalListItem);
+#if SCHED_DAEMON_EN && SCHED_DAEMON_QUEUE_EN
+/*
+    分配定时节点延时调用守护任务, 到时将事件加入守护任务调用队列,
+    调用前需进入临界区
+*/
+SchedStatus_t __framework_TimerDaemonCall(struct sched_daemon *daemon, SchedEvent_t const *evt, SchedTick_t delay);
+#endif
+
+#endif  /* SCHED_TIMER_EVENT_EN */
+
+#endif  /* SCHED_TASK_EN */
+
+#if SCHED_DAEMON_EN
+/*******************************************************************************
+
+                                  守护任务管理
+
+*******************************************************************************/
+/* 数据结构 ------------------------------------------------------------------*/
+#if SCHED_DAEMON_OFFLOAD_EN
+/*守护任务卸载状态*/
+enum {
+    SCHED_OFFLOAD_IDLE = 0, /*没有作业在工作线程中执行*/
+    SCHED_OFFLOAD_BUSY,     /*作业正在工作线程中执行*/
+    SCHED_OFFLOAD_PENDING,  /*作业执行期间守护任务再次就绪, 作业完成后就绪*/
+};
+#endif
+
+typedef struct sched_daemon SchedDaemon_t;
+struct sched_daemon
+{
+    SchedDaemonFunction_t   daemonFunc;     /*守护任务处理函数*/
+#if SCHED_DAEMON_QUEUE_EN
+    SchedQueue_t            queue;          /*守护任务调用队列*/
+#if SCHED_EVENT_POOL_EN
+    SchedEventPool_t        pool;           /*调用队列专用事件节点池*/
+#endif
+#else
+    SchedEvent_t            event;          /*守护任务响应事件*/
+#endif
+    SchedList_t             daemonListItem; /*对象管理链表项  */
+#if SCHED_DAEMON_PRIO_EN
+    uint8_t                 prio;           /*守护任务优先级,0为最高优先级*/
+#endif
+#if SCHED_DAEMON_CYCLE_EN
+    SchedTick_t             cyclePeriod;    /*周期调用的周期,0表示不周期调用*/
+    SchedList_t             cycleListItem;  /*周期调用对象管理链表项*/
+#endif
+#if SCHED_DAEMON_OFFLOAD_EN
+    SchedOffloadFunction_t  offloadFunc;    /*卸载到工作线程的函数,NULL表示不卸载*/
+    SchedTaskHandle_t       doneTask;       /*接收完成事件的任务,NULL表示不发送*/
+    EvtSig_t                doneSig;        /*完成事件信号*/
+    uint8_t                 offloadState;   /*卸载状态*/
+    SchedWorkerJob_t        job;            /*工作线程作业*/
+    SchedEvent_t            jobEvent;       /*作业处理的事件*/
+    EvtMsg_t                jobResult;      /*作业结果,作为完成事件的消息*/
+#endif
+#if SCHED_DAEMON_CO_EN
+    uint16_t                coLine;         /*协程断点行号,0表示从头执行*/
+#if SCHED_DAEMON_QUEUE_EN
+    SchedBool_t             coResume;       /*协程从让出点恢复执行标志*/
+    SchedEvent_t            coEvent;        /*协程当前处理的事件*/
+#endif
+#endif
+};
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*守护任务管理环境初始化*/
+void framework_DaemonEnvirInit(void);
+#if SCHED_DYNAMIC_ALLOC_EN
+/*创建新守护任务*/
+SchedDaemon_t *framework_DaemonCreate(SchedDaemonFunction_t daemonFunc);
+#if SCHED_DAEMON_PRIO_EN
+/*创建指定优先级的新守护任务*/
+SchedDaemon_t *framework_DaemonCreatePrio(SchedDaemonFunction_t daemonFunc, uint8_t prio);
+#endif
+#endif
+#if SCHED_STATIC_ALLOC_EN
+/*使用调用者提供的存储空间创建新守护任务*/
+SchedDaemon_t *framework_DaemonCreateStatic(SchedDaemonFunction_t daemonFunc,
+                                            SchedDaemon_t *daemonBuf, SchedDaemonQueueItem_t *queueBuf);
+#if SCHED_DAEMON_PRIO_EN
+/*使用调用者提供的存储空间创建指定优先级的新守护任务*/
+SchedDaemon_t *framework_DaemonCreatePrioStatic(SchedDaemonFunction_t daemonFunc, uint8_t prio,
+                                                SchedDaemon_t *daemonBuf, SchedDaemonQueueItem_t *queueBuf);
+#endif
+#endif
+#if SCHED_DAEMON_OFFLOAD_EN && SCHED_DYNAMIC_ALLOC_EN
+/*创建卸载到工作线程执行的新守护任务*/
+SchedDaemon_t *framework_DaemonCreateOffload(SchedOffloadFunction_t offloadFunc, SchedTaskHandle_t task, EvtSig_t doneSig);
+#endif
+
+/*
+    唤醒守护任务并执行给定的事件,
+    当守护任务处于休眠状态(SCHED_DAEMON_DORMANT)或者运行状态(SCHED_DAEMON_RUNNING)时,允许唤醒守护任务,
+    若使能调用队列, 调用队列未满即允许唤醒
+*/
+SchedStatus_t framework_DaemonCall(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay);
+/*终止指定的守护任务*/
+void framework_DaemonAbort(SchedDaemon_t *daemon);
+/*获取指定守护任务的状态*/
+SchedStatus_t framework_DaemonGetStatus(SchedDaemon_t *daemon);
+
+/*
+    在中断函数中唤醒守护任务并执行给定的事件,
+    仅当守护任务处于休眠状态(SCHED_DAEMON_DORMANT), 允许在中断中唤醒守护任务,
+    若使能调用队列, 调用队列未满即允许唤醒
+*/
+SchedStatus_t framework_DaemonCallFromISR(SchedDaemon_t *daemon, SchedEvent_t const *evt, SchedTick_t delay);
+/*在中断函数中获取指定守护任务的状态*/
+SchedStatus_t framework_DaemonGetStatusFromISR(SchedDaemon_t *daemon);
+
+#if SCHED_DAEMON_CYCLE_EN
+/*设置守护任务周期调用的周期*/
+void framework_DaemonSetCyclePeriod(SchedDaemon_t *daemon, SchedTick_t period, SchedBool_t immedTRIG);
+#endif
+
+#if SCHED_DAEMON_CO_EN
+/*获取协程断点行号*/
+uint16_t framework_DaemonCoGetLine(SchedDaemon_t *daemon);
+/*设置协程断点行号, 守护任务返回后休眠, 直到下次被调用*/
+void framework_DaemonCoSetLine(SchedDaemon_t *daemon, uint16_t line);
+/*设置协程断点行号并让出, 延时为0时立即重新就绪, 否则延时后重新就绪*/
+void framework_DaemonCoYield(SchedDaemon_t *daemon, uint16_t line, SchedTick_t delay);
+#endif
+
+/*
+    守护任务调度函数,
+    返回SCHED_TRUE表示完成一次任务调度,
+    返回SCHED_FALSE表示没有就绪任务,进行了一次空操作
+*/
+SchedBool_t framework_DaemonExecute(void);
+
+/* 内部函数 ------------------------------------------------------------------*/
+/*
+    时间管理器的延时对象到时回调函数,
+    返回0表示时间管理器无进一步动作,
+    返回非0表示时间管理器将当前对象重新加入延时链表,返回值是延时时间
+*/
+SchedTick_t __framework_DaemonTimeArrivalHandler(SchedList_t *pArrivalListItem);
+#if SCHED_DAEMON_CYCLE_EN
+/*守护任务周期调用到时回调函数, 返回值同上*/
+SchedTick_t __framework_DaemonCycleArrivalHandler(SchedList_t *pArrivalListItem);
+#endif
+#if SCHED_DAEMON_OFFLOAD_EN
+/*处理工作线程已完成的作业, 返回是否处理了作业*/
+SchedBool_t __framework_DaemonOffloadCollect(void);
+#endif
+
+#endif  /* SCHED_DAEMON_EN */
+
+#endif  /* __SCHED_FRAMEWORK_H */
@@ -0,0 +1,147 @@
+/*******************************************************************************
+* 文 件 名: sched_fsm_table.hpp
+* 创 建 者: agent
+* 版    本: V1.0
+* 创建日期: 2026-10-19
+* 文件说明: 事件驱动调度器的C++状态转移表编译期生成器(需要C++14)
+*******************************************************************************/
+
+#ifndef __SCHED_FSM_TABLE_HPP
+#define __SCHED_FSM_TABLE_HPP
+
+/* 头文件 --------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+#include "sched.h"
+}
+
+#if !SCHED_FSM_TABLE_EN
+    #error "sched_fsm_table.hpp requires SCHED_FSM_TABLE_EN"
+#endif
+
+namespace sched {
+
+/*
+    状态转移表编译期生成器, 用法:
+
+    static constexpr auto kBuilder =
+        sched::FsmTableBuilder<S_NUM, SIG_NUM>(S_IDLE)
+            .entry(S_IDLE, &idleEntry)
+            .on   (S_IDLE, SIG_START, &onStart, S_RUN)
+            .stay (S_IDLE, SIG_STOP,  nullptr)
+            .on   (S_RUN,  SIG_STOP,  &onStop,  S_IDLE)
+            .stay (S_RUN,  SIG_START, nullptr);
+    static_assert(kBuilder.complete(), "transition table is incomplete");
+    static constexpr SchedFsmTable_t kTable = kBuilder.table();
+
+    每个状态的每个用户信号必须且只能设置一次, 内部信号(进入/退出/周期循环)可选;
+    complete()检查完整性, 重复设置或目标状态越界同样使complete()为false;
+    ignoreRest()可以出现在链中任意位置, 在complete()时把仍未设置的用户信号
+    视为忽略, 其前后设置的单元照常生效
+*/
+template <std::size_t NStates, std::size_t NSigs>
+class FsmTableBuilder
+{
+    static_assert(NStates > 0 && NStates < SCHED_TABLE_NO_TRAN, "state count out of range");
+    static_assert(NSigs >= SCHED_SIG_USER && NSigs <= 0xFF, "signal count out of range");
+
+public:
+    constexpr explicit FsmTableBuilder(std::uint8_t initial)
+        : cells_{}, set_{}, bad_(initial >= NStates), ignoreRest_(false), initial_(initial)
+    {
+        for (std::size_t i = 0; i < NStates * NSigs; i++)
+        {
+            cells_[i].action = nullptr;
+            cells_[i].target = SCHED_TABLE_NO_TRAN;
+        }
+    }
+
+    /*设置(状态, 信号)单元: 执行动作后转移到目标状态*/
+    constexpr FsmTableBuilder on(std::uint8_t state, EvtSig_t sig,
+                                 SchedTableAction_t action, std::uint8_t target) const
+    {
+        FsmTableBuilder b = *this;
+        b.put(state, sig, action, target);
+        return b;
+    }
+
+    /*设置(状态, 信号)单元: 执行动作, 不转移状态, 动作可以为nullptr*/
+    constexpr FsmTableBuilder stay(std::uint8_t state, EvtSig_t sig, SchedTableAction_t action) const
+    {
+        return on(state, sig, action, SCHED_TABLE_NO_TRAN);
+    }
+
+    /*设置状态的进入动作*/
+    constexpr FsmTableBuilder entry(std::uint8_t state, SchedTableAction_t action) const
+    {
+        return stay(state, SCHED_SIG_ENTRY, action);
+    }
+
+    /*设置状态的退出动作*/
+    constexpr FsmTableBuilder exit(std::uint8_t state, SchedTableAction_t action) const
+    {
+        return stay(state, SCHED_SIG_EXIT, action);
+    }
+
+    /*将生成时仍未设置的用户信号单元显式标记为忽略, 不影响之后的设置*/
+    constexpr FsmTableBuilder ignoreRest() const
+    {
+        FsmTableBuilder b = *this;
+        b.ignoreRest_ = true;
+        return b;
+    }
+
+    /*检查所有状态的所有用户信号是否都已设置(或由ignoreRest()忽略), 且没有重复设置和越界目标*/
+    constexpr bool complete() const
+    {
+        for (std::size_t s = 0; s < NStates; s++)
+        {
+            for (std::size_t sig = SCHED_SIG_USER; sig < NSigs; sig++)
+            {
+                if (!set_[s * NSigs + sig] && !ignoreRest_)
+                {
+                    return false;
+                }
+            }
+        }
+        return !bad_;
+    }
+
+    /*生成供sched_TaskCreateTable()使用的状态转移表, 生成器对象必须为静态存储*/
+    constexpr SchedFsmTable_t table() const
+    {
+        return SchedFsmTable_t{cells_, static_cast<std::uint8_t>(NStates),
+                               static_cast<std::uint8_t>(NSigs), initial_};
+    }
+
+private:
+    constexpr void put(std::uint8_t state, EvtSig_t sig,
+                       SchedTableAction_t action, std::uint8_t target)
+    {
+        if ((state >= NStates) || (sig >= NSigs)
+          ||((target >= NStates) && (target != SCHED_TABLE_NO_TRAN)))
+        {
+            bad_ = true;
+            return;
+        }
+        if (set_[state * NSigs + sig])
+        {
+            bad_ = true;
+        }
+        set_[state * NSigs + sig] = true;
+        cells_[state * NSigs + sig].action = action;
+        cells_[state * NSigs + sig].target = target;
+    }
+
+    SchedFsmCell_t  cells_[NStates * NSigs];
+    bool            set_[NStates * NSigs];
+    bool            bad_;
+    bool            ignoreRest_;
+    std::uint8_t    initial_;
+};
+
+} /* namespace sched */
+
+#endif  /* __SCHED_FSM_TABLE_HPP */
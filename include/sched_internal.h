@@ -1,157 +1,311 @@
-/*******************************************************************************
-* 文 件 名: sched_internal.h
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-25
-* 文件说明: 事件驱动调度器的内部数据结构定义
-*******************************************************************************/
-
-#ifndef __SCHED_INTERNAL_H
-#define __SCHED_INTERNAL_H
-
-#include "sched_port.h"
-
-/*******************************************************************************
-
-                                   结构体相关
-
-*******************************************************************************/
-/*获取结构体成员变量的偏移量*/
-#ifndef offsetof
-    #define offsetof(type,member)   ( (size_t)(&((type *)0)->member) )
-#endif
-
-/*通过结构体成员指针获得结构体指针*/
-#ifndef container_of
-    #define container_of(ptr, type, member) \
-        ( (type *)((char *)(ptr) - offsetof(type, member)) )
-#endif
-
-/*******************************************************************************
-
-                                  对象管理链表
-
-*******************************************************************************/
-/* 数据结构 ------------------------------------------------------------------*/
-typedef struct sched_list SchedList_t;
-struct sched_list
-{
-    SchedList_t        *next;   /*指向链表后一项*/
-    SchedList_t        *prev;   /*指向链表前一项*/
-    SchedTick_t         value;  /*链表排序数值  */
-    SchedBase_t         type;   /*链表所属类型  */
-};
-
-/* 常量定义 ------------------------------------------------------------------*/
-enum {
-    SCHED_LIST_HEAD = 0,    /*链表头类型      */
-    SCHED_LIST_CYCLE,       /*循环信号对象类型*/
-    SCHED_LIST_ALARM,       /*闹钟对象类型    */
-    SCHED_LIST_DAEMON,      /*守护任务对象类型*/
-};
-
-/* 操作宏 --------------------------------------------------------------------*/
-/*
- * 获取包含链表项的结构体指针
- * ptr:    链表项指针
- * type:   包含链表项的结构体类型
- * member: 链表项在结构体中的成员变量名称
- * return: 结构体指针
- */
-#define internal_ListEntry(ptr, type, member)   container_of(ptr, type, member)
-/*
- * 设置链表排序值
- * pList:  链表指针
- * xValue: 设置的排序值
- */
-#define internal_ListSetValue(pList, xValue)    ( (pList)->value = (xValue) )
-/*
- * 获取链表排序值
- * pList:  链表指针
- * return: 链表排序值
- */
-#define internal_ListGetValue(pList)            ( (pList)->value )
-/*
- * 获取链表后一项
- * pList:  链表指针
- * return: 链表后一项指针
- */
-#define internal_ListNext(pList)                ( (pList)->next )
-
-/* 操作函数 ------------------------------------------------------------------*/
-/*初始化链表或者链表项*/
-void internal_ListInit(SchedList_t *pList, SchedBase_t type);
-/*按照排序值从小到大的顺序插入链表项*/
-void internal_ListInsert(SchedList_t *pList, SchedList_t *pListItem);
-/*向链表尾部插入链表项*/
-void internal_ListInsertEnd(SchedList_t *pList, SchedList_t *pListItem);
-/*移除链表项*/
-void internal_ListRemove(SchedList_t *pListItem);
-/*判断链表是否为空或者链表项是否为孤立链表项*/
-SchedBool_t internal_ListIsEmpty(SchedList_t *pList);
-
-/*******************************************************************************
-
-                                  优先级记录表
-
-*******************************************************************************/
-/* 数据结构 ------------------------------------------------------------------*/
-typedef struct sched_priotable SchedPrioTable_t;
-struct sched_priotable
-{
-    uint8_t     tbl[SCHED_PRIOTBL_TABLE_SIZE];
-    uint8_t     grp;
-};
-
-/* 常量定义 ------------------------------------------------------------------*/
-/*优先级记录表允许最低优先级*/
-#define SCHED_PRIOTBL_LOWEST_PRIO   ( 8*SCHED_PRIOTBL_TABLE_SIZE-1 )
-
-/* 操作函数 ------------------------------------------------------------------*/
-/*初始化优先级记录表*/
-void internal_PriotblInit(SchedPrioTable_t *tbl);
-/*在优先级记录表中记录一个优先级*/
-void internal_PriotblRecordPrio(SchedPrioTable_t *tbl, uint8_t prio);
-/*在优先级记录表中清除一个优先级*/
-void internal_PriotblResetPrio(SchedPrioTable_t *tbl, uint8_t prio);
-/*判断优先级记录表是否为空*/
-SchedBool_t internal_PriotblIsEmpty(SchedPrioTable_t const *tbl);
-/*获取优先级记录表中的最高优先级*/
-uint8_t internal_PriotblGetHighestPrio(SchedPrioTable_t const *tbl);
-
-/*******************************************************************************
-
-                                    消息队列
-
-*******************************************************************************/
-/* 数据结构 ------------------------------------------------------------------*/
-typedef struct sched_queue SchedQueue_t;
-struct sched_queue
-{
-    SchedEvent_t       *evtQueue;   /*队列环形Buffer*/
-    EvtPos_t            end;        /*队列总长度    */
-    EvtPos_t            head;       /*队列头部(读)  */
-    EvtPos_t            tail;       /*队列尾部(写)  */
-    EvtPos_t            nUsed;      /*队列已使用量  */
-    EvtPos_t            nMaxUsed;   /*队列最大使用量*/
-};
-
-/* 操作函数 ------------------------------------------------------------------*/
-/*队列初始化*/
-void internal_QueueInit(SchedQueue_t *queue, SchedEvent_t *evtQueue, EvtPos_t len);
-/*向队列尾部插入一个事件块*/
-SchedBool_t internal_QueueSend(SchedQueue_t *queue, SchedEvent_t const *evt);
-/*向队列头部插入一个事件块*/
-SchedBool_t internal_QueueSendFront(SchedQueue_t *queue, SchedEvent_t const *evt);
-/*从队列头部取出一个事件块*/
-SchedBool_t internal_QueueReceive(SchedQueue_t *queue, SchedEvent_t *evt);
-/*判断队列是否为空*/
-SchedBool_t internal_QueueIsEmpty(SchedQueue_t *queue);
-/*判断队列是否已满*/
-SchedBool_t internal_QueueIsFull(SchedQueue_t *queue);
-/*获取队列最大使用量*/
-EvtPos_t internal_QueueGetMaxUsed(SchedQueue_t *queue);
-/*获取队列长度*/
-EvtPos_t internal_QueueGetLength(SchedQueue_t *queue);
-
-#endif  /* __SCHED_INTERNAL_H */
+/*******************************************************************************
+* 文 件 名: sched_internal.h
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-25
+* 文件说明: 事件驱动调度器的内部数据结构定义
+*******************************************************************************/
+
+#ifndef __SCHED_INTERNAL_H
+#define __SCHED_INTERNAL_H
+
+#include "sched_port.h"
+
+/*******************************************************************************
+
+                                   结构体相关
+
+*******************************************************************************/
+/*获取结构体成员变量的偏移量*/
+#ifndef offsetof
+    #define offsetof(type,member)   ( (size_t)(&((type *)0)->member) )
+#endif
+
+/*通过结构体成员指针获得结构体指针*/
+#ifndef container_of
+    #define container_of(ptr, type, member) \
+        ( (type *)((char *)(ptr) - offsetof(type, member)) )
+#endif
+
+/*******************************************************************************
+
+                                  对象管理链表
+
+*******************************************************************************/
+/* 数据结构 ------------------------------------------------------------------*/
+typedef struct sched_list SchedList_t;
+#if SCHED_LIST_COMPACT_EN
+/*
+    紧凑链表项: 前后项以相对本项地址的偏移量表示, 单位为链表项的对齐单位,
+    孤立链表项的偏移量为0; 同一链表的各项(包括链表头)之间的距离不能超出
+    偏移量的表示范围, 例如16位节拍时为64KB, 32位节拍时一般为128KB
+*/
+typedef int16_t SchedListLink_t;
+struct sched_list
+{
+    SchedTick_t         value;  /*链表排序数值  */
+    SchedListLink_t     next;   /*链表后一项的偏移量*/
+    SchedListLink_t     prev;   /*链表前一项的偏移量*/
+    uint8_t             type;   /*链表所属类型  */
+};
+
+/*链表项对齐单位*/
+struct sched_list_align
+{
+    char                pad;
+    SchedList_t         item;
+};
+#define SCHED_LIST_LINK_UNIT    ( (ptrdiff_t)offsetof(struct sched_list_align, item) )
+#else
+struct sched_list
+{
+    SchedList_t        *next;   /*指向链表后一项*/
+    SchedList_t        *prev;   /*指向链表前一项*/
+    SchedTick_t         value;  /*链表排序数值  */
+    SchedBase_t         type;   /*链表所属类型  */
+};
+#endif
+
+/* 常量定义 ------------------------------------------------------------------*/
+enum {
+    SCHED_LIST_HEAD = 0,    /*链表头类型      */
+    SCHED_LIST_CYCLE,       /*循环信号对象类型*/
+    SCHED_LIST_ALARM,       /*闹钟对象类型    */
+    SCHED_LIST_DAEMON,      /*守护任务对象类型*/
+    SCHED_LIST_TIMER,       /*定时节点对象类型*/
+    SCHED_LIST_DAEMON_CYCLE,/*守护任务周期调用对象类型*/
+};
+
+/* 操作宏 --------------------------------------------------------------------*/
+/*
+ * 获取包含链表项的结构体指针
+ * ptr:    链表项指针
+ * type:   包含链表项的结构体类型
+ * member: 链表项在结构体中的成员变量名称
+ * return: 结构体指针
+ */
+#define internal_ListEntry(ptr, type, member)   container_of(ptr, type, member)
+/*
+ * 设置链表排序值
+ * pList:  链表指针
+ * xValue: 设置的排序值
+ */
+#define internal_ListSetValue(pList, xValue)    ( (pList)->value = (xValue) )
+/*
+ * 获取链表排序值
+ * pList:  链表指针
+ * return: 链表排序值
+ */
+#define internal_ListGetValue(pList)            ( (pList)->value )
+/*
+ * 获取链表所属类型
+ * pList:  链表指针
+ * return: 链表所属类型
+ */
+#define internal_ListGetType(pList)             ( (pList)->type )
+#if SCHED_LIST_COMPACT_EN
+/*
+ * 获取链表后一项
+ * pList:  链表指针
+ * return: 链表后一项指针
+ */
+#define internal_ListNext(pList) \
+    ( (SchedList_t *)((char *)(pList) + (pList)->next*SCHED_LIST_LINK_UNIT) )
+/*
+ * 获取链表前一项
+ * pList:  链表指针
+ * return: 链表前一项指针
+ */
+#define internal_ListPrev(pList) \
+    ( (SchedList_t *)((char *)(pList) + (pList)->prev*SCHED_LIST_LINK_UNIT) )
+#else
+/*
+ * 获取链表后一项
+ * pList:  链表指针
+ * return: 链表后一项指针
+ */
+#define internal_ListNext(pList)                ( (pList)->next )
+/*
+ * 获取链表前一项
+ * pList:  链表指针
+ * return: 链表前一项指针
+ */
+#define internal_ListPrev(pList)                ( (pList)->prev )
+#endif
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*初始化链表或者链表项*/
+void internal_ListInit(SchedList_t *pList, SchedBase_t type);
+/*按照排序值从小到大的顺序插入链表项*/
+void internal_ListInsert(SchedList_t *pList, SchedList_t *pListItem);
+/*向链表尾部插入链表项*/
+void internal_ListInsertEnd(SchedList_t *pList, SchedList_t *pListItem);
+/*移除链表项*/
+void internal_ListRemove(SchedList_t *pListItem);
+/*移除并返回链表的第一个链表项, 链表为空时返回NULL*/
+SchedList_t *internal_ListRemoveFirst(SchedList_t *pList);
+/*判断链表是否为空或者链表项是否为孤立链表项*/
+SchedBool_t internal_ListIsEmpty(SchedList_t *pList);
+
+/*******************************************************************************
+
+                                  优先级记录表
+
+*******************************************************************************/
+/* 数据结构 ------------------------------------------------------------------*/
+typedef struct sched_priotable SchedPrioTable_t;
+struct sched_priotable
+{
+    uint8_t     tbl[SCHED_PRIOTBL_TABLE_SIZE];
+    uint8_t     grp;
+};
+
+/* 常量定义 ------------------------------------------------------------------*/
+/*优先级记录表允许最低优先级*/
+#define SCHED_PRIOTBL_LOWEST_PRIO   ( 8*SCHED_PRIOTBL_TABLE_SIZE-1 )
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*初始化优先级记录表*/
+void internal_PriotblInit(SchedPrioTable_t *tbl);
+/*在优先级记录表中记录一个优先级*/
+void internal_PriotblRecordPrio(SchedPrioTable_t *tbl, uint8_t prio);
+/*在优先级记录表中清除一个优先级*/
+void internal_PriotblResetPrio(SchedPrioTable_t *tbl, uint8_t prio);
+/*判断优先级记录表是否为空*/
+SchedBool_t internal_PriotblIsEmpty(SchedPrioTable_t const *tbl);
+/*获取优先级记录表中的最高优先级*/
+uint8_t internal_PriotblGetHighestPrio(SchedPrioTable_t const *tbl);
+#if SCHED_SIGMASK_METHOD
+/*获取优先级记录表中未被屏蔽的最高优先级, 屏蔽字覆盖优先级0-31*/
+SchedBool_t internal_PriotblGetMaskedPrio(SchedPrioTable_t const *tbl, uint32_t mask, uint8_t *prio);
+#endif
+
+#if SCHED_SIGTBL_EXT_EN
+/*******************************************************************************
+
+                                 多级信号记录表
+
+*******************************************************************************/
+/* 常量定义 ------------------------------------------------------------------*/
+/*信号位图大小, 信号数量最多为512个*/
+#define SCHED_SIGTBL_TBL_SIZE       ( (SCHED_SIGTBL_SIG_NUM+7)/8 )
+/*信号组位图大小*/
+#define SCHED_SIGTBL_GRP_SIZE       ( (SCHED_SIGTBL_TBL_SIZE+7)/8 )
+
+/* 数据结构 ------------------------------------------------------------------*/
+typedef struct sched_sigtable SchedSigTable_t;
+struct sched_sigtable
+{
+    uint8_t     tbl[SCHED_SIGTBL_TBL_SIZE]; /*信号位图, 每位对应一个信号    */
+    uint8_t     grp[SCHED_SIGTBL_GRP_SIZE]; /*信号组位图, 每位对应tbl的一项 */
+    uint8_t     top;                        /*顶层位图, 每位对应grp的一项   */
+};
+
+/* 操作函数 ------------------------------------------------------------------*/
+/*初始化多级信号记录表*/
+void internal_SigtblInit(SchedSigTable_t *tbl);
+/*在多级信号记录表中记录一个信号*/
+void internal_SigtblRecordSig(SchedSigTable_t *tbl, uint16_t sig);
+/*在多级信号记录表中清除一个信号*/
+void internal_SigtblResetSig(SchedSigTable_t *tbl, uint16_t sig);
+/*判断多级信号记录表是否为空*/
+SchedBool_t internal_SigtblIsEmpty(SchedSigTable_t const *tbl);
+/*获取多级信号记录表中的最高优先级信号(数值最小的信号)*/
+uint16_t internal_SigtblGetHighestSig(SchedSigTable_t const *tbl);
+#if SCHED_SIGMASK_METHOD
+/*获取多级信号记录表中未被屏蔽的最高优先级信号, 屏蔽字覆盖信号0-31*/
+SchedBool_t internal_SigtblGetMaskedSig(SchedSigTable_t const *tbl, uint32_t mask, uint16_t *sig);
+#endif
+#endif  /* SCHED_SIGTBL_EXT_EN */
+
+/*******************************************************************************
+
+                                    消息队列
+
+*******************************************************************************/
+/* 数据结构 ------------------------------------------------------------------*/
+#if SCHED_EVENT_POOL_EN
+typedef struct sched_event_node SchedEventNode_t;
+struct sched_event_node
+{
+    SchedEventNode_t   *next;       /*指向后一个节点*/
+    SchedEvent_t        event;      /*节点事件块    */
+};
+
+typedef struct sched_event_pool SchedEventPool_t;
+struct sched_event_pool
+{
+    SchedEventNode_t   *freeList;   /*空闲节点链表  */
+    EvtPos_t            nFree;      /*空闲节点数量  */
+    EvtPos_t            nMinFree;   /*空闲节点最小量*/
+};
+#endif
+
+typedef struct sched_queue SchedQueue_t;
+struct sched_queue
+{
+#if SCHED_EVENT_POOL_EN
+    SchedEventPool_t   *pool;       /*共享事件节点池*/
+    SchedEventNode_t   *first;      /*队列头部(读)  */
+    SchedEventNode_t   *last;       /*队列尾部(写)  */
+    EvtPos_t            end;        /*队列容量上限  */
+#else
+    SchedEvent_t       *evtQueue;   /*队列环形Buffer*/
+    EvtPos_t            end;        /*队列总长度    */
+    EvtPos_t            head;       /*队列头部(读)  */
+    EvtPos_t            tail;       /*队列尾部(写)  */
+#endif
+    EvtPos_t            nUsed;      /*队列已使用量  */
+    EvtPos_t            nMaxUsed;   /*队列最大使用量*/
+#if SCHED_QUEUE_POLICY_EN
+    uint8_t             policy;     /*队列溢出策略  */
+    uint32_t            nDropped;   /*队列丢弃计数  */
+#endif
+#if SCHED_EVENT_CONFLATE_EN
+    uint8_t             conflateMap[(SCHED_CONFLATE_SIG_NUM+7)/8];  /*信号合并标志*/
+    SchedEvent_t       *conflateSlot[SCHED_CONFLATE_SIG_NUM];       /*等待中的合并信号事件块*/
+#endif
+};
+
+/* 操作函数 ------------------------------------------------------------------*/
+#if SCHED_EVENT_POOL_EN
+/*事件节点池初始化*/
+void internal_EventPoolInit(SchedEventPool_t *pool, SchedEventNode_t *nodes, EvtPos_t len);
+/*获取事件节点池空闲节点最小量*/
+EvtPos_t internal_EventPoolGetMinFree(SchedEventPool_t *pool);
+/*队列初始化, 队列节点从共享事件节点池中分配*/
+void internal_QueueInit(SchedQueue_t *queue, SchedEventPool_t *pool, EvtPos_t len);
+#else
+/*队列初始化*/
+void internal_QueueInit(SchedQueue_t *queue, SchedEvent_t *evtQueue, EvtPos_t len);
+#endif
+/*向队列尾部插入一个事件块*/
+SchedBool_t internal_QueueSend(SchedQueue_t *queue, SchedEvent_t const *evt);
+/*向队列头部插入一个事件块*/
+SchedBool_t internal_QueueSendFront(SchedQueue_t *queue, SchedEvent_t const *evt);
+/*从队列头部取出一个事件块*/
+SchedBool_t internal_QueueReceive(SchedQueue_t *queue, SchedEvent_t *evt);
+/*判断队列是否为空*/
+SchedBool_t internal_QueueIsEmpty(SchedQueue_t *queue);
+/*判断队列是否已满*/
+SchedBool_t internal_QueueIsFull(SchedQueue_t *queue);
+/*获取队列最大使用量*/
+EvtPos_t internal_QueueGetMaxUsed(SchedQueue_t *queue);
+/*获取队列长度*/
+EvtPos_t internal_QueueGetLength(SchedQueue_t *queue);
+#if SCHED_QUEUE_POLICY_EN
+/*设置队列溢出策略*/
+void internal_QueueSetPolicy(SchedQueue_t *queue, uint8_t policy);
+/*获取队列丢弃计数*/
+uint32_t internal_QueueGetDropCount(SchedQueue_t *queue);
+#endif
+#if SCHED_EVENT_CONFLATE_EN
+/*设置信号是否合并, 合并信号在队列中最多只有一个等待的事件块*/
+void internal_QueueSetConflate(SchedQueue_t *queue, EvtSig_t sig, SchedBool_t enable);
+#endif
+#if SCHED_TASK_DEFER_EN
+/*将延迟队列中的事件块按原顺序移动到队列头部*/
+EvtPos_t internal_QueueRecall(SchedQueue_t *queue, SchedQueue_t *defer);
+#endif
+
+#endif  /* __SCHED_INTERNAL_H */
@@ -1,171 +1,414 @@
-/*******************************************************************************
-* 文 件 名: sched_port.h
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-25
-* 文件说明: 事件驱动调度器的底层接口
-*******************************************************************************/
-
-#ifndef __SCHED_PORT_H
-#define __SCHED_PORT_H
-
-/* 头文件 --------------------------------------------------------------------*/
-#include "cpu.h"
-#include "sched_config.h"
-#include <stdint.h>
-#include <stddef.h>
-
-/* 底层移植接口 --------------------------------------------------------------*/
-/*基本类型*/
-typedef base_t  SchedBase_t;
-/*体系类型*/
-typedef cpu_t   SchedCPU_t;
-/*临界区管理*/
-#define SCHED_EnterCritical()           CPU_EnterCritical()
-#define SCHED_ExitCritical(x)           CPU_ExitCritical(x)
-#define SCHED_EnterCriticalFromISR()    CPU_EnterCriticalFromISR()
-#define SCHED_ExitCriticalFromISR(x)    CPU_ExitCriticalFromISR(x)
-
-/* 调度器数据类型 ------------------------------------------------------------*/
-/*节拍类型*/
-#if SCHED_USE_16BIT_TICK_EN
-    typedef uint16_t SchedTick_t;
-    #define SCHED_MAX_TICK  ( (SchedTick_t)0xFFFF )
-#else
-    typedef uint32_t SchedTick_t;
-    #define SCHED_MAX_TICK  ( (SchedTick_t)0xFFFFFFFF )
-#endif
-
-/*布尔类型*/
-typedef enum {SCHED_FALSE = 0, SCHED_TRUE = 1}  SchedBool_t;
-
-/*调度器状态类型*/
-typedef enum sched_status SchedStatus_t;
-
-/*事件块类型*/
-typedef uint8_t     EvtPos_t;   /*消息队列偏移量类型*/
-typedef uint16_t    EvtSig_t;   /*事件块信号数据类型*/
-typedef uint32_t    EvtMsg_t;   /*事件块消息数据类型*/
-typedef struct sched_event SchedEvent_t;
-struct sched_event
-{
-    EvtSig_t    sig;    /*信号*/
-    EvtMsg_t    msg;    /*消息*/
-};
-
-/*任务句柄*/
-typedef void *  SchedTaskHandle_t;
-
-/*闹钟句柄*/
-typedef void *  SchedAlarmHandle_t;
-
-/*守护任务句柄*/
-typedef void *  SchedDaemonHandle_t;
-
-/*状态函数*/
-typedef SchedBase_t (*SchedStateFunction_t)(SchedTaskHandle_t me, SchedEvent_t const *e);
-
-/*守护任务函数*/
-typedef void (*SchedDaemonFunction_t)(SchedDaemonHandle_t me, SchedEvent_t const *e);
-
-/* 调度器常量 ----------------------------------------------------------------*/
-/*状态函数返回常量*/
-#define SCHED_RET_HANDLED   ( (SchedBase_t) 0 )
-#define SCHED_RET_IGNORED   ( (SchedBase_t) 1 )
-#define SCHED_RET_TRAN      ( (SchedBase_t) 2 )
-
-/*内部信号常量*/
-enum {
-    SCHED_SIG_EMPTY = 0,    /*初始化空信号*/
-    SCHED_SIG_ENTRY,        /*状态进入信号*/
-    SCHED_SIG_EXIT,         /*状态退出信号*/
-    SCHED_SIG_CYCLE,        /*周期循环信号*/
-    SCHED_SIG_USER,         /*自定义信号  */
-};
-
-/*调度器状态值*/
-enum sched_status
-{
-    SCHED_SUCCESS = 0,
-    SCHED_CORE_UNKNOWN,
-    SCHED_CORE_STOP,
-    SCHED_CORE_RUNNING,
-    SCHED_EVENT_SEND_FAILED,
-    SCHED_EVENT_RECEIVE_FAILED,
-    SCHED_ALARM_STOP,
-    SCHED_ALARM_RUNNING,
-    SCHED_ALARM_ARRIVED,
-    SCHED_DAEMON_CALL_FAILED,
-    SCHED_DAEMON_DORMANT,
-    SCHED_DAEMON_ACTIVE,
-    SCHED_DAEMON_RUNNING,
-
-    errSCHED_PARAM_PTR_IS_NULL = 64,
-    errSCHED_PARAM_NOT_ALLOWED,
-    errSCHED_LIST_ERROR,
-    errSCHED_PRIOTBL_ERROR,
-    errSCHED_NOT_IN_INTERRUPT,
-    errSCHED_FSM_INITIAL_NOT_TRAN,
-    errSCHED_FSM_ENTRY_TRAN,
-    errSCHED_FSM_EXIT_TRAN,
-    errSCHED_CORE_START_BEFORE_INIT,
-    errSCHED_TASK_PRIO_OVER_LOWEST,
-    errSCHED_TASK_PRIO_IS_ALLOCATED,
-    errSCHED_TASK_NOT_CREATED_BEFORE_CORE_RUNNING,
-    errSCHED_TASK_NOT_EXISTED,
-    errSCHED_EVENT_SEND_NOT_USER_SIGNAL,
-    errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING,
-    errSCHED_ALARM_EVENT_NOT_USER_SIGNAL,
-    errSCHED_ALARM_NOT_CREATED_BEFORE_CORE_RUNNING,
-    errSCHED_ALARM_OPERATED_BEFORE_CORE_RUNNING,
-    errSCHED_DAEMON_NOT_CREATED_BEFORE_CORE_RUNNING,
-
-    chkSCHED_MALLOC_FAILED = 128,
-    chkSCHED_TYPE_CONVERSION_FAILED,
-    chkSCHED_EVENT_SEND_FAILED,
-};
-
-/* 调度器宏定义 --------------------------------------------------------------*/
-/*状态函数返回宏*/
-#define SCHED_HANDLED()         ( SCHED_RET_HANDLED )
-#define SCHED_IGNORED()         ( SCHED_RET_IGNORED )
-#define SCHED_TRAN(target)      ( *((SchedStateFunction_t *)me) = (target), SCHED_RET_TRAN )
-
-/*状态函数宏函数*/
-#define SCHED_THIS_TASK()       ( (SchedTaskHandle_t)me )
-#define SCHED_THIS_STATE()      ( *(SchedStateFunction_t *)me )
-#define SCHED_MS_TO_TICK(nms)   ( (SchedTick_t)((uint32_t)(nms)*SCHED_TICK_HZ/1000) )
-#define SCHED_HZ_TO_TICK(nhz)   ( (SchedTick_t)(SCHED_TICK_HZ/(nhz)) )
-
-/* 内部宏定义 ----------------------------------------------------------------*/
-#if SCHED_ASSERT_EN
-    #define SCHED_ASSERT(expr, errCode) \
-        if (!(expr)) {sched_PortErrorHandler(errCode);}
-#else
-    #define SCHED_ASSERT(expr, errCode) ((void)0)
-#endif
-
-#if SCHED_CHECK_EN
-    #define SCHED_CHECK(expr, chkCode) \
-        if (!(expr)) {sched_PortErrorHandler(chkCode);}
-#else
-    #define SCHED_CHECK(expr, chkCode) ((void)0)
-#endif
-
-/* 底层函数 ------------------------------------------------------------------*/
-/*调度器底层初始化*/
-void sched_PortInit(void);
-/*事件块复制*/
-void sched_PortEventCopy(SchedEvent_t *dest, SchedEvent_t const *src);
-/*内存管理初始化*/
-void sched_PortHeapInit(void);
-/*动态内存分配*/
-void *sched_PortMalloc(size_t size);
-/*动态内存释放*/
-void sched_PortFree(void *pv);
-/*调度器错误处理函数*/
-void sched_PortErrorHandler(SchedStatus_t errCode);
-/*调度器空闲处理函数*/
-void sched_PortIdleHandler(void);
-
-#endif  /* __SCHED_PORT_H */
+/*******************************************************************************
+* 文 件 名: sched_port.h
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-25
+* 文件说明: 事件驱动调度器的底层接口
+*******************************************************************************/
+
+#ifndef __SCHED_PORT_H
+#define __SCHED_PORT_H
+
+/* 头文件 --------------------------------------------------------------------*/
+#include "cpu.h"
+#include "sched_config.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/* 底层移植接口 --------------------------------------------------------------*/
+/*基本类型*/
+typedef base_t  SchedBase_t;
+/*体系类型*/
+typedef cpu_t   SchedCPU_t;
+/*临界区管理*/
+#define SCHED_EnterCritical()           CPU_EnterCritical()
+#define SCHED_ExitCritical(x)           CPU_ExitCritical(x)
+#define SCHED_EnterCriticalFromISR()    CPU_EnterCriticalFromISR()
+#define SCHED_ExitCriticalFromISR(x)    CPU_ExitCriticalFromISR(x)
+/*事件时间戳, 默认使用调度器节拍计数, 可在cpu.h中定义CPU_GetTimestamp()使用周期计数器*/
+#ifdef CPU_GetTimestamp
+    #define SCHED_GetTimestamp()        ( (SchedTimestamp_t)CPU_GetTimestamp() )
+#else
+    #define SCHED_GetTimestamp()        ( (SchedTimestamp_t)framework_CoreGetTick() )
+#endif
+
+/* 调度器数据类型 ------------------------------------------------------------*/
+/*节拍类型*/
+#if SCHED_USE_16BIT_TICK_EN
+    typedef uint16_t SchedTick_t;
+    #define SCHED_MAX_TICK  ( (SchedTick_t)0xFFFF )
+#else
+    typedef uint32_t SchedTick_t;
+    #define SCHED_MAX_TICK  ( (SchedTick_t)0xFFFFFFFF )
+#endif
+
+/*布尔类型*/
+typedef enum {SCHED_FALSE = 0, SCHED_TRUE = 1}  SchedBool_t;
+
+/*事件块类型*/
+#if SCHED_EVTPOS_WIDTH == 32
+    typedef uint32_t EvtPos_t;  /*消息队列偏移量类型*/
+#elif SCHED_EVTPOS_WIDTH == 16
+    typedef uint16_t EvtPos_t;  /*消息队列偏移量类型*/
+#elif SCHED_EVTPOS_WIDTH == 8
+    typedef uint8_t  EvtPos_t;  /*消息队列偏移量类型*/
+#else
+    #error "SCHED_EVTPOS_WIDTH must be 8, 16 or 32"
+#endif
+typedef uint16_t    EvtSig_t;   /*事件块信号数据类型*/
+typedef uint32_t    EvtMsg_t;   /*事件块消息数据类型*/
+typedef uint32_t    SchedSigMask_t; /*状态信号屏蔽字类型, 每位对应一个用户信号*/
+/*事件时间戳类型, 默认时间戳为节拍计数, 与节拍类型同宽, 保证时间差在回绕时正确*/
+#ifdef CPU_GetTimestamp
+typedef uint32_t    SchedTimestamp_t;
+#else
+typedef SchedTick_t SchedTimestamp_t;
+#endif
+typedef struct sched_event SchedEvent_t;
+struct sched_event
+{
+    EvtSig_t    sig;    /*信号*/
+    EvtMsg_t    msg;    /*消息*/
+#if SCHED_EVENT_TIMESTAMP_EN
+    SchedTimestamp_t stamp; /*事件发送时间戳*/
+#endif
+};
+
+/*任务句柄*/
+typedef void *  SchedTaskHandle_t;
+
+/*闹钟句柄*/
+typedef void *  SchedAlarmHandle_t;
+
+/*守护任务句柄*/
+typedef void *  SchedDaemonHandle_t;
+
+#if SCHED_STATIC_ALLOC_EN
+/*静态创建对象的控制块存储类型, 完整定义见sched_framework.h*/
+typedef struct sched_task   SchedTaskStatic_t;
+typedef struct sched_alarm  SchedAlarmStatic_t;
+typedef struct sched_daemon SchedDaemonStatic_t;
+#endif
+
+/*守护任务调用队列存储单元, 使能共享事件节点池时为事件节点(定义见sched_internal.h)*/
+#if SCHED_DAEMON_QUEUE_EN && SCHED_EVENT_POOL_EN
+typedef struct sched_event_node SchedDaemonQueueItem_t;
+#else
+typedef SchedEvent_t SchedDaemonQueueItem_t;
+#endif
+
+/*状态函数*/
+typedef SchedBase_t (*SchedStateFunction_t)(SchedTaskHandle_t me, SchedEvent_t const *e);
+
+#if SCHED_FSM_TRACE_EN
+/*状态标识, 状态函数地址或者状态转移表中的状态序号*/
+typedef uintptr_t SchedTraceState_t;
+#define SCHED_TRACE_NO_STATE    ( (SchedTraceState_t)~(SchedTraceState_t)0 )
+
+/*状态转移跟踪记录*/
+typedef struct sched_trace_record SchedTraceRecord_t;
+struct sched_trace_record
+{
+    SchedTaskHandle_t   task;   /*发生状态转移的任务*/
+    SchedTraceState_t   from;   /*原状态, SCHED_TRACE_NO_STATE表示初始转移*/
+    SchedTraceState_t   to;     /*新状态*/
+    SchedTimestamp_t    stamp;  /*状态转移时间戳*/
+    EvtSig_t            sig;    /*触发状态转移的信号*/
+};
+
+/*状态驻留时间统计*/
+typedef struct sched_trace_residency SchedTraceResidency_t;
+struct sched_trace_residency
+{
+    SchedTaskHandle_t   task;   /*状态所属任务*/
+    SchedTraceState_t   state;  /*状态标识*/
+    uint32_t            time;   /*离开该状态时累计的驻留时间(时间戳单位)*/
+    uint32_t            count;  /*离开该状态的次数*/
+};
+#endif
+
+#if SCHED_FSM_TABLE_EN
+/*状态转移表动作函数*/
+typedef void (*SchedTableAction_t)(SchedTaskHandle_t me, SchedEvent_t const *e);
+
+/*状态转移表单元, 每个(状态, 信号)对应一个单元*/
+typedef struct sched_fsm_cell SchedFsmCell_t;
+struct sched_fsm_cell
+{
+    SchedTableAction_t  action; /*动作函数, NULL表示无动作*/
+    uint8_t             target; /*目标状态, SCHED_TABLE_NO_TRAN表示不转移*/
+};
+
+/*状态转移表, 单元按状态分行, 每行按信号值排列nSigs个单元*/
+typedef struct sched_fsm_table SchedFsmTable_t;
+struct sched_fsm_table
+{
+    SchedFsmCell_t const   *cells;  /*状态转移表单元数组*/
+    uint8_t                 nStates;/*状态数量*/
+    uint8_t                 nSigs;  /*信号数量, 包括内部信号*/
+    uint8_t                 initial;/*初始状态*/
+};
+#endif
+
+/*守护任务函数*/
+typedef void (*SchedDaemonFunction_t)(SchedDaemonHandle_t me, SchedEvent_t const *e);
+
+#if SCHED_DAEMON_OFFLOAD_EN
+/*卸载守护任务函数, 在工作线程中执行, 返回值作为完成事件的消息*/
+typedef EvtMsg_t (*SchedOffloadFunction_t)(SchedDaemonHandle_t me, SchedEvent_t const *e);
+
+/*工作线程作业, 由作业提交者分配, 作业完成前不允许修改*/
+typedef struct sched_worker_job SchedWorkerJob_t;
+typedef void (*SchedWorkerFunction_t)(SchedWorkerJob_t *job);
+struct sched_worker_job
+{
+    SchedWorkerFunction_t   func;   /*作业函数, 在工作线程中执行*/
+    SchedWorkerJob_t       *next;   /*完成链表指针, 由底层接口使用*/
+};
+#endif
+
+/*内存池块大小级使用统计*/
+typedef struct sched_heap_class_stat SchedHeapClassStat_t;
+struct sched_heap_class_stat
+{
+    size_t      blockSize;  /*块大小*/
+    uint16_t    carved;     /*已从堆中切分的块数量*/
+    uint16_t    used;       /*正在使用的块数量*/
+    uint16_t    maxUsed;    /*使用块数量最大值*/
+};
+
+/* 调度器常量 ----------------------------------------------------------------*/
+/*状态函数返回常量*/
+#define SCHED_RET_HANDLED   ( (SchedBase_t) 0 )
+#define SCHED_RET_IGNORED   ( (SchedBase_t) 1 )
+#define SCHED_RET_TRAN      ( (SchedBase_t) 2 )
+#if SCHED_FSM_HSM_EN
+#define SCHED_RET_SUPER     ( (SchedBase_t) 3 )
+#endif
+
+/*内部信号常量*/
+enum {
+    SCHED_SIG_EMPTY = 0,    /*初始化空信号*/
+    SCHED_SIG_ENTRY,        /*状态进入信号*/
+    SCHED_SIG_EXIT,         /*状态退出信号*/
+    SCHED_SIG_CYCLE,        /*周期循环信号*/
+#if SCHED_FSM_HSM_EN
+    SCHED_SIG_INIT,         /*初始转移信号*/
+#endif
+    SCHED_SIG_USER,         /*自定义信号  */
+};
+
+/*任务消息队列存储空间的事件块数量(各通道消息队列及延迟队列), 0表示不需要存储空间*/
+#if (SCHED_TASK_EVENT_METHOD == 0) || SCHED_EVENT_POOL_EN
+    #define SCHED_TASK_QUEUE_BUF_LEN(queueLen)  ( 0 )
+#elif SCHED_TASK_DEFER_EN
+    #define SCHED_TASK_QUEUE_BUF_LEN(queueLen)  ( (size_t)(queueLen)*SCHED_TASK_QUEUE_LANES+SCHED_TASK_DEFER_LEN )
+#else
+    #define SCHED_TASK_QUEUE_BUF_LEN(queueLen)  ( (size_t)(queueLen)*SCHED_TASK_QUEUE_LANES )
+#endif
+
+/*守护任务调用队列存储单元数量, 0表示不需要存储空间*/
+#if SCHED_DAEMON_QUEUE_EN
+    #define SCHED_DAEMON_QUEUE_BUF_LEN          ( (size_t)SCHED_DAEMON_QUEUE_LEN )
+#else
+    #define SCHED_DAEMON_QUEUE_BUF_LEN          ( (size_t)0 )
+#endif
+
+/*消息队列溢出策略*/
+enum {
+    SCHED_QUEUE_REJECT = 0,     /*拒绝新事件                */
+    SCHED_QUEUE_DROP_OLDEST,    /*丢弃队列中最早的事件      */
+    SCHED_QUEUE_COALESCE,       /*替换队列中相同信号的事件  */
+};
+
+/*调度器状态值*/
+enum sched_status
+{
+    SCHED_SUCCESS = 0,
+    SCHED_CORE_UNKNOWN,
+    SCHED_CORE_STOP,
+    SCHED_CORE_RUNNING,
+    SCHED_EVENT_SEND_FAILED,
+    SCHED_EVENT_RECEIVE_FAILED,
+    SCHED_ALARM_STOP,
+    SCHED_ALARM_RUNNING,
+    SCHED_ALARM_ARRIVED,
+    SCHED_DAEMON_CALL_FAILED,
+    SCHED_DAEMON_DORMANT,
+    SCHED_DAEMON_ACTIVE,
+    SCHED_DAEMON_RUNNING,
+
+    errSCHED_PARAM_PTR_IS_NULL = 64,
+    errSCHED_PARAM_NOT_ALLOWED,
+    errSCHED_LIST_ERROR,
+    errSCHED_PRIOTBL_ERROR,
+    errSCHED_NOT_IN_INTERRUPT,
+    errSCHED_FSM_INITIAL_NOT_TRAN,
+    errSCHED_FSM_ENTRY_TRAN,
+    errSCHED_FSM_EXIT_TRAN,
+    errSCHED_CORE_START_BEFORE_INIT,
+    errSCHED_TASK_PRIO_OVER_LOWEST,
+    errSCHED_TASK_PRIO_IS_ALLOCATED,
+    errSCHED_TASK_NOT_CREATED_BEFORE_CORE_RUNNING,
+    errSCHED_TASK_NOT_EXISTED,
+    errSCHED_EVENT_SEND_NOT_USER_SIGNAL,
+    errSCHED_EVENT_SEND_BEFORE_CORE_RUNNING,
+    errSCHED_ALARM_EVENT_NOT_USER_SIGNAL,
+    errSCHED_ALARM_NOT_CREATED_BEFORE_CORE_RUNNING,
+    errSCHED_ALARM_OPERATED_BEFORE_CORE_RUNNING,
+    errSCHED_DAEMON_NOT_CREATED_BEFORE_CORE_RUNNING,
+    errSCHED_TASK_NOT_CONFIGURED_BEFORE_CORE_RUNNING,
+    errSCHED_FSM_HSM_DEPTH_OVERFLOW,
+    errSCHED_FSM_HSM_INIT_NOT_SUBSTATE,
+    errSCHED_DAEMON_PRIO_OVER_LOWEST,
+    errSCHED_DAEMON_CO_NOT_RUNNING,
+    errSCHED_HEAP_CORRUPTED,
+    errSCHED_LIST_LINK_OUT_OF_RANGE,
+
+    chkSCHED_MALLOC_FAILED = 128,
+    chkSCHED_TYPE_CONVERSION_FAILED,
+    chkSCHED_EVENT_SEND_FAILED,
+    chkSCHED_TIMER_NODE_EXHAUSTED,
+    chkSCHED_DAEMON_CALL_FAILED,
+};
+/*调度器状态类型*/
+typedef enum sched_status SchedStatus_t;
+
+/* 调度器宏定义 --------------------------------------------------------------*/
+/*状态函数返回宏*/
+#define SCHED_HANDLED()         ( SCHED_RET_HANDLED )
+#define SCHED_IGNORED()         ( SCHED_RET_IGNORED )
+#define SCHED_TRAN(target)      ( *((SchedStateFunction_t *)me) = (target), SCHED_RET_TRAN )
+#if SCHED_FSM_HSM_EN
+/*层次状态机中, 状态未处理的事件通过本宏交给超状态处理, 顶层状态无需超状态*/
+#define SCHED_SUPER(super)      ( *((SchedStateFunction_t *)me) = (super), SCHED_RET_SUPER )
+#endif
+
+/*状态函数宏函数*/
+#define SCHED_THIS_TASK()       ( (SchedTaskHandle_t)me )
+#define SCHED_THIS_STATE()      ( *(SchedStateFunction_t *)me )
+
+#if SCHED_DAEMON_EN && SCHED_DAEMON_CO_EN
+/*
+    无栈协程守护任务宏函数, 守护任务函数参数必须命名为me和e, 用法:
+
+    static void job(SchedDaemonHandle_t me, SchedEvent_t const *e)
+    {
+    static uint16_t i;
+
+        SCHED_CO_BEGIN();
+        for (i=0;i<FLASH_PAGES;i++)
+        {
+            erase(i);
+            SCHED_CO_YIELD();           让出, 其它守护任务执行后继续
+        }
+        SCHED_CO_SLEEP(10);             让出并延时10个节拍后继续
+        SCHED_CO_WAIT(SIG_VERIFY);      等待以SIG_VERIFY信号调用守护任务
+        SCHED_CO_END();
+    }
+
+    断点保存为行号, 让出后局部变量不保留, 跨越断点的变量需要使用静态变量;
+    BEGIN与END之间不允许使用switch语句包含断点
+*/
+#define SCHED_CO_BEGIN()        switch (sched_DaemonCoGetLine(me)) { case 0:
+#define SCHED_CO_YIELD()        do { sched_DaemonCoYield(me, (uint16_t)__LINE__, 0); return; \
+                                     case __LINE__:; } while (0)
+#define SCHED_CO_SLEEP(tick)    do { sched_DaemonCoYield(me, (uint16_t)__LINE__, (tick)); return; \
+                                     case __LINE__:; } while (0)
+#define SCHED_CO_WAIT(evtSig)   do { sched_DaemonCoSetLine(me, (uint16_t)__LINE__); return; \
+                                     case __LINE__: if ((evtSig) != e->sig) { return; } } while (0)
+#define SCHED_CO_END()          } sched_DaemonCoSetLine(me, 0)
+#endif
+
+/*编译期断言, 条件不成立时数组长度为负导致编译错误*/
+#define SCHED_STATIC_ASSERT(expr, name) typedef char name[(expr) ? 1 : -1]
+
+#if SCHED_FSM_TABLE_EN
+/*状态转移表单元宏函数*/
+#define SCHED_TABLE_NO_TRAN     ( (uint8_t)0xFF )
+#define SCHED_TABLE_TRAN(action, target)    { (action), (uint8_t)(target) }
+#define SCHED_TABLE_STAY(action)            { (action), SCHED_TABLE_NO_TRAN }
+#define SCHED_TABLE_IGNORE                  { NULL, SCHED_TABLE_NO_TRAN }
+/*状态转移表行首的内部信号单元, 依次为空信号,进入,退出,周期循环(,初始转移)*/
+#if SCHED_FSM_HSM_EN
+#define SCHED_TABLE_STATE(entry, exit, cycle) \
+    SCHED_TABLE_IGNORE, SCHED_TABLE_STAY(entry), SCHED_TABLE_STAY(exit), \
+    SCHED_TABLE_STAY(cycle), SCHED_TABLE_IGNORE
+#else
+#define SCHED_TABLE_STATE(entry, exit, cycle) \
+    SCHED_TABLE_IGNORE, SCHED_TABLE_STAY(entry), SCHED_TABLE_STAY(exit), \
+    SCHED_TABLE_STAY(cycle)
+#endif
+/*
+    定义状态转移表, cells必须是未指定长度的一维单元数组,
+    编译期检查单元数量等于nStates*nSigs, 缺少或多出单元时编译失败
+*/
+#define SCHED_TABLE_DEFINE(name, cells, nStates, nSigs, initial) \
+    SCHED_STATIC_ASSERT(sizeof(cells) == (size_t)(nStates)*(nSigs)*sizeof(SchedFsmCell_t), \
+                        name##_is_incomplete); \
+    SCHED_STATIC_ASSERT((int)(nSigs) >= (int)SCHED_SIG_USER, name##_lacks_internal_signals); \
+    SCHED_STATIC_ASSERT((int)(initial) < (int)(nStates), name##_bad_initial); \
+    static const SchedFsmTable_t name = { (cells), (nStates), (nSigs), (initial) }
+#endif
+
+/*状态信号屏蔽字宏函数, 屏蔽字只覆盖SCHED_SIG_USER - SCHED_SIG_USER+31*/
+#define SCHED_SIGMASK(sig)      ( (SchedSigMask_t)1<<((sig)-SCHED_SIG_USER) )
+#define SCHED_SIGMASK_ALL       ( (SchedSigMask_t)0xFFFFFFFF )
+#define SCHED_MS_TO_TICK(nms)   ( (SchedTick_t)((uint32_t)(nms)*SCHED_TICK_HZ/1000) )
+#define SCHED_HZ_TO_TICK(nhz)   ( (SchedTick_t)(SCHED_TICK_HZ/(nhz)) )
+
+/* 内部宏定义 ----------------------------------------------------------------*/
+#if SCHED_ASSERT_EN
+    #define SCHED_ASSERT(expr, errCode) \
+        if (!(expr)) {sched_PortErrorHandler(errCode);}
+#else
+    #define SCHED_ASSERT(expr, errCode) ((void)0)
+#endif
+
+#if SCHED_CHECK_EN
+    #define SCHED_CHECK(expr, chkCode) \
+        if (!(expr)) {sched_PortErrorHandler(chkCode);}
+#else
+    #define SCHED_CHECK(expr, chkCode) ((void)0)
+#endif
+
+/* 底层函数 ------------------------------------------------------------------*/
+/*调度器底层初始化*/
+void sched_PortInit(void);
+/*事件块复制*/
+void sched_PortEventCopy(SchedEvent_t *dest, SchedEvent_t const *src);
+/*内存管理初始化, 未使能SCHED_DYNAMIC_ALLOC_EN时不需要实现内存管理*/
+void sched_PortHeapInit(void);
+/*动态内存分配*/
+void *sched_PortMalloc(size_t size);
+/*动态内存释放*/
+void sched_PortFree(void *pv);
+/*
+    获取内存池第classIdx级的使用统计(仅sched_heap_3.c实现),
+    返回SCHED_FALSE表示级数超出范围
+*/
+SchedBool_t sched_PortHeapGetClassStat(uint8_t classIdx, SchedHeapClassStat_t *stat);
+/*获取空闲内存总量(仅sched_heap_4.c实现)*/
+size_t sched_PortHeapGetFreeSize(void);
+/*获取最大空闲块大小(仅sched_heap_4.c实现)*/
+size_t sched_PortHeapGetLargestFree(void);
+/*调度器错误处理函数*/
+void sched_PortErrorHandler(SchedStatus_t errCode);
+/*调度器空闲处理函数*/
+void sched_PortIdleHandler(void);
+
+#if SCHED_DAEMON_OFFLOAD_EN
+/*工作线程池初始化*/
+void sched_PortWorkerInit(void);
+/*
+    提交作业到工作线程池, 只允许在调度线程中调用,
+    返回SCHED_FALSE表示作业队列已满, 作业未提交
+*/
+SchedBool_t sched_PortWorkerSubmit(SchedWorkerJob_t *job);
+/*在工作线程中报告作业完成, 作业加入完成链表*/
+void sched_PortWorkerComplete(SchedWorkerJob_t *job);
+/*在调度线程中取出全部已完成的作业, 按完成顺序通过next链接, 没有时返回NULL*/
+SchedWorkerJob_t *sched_PortWorkerTakeDone(void);
+#endif
+
+#endif  /* __SCHED_PORT_H */
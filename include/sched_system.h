@@ -0,0 +1,225 @@
+/*******************************************************************************
+* 文 件 名: sched_system.h
+* 创 建 者: agent
+* 版    本: V1.0
+* 创建日期: 2026-10-19
+* 文件说明: 事件驱动调度器的系统描述生成器, 由X宏描述的任务、闹钟和守护任务
+*           生成静态存储空间和创建函数, 启动时不使用堆
+*******************************************************************************/
+
+#ifndef __SCHED_SYSTEM_H
+#define __SCHED_SYSTEM_H
+
+/*
+    用法, 在系统描述头文件(例如app_system.h)中列出所有对象:
+
+    #define SCHED_SYSTEM_TASKS(X) \
+        X(taskBlinky, 1, 8, Blinky_Initial, 100)    任务句柄, 优先级, 队列长度, 初始伪状态, 周期
+    #define SCHED_SYSTEM_TABLE_TASKS(X) \
+        X(taskMotor,  2, 4, &motorTable, 0)         任务句柄, 优先级, 队列长度, 状态转移表, 周期
+    #define SCHED_SYSTEM_ALARMS(X) \
+        X(alarmTmo, taskBlinky, SIG_TMO, 0)         闹钟句柄, 目标任务句柄, 信号, 消息
+    #define SCHED_SYSTEM_DAEMONS(X) \
+        X(daemonPoll, Poll_Daemon, 0)               守护任务句柄, 守护任务函数, 优先级
+    #include "sched_system.h"
+
+    包含系统描述头文件即可获得各句柄的声明; 在且仅在一个源文件中先定义
+    SCHED_SYSTEM_IMPLEMENTATION再包含系统描述头文件, 生成静态存储空间、句柄和
+    sched_SystemCreate(), 在sched_Init()之后、sched_Start()之前调用一次即可:
+
+    sched_Init();
+    sched_SystemCreate();
+    sched_Start();
+
+    未列出的对象类型可以不定义对应的宏; 周期为0表示不产生周期循环信号,
+    未使能SCHED_TASK_CYCLE_EN时周期必须为0; 使用消息队列时队列长度必须大于0;
+    未使能SCHED_DAEMON_PRIO_EN时守护任务的优先级被忽略;
+    闹钟创建后处于停止状态, 由任务在运行时设置
+*/
+
+/* 头文件 --------------------------------------------------------------------*/
+#include "sched.h"
+#include "sched_framework.h"
+
+#if !SCHED_STATIC_ALLOC_EN
+    #error "sched_system.h requires SCHED_STATIC_ALLOC_EN"
+#endif
+
+/*未列出的对象类型*/
+#ifndef SCHED_SYSTEM_TASKS
+    #define SCHED_SYSTEM_TASKS(X)
+#endif
+#ifndef SCHED_SYSTEM_TABLE_TASKS
+    #define SCHED_SYSTEM_TABLE_TASKS(X)
+#endif
+#ifndef SCHED_SYSTEM_ALARMS
+    #define SCHED_SYSTEM_ALARMS(X)
+#endif
+#ifndef SCHED_SYSTEM_DAEMONS
+    #define SCHED_SYSTEM_DAEMONS(X)
+#endif
+
+#if SCHED_FSM_TABLE_EN == 0
+/*未使能状态转移表时不允许列出使用状态转移表的任务*/
+#define SCHED_SYSTEM_TABLE_TASK_UNSUPPORTED(name, prio, queueLen, table, period) \
+    SCHED_STATIC_ASSERT(0, name##_requires_SCHED_FSM_TABLE_EN);
+SCHED_SYSTEM_TABLE_TASKS(SCHED_SYSTEM_TABLE_TASK_UNSUPPORTED)
+#undef SCHED_SYSTEM_TABLE_TASK_UNSUPPORTED
+#endif
+
+/* 句柄声明 ------------------------------------------------------------------*/
+#define SCHED_SYSTEM_TASK_DECLARE(name, prio, queueLen, initial, period) \
+    extern SchedTaskHandle_t name;
+#define SCHED_SYSTEM_ALARM_DECLARE(name, task, sig, msg) \
+    extern SchedAlarmHandle_t name;
+#define SCHED_SYSTEM_DAEMON_DECLARE(name, func, prio) \
+    extern SchedDaemonHandle_t name;
+
+#if SCHED_TASK_EN
+SCHED_SYSTEM_TASKS(SCHED_SYSTEM_TASK_DECLARE)
+SCHED_SYSTEM_TABLE_TASKS(SCHED_SYSTEM_TASK_DECLARE)
+#endif
+#if SCHED_TASK_EN && SCHED_TASK_ALARM_EN
+SCHED_SYSTEM_ALARMS(SCHED_SYSTEM_ALARM_DECLARE)
+#endif
+#if SCHED_DAEMON_EN
+SCHED_SYSTEM_DAEMONS(SCHED_SYSTEM_DAEMON_DECLARE)
+#endif
+
+#undef SCHED_SYSTEM_TASK_DECLARE
+#undef SCHED_SYSTEM_ALARM_DECLARE
+#undef SCHED_SYSTEM_DAEMON_DECLARE
+
+/*创建系统描述中的所有对象, 仅允许在sched_Init()之后、sched_Start()之前调用一次*/
+void sched_SystemCreate(void);
+
+/* 生成定义 ------------------------------------------------------------------*/
+#ifdef SCHED_SYSTEM_IMPLEMENTATION
+
+/*使能任务表时任务控制块存放在调度器的任务表中*/
+#if SCHED_TASK_TABLE_EN
+    #define SCHED_SYSTEM_TASK_BUF(name)     ( NULL )
+    #define SCHED_SYSTEM_TASK_STORAGE(name)
+#else
+    #define SCHED_SYSTEM_TASK_BUF(name)     ( &name##_TaskBuf )
+    #define SCHED_SYSTEM_TASK_STORAGE(name) static SchedTaskStatic_t name##_TaskBuf;
+#endif
+
+/*使用消息队列时队列长度必须大于0, 不使用节点池时消息队列需要存储空间*/
+#if SCHED_TASK_EVENT_METHOD >= 1
+    #define SCHED_SYSTEM_QUEUE_CHECK(name, queueLen) \
+        SCHED_STATIC_ASSERT((queueLen) > 0, name##_queue_len_is_zero);
+#else
+    #define SCHED_SYSTEM_QUEUE_CHECK(name, queueLen)
+#endif
+#if (SCHED_TASK_EVENT_METHOD >= 1) && !SCHED_EVENT_POOL_EN
+    #define SCHED_SYSTEM_QUEUE_BUF(name)    ( name##_QueueBuf )
+    #define SCHED_SYSTEM_QUEUE_STORAGE(name, queueLen) \
+        static SchedEvent_t name##_QueueBuf[SCHED_TASK_QUEUE_BUF_LEN(queueLen)];
+#else
+    #define SCHED_SYSTEM_QUEUE_BUF(name)    ( NULL )
+    #define SCHED_SYSTEM_QUEUE_STORAGE(name, queueLen)
+#endif
+
+/*未使能周期循环信号时周期必须为0*/
+#if SCHED_TASK_CYCLE_EN
+    #define SCHED_SYSTEM_PERIOD_CHECK(name, period)
+#else
+    #define SCHED_SYSTEM_PERIOD_CHECK(name, period) \
+        SCHED_STATIC_ASSERT(0 == (period), name##_period_requires_SCHED_TASK_CYCLE_EN);
+#endif
+
+/*使能守护任务调用队列时调用队列需要存储空间*/
+#if SCHED_DAEMON_QUEUE_EN
+    #define SCHED_SYSTEM_DAEMON_QUEUE_BUF(name)     ( name##_QueueBuf )
+    #define SCHED_SYSTEM_DAEMON_QUEUE_STORAGE(name) \
+        static SchedDaemonQueueItem_t name##_QueueBuf[SCHED_DAEMON_QUEUE_BUF_LEN];
+#else
+    #define SCHED_SYSTEM_DAEMON_QUEUE_BUF(name)     ( NULL )
+    #define SCHED_SYSTEM_DAEMON_QUEUE_STORAGE(name)
+#endif
+
+#define SCHED_SYSTEM_TASK_DEFINE(name, prio, queueLen, initial, period) \
+    SCHED_SYSTEM_QUEUE_CHECK(name, queueLen) \
+    SCHED_SYSTEM_PERIOD_CHECK(name, period) \
+    SchedTaskHandle_t name; \
+    SCHED_SYSTEM_TASK_STORAGE(name) \
+    SCHED_SYSTEM_QUEUE_STORAGE(name, queueLen)
+#define SCHED_SYSTEM_ALARM_DEFINE(name, task, sig, msg) \
+    SchedAlarmHandle_t name; \
+    static SchedAlarmStatic_t name##_AlarmBuf;
+#define SCHED_SYSTEM_DAEMON_DEFINE(name, func, prio) \
+    SchedDaemonHandle_t name; \
+    static SchedDaemonStatic_t name##_DaemonBuf; \
+    SCHED_SYSTEM_DAEMON_QUEUE_STORAGE(name)
+
+#if SCHED_TASK_EN
+SCHED_SYSTEM_TASKS(SCHED_SYSTEM_TASK_DEFINE)
+SCHED_SYSTEM_TABLE_TASKS(SCHED_SYSTEM_TASK_DEFINE)
+#endif
+#if SCHED_TASK_EN && SCHED_TASK_ALARM_EN
+SCHED_SYSTEM_ALARMS(SCHED_SYSTEM_ALARM_DEFINE)
+#endif
+#if SCHED_DAEMON_EN
+SCHED_SYSTEM_DAEMONS(SCHED_SYSTEM_DAEMON_DEFINE)
+#endif
+
+/*周期循环信号*/
+#if SCHED_TASK_CYCLE_EN
+    #define SCHED_SYSTEM_TASK_CYCLE(name, period) \
+        if ((period) > 0) { sched_TaskSetCyclePeriod(name, (period), SCHED_FALSE); }
+#else
+    #define SCHED_SYSTEM_TASK_CYCLE(name, period)
+#endif
+
+#define SCHED_SYSTEM_TASK_CREATE(name, prio, queueLen, initial, period) \
+    name = sched_TaskCreateStatic((prio), (queueLen), (initial), SCHED_SYSTEM_TASK_BUF(name), \
+                                  SCHED_SYSTEM_QUEUE_BUF(name)); \
+    SCHED_SYSTEM_TASK_CYCLE(name, period)
+#define SCHED_SYSTEM_TABLE_TASK_CREATE(name, prio, queueLen, table, period) \
+    name = sched_TaskCreateTableStatic((prio), (queueLen), (table), SCHED_SYSTEM_TASK_BUF(name), \
+                                       SCHED_SYSTEM_QUEUE_BUF(name)); \
+    SCHED_SYSTEM_TASK_CYCLE(name, period)
+#define SCHED_SYSTEM_ALARM_CREATE(name, task, sig, msg) \
+    name = sched_AlarmCreateStatic((task), (sig), (msg), &name##_AlarmBuf);
+#if SCHED_DAEMON_PRIO_EN
+    #define SCHED_SYSTEM_DAEMON_CREATE(name, func, prio) \
+        name = sched_DaemonCreatePrioStatic((func), (prio), &name##_DaemonBuf, \
+                                            SCHED_SYSTEM_DAEMON_QUEUE_BUF(name));
+#else
+    #define SCHED_SYSTEM_DAEMON_CREATE(name, func, prio) \
+        name = sched_DaemonCreateStatic((func), &name##_DaemonBuf, \
+                                        SCHED_SYSTEM_DAEMON_QUEUE_BUF(name));
+#endif
+
+/**
+ * 创建系统描述中的所有对象, 先创建任务, 再创建闹钟和守护任务,
+ * 任务的初始转移在sched_Start()中执行
+ */
+void sched_SystemCreate(void)
+{
+#if SCHED_TASK_EN
+    SCHED_SYSTEM_TASKS(SCHED_SYSTEM_TASK_CREATE)
+#if SCHED_FSM_TABLE_EN
+    SCHED_SYSTEM_TABLE_TASKS(SCHED_SYSTEM_TABLE_TASK_CREATE)
+#endif
+#endif
+#if SCHED_TASK_EN && SCHED_TASK_ALARM_EN
+    SCHED_SYSTEM_ALARMS(SCHED_SYSTEM_ALARM_CREATE)
+#endif
+#if SCHED_DAEMON_EN
+    SCHED_SYSTEM_DAEMONS(SCHED_SYSTEM_DAEMON_CREATE)
+#endif
+}
+
+#undef SCHED_SYSTEM_TASK_DEFINE
+#undef SCHED_SYSTEM_ALARM_DEFINE
+#undef SCHED_SYSTEM_DAEMON_DEFINE
+#undef SCHED_SYSTEM_TASK_CREATE
+#undef SCHED_SYSTEM_TABLE_TASK_CREATE
+#undef SCHED_SYSTEM_ALARM_CREATE
+#undef SCHED_SYSTEM_DAEMON_CREATE
+
+#endif  /* SCHED_SYSTEM_IMPLEMENTATION */
+
+#endif  /* __SCHED_SYSTEM_H */
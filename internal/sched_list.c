@@ -1,129 +1,208 @@
-/*******************************************************************************
-* 文 件 名: sched_list.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-25
-* 文件说明: 实现事件驱动调度器的内部数据结构 - 对象管理链表
-*******************************************************************************/
-
-#include "sched_internal.h"
-/*******************************************************************************
-
-                                    操作函数
-
-*******************************************************************************/
-
-/**
- * 初始化链表或者链表项
- *
- * @param pList: 待初始化的链表或链表项指针
- *
- * @param type: 初始化对象类型
- */
-void internal_ListInit(SchedList_t *pList, SchedBase_t type)
-{
-    pList->next  = pList;
-    pList->prev  = pList;
-    pList->type  = type;
-    pList->value = SCHED_MAX_TICK;
-}
-
-/**
- * 按照排序值从小到大的顺序, 向指定的链表插入链表项
- *
- * @param pList: 指定链表指针
- *
- * @param pListItem: 待插入的链表项指针
- */
-void internal_ListInsert(SchedList_t *pList, SchedList_t *pListItem)
-{
-SchedList_t *pInterator;
-SchedTick_t const insertValue = pListItem->value;
-
-    SCHED_ASSERT(internal_ListIsEmpty(pListItem),errSCHED_LIST_ERROR);
-    SCHED_ASSERT(SCHED_LIST_HEAD != pListItem->type,errSCHED_LIST_ERROR);
-    SCHED_ASSERT(SCHED_LIST_HEAD == pList->type,errSCHED_LIST_ERROR);
-    SCHED_ASSERT(SCHED_MAX_TICK == pList->value,errSCHED_LIST_ERROR);
-
-    if (SCHED_MAX_TICK == insertValue)
-    {
-        pInterator = pList->prev;
-    }
-    else
-    {
-        /*
-            1. if pList->next->value > insetValue  ==> pInterator = pList
-            2. if pList->next->value <= insetValue ==> pInterator->value <= inserValue and pInterator->next->value > insetValue
-        */
-        for (pInterator = pList;pInterator->next->value <= insertValue;pInterator = pInterator->next)
-        {
-        }
-    }
-    pListItem->next       = pInterator->next;
-    pListItem->prev       = pInterator;
-    pListItem->next->prev = pListItem;
-    pInterator->next      = pListItem;
-}
-
-/**
- * 向指定的链表尾部插入链表项
- *
- * @param pList: 指定链表指针
- *
- * @param pListItem: 待插入的链表项指针
- */
-void internal_ListInsertEnd(SchedList_t *pList, SchedList_t *pListItem)
-{
-    SCHED_ASSERT(internal_ListIsEmpty(pListItem),errSCHED_LIST_ERROR);
-    SCHED_ASSERT(SCHED_LIST_HEAD != pListItem->type,errSCHED_LIST_ERROR);
-    SCHED_ASSERT(SCHED_LIST_HEAD == pList->type,errSCHED_LIST_ERROR);
-    SCHED_ASSERT(SCHED_MAX_TICK == pList->value,errSCHED_LIST_ERROR);
-
-    pListItem->next       = pList;
-    pListItem->prev       = pList->prev;
-    pListItem->prev->next = pListItem;
-    pList->prev           = pListItem;
-}
-
-/**
- * 移除指定链表项
- *
- * @param pListItem: 待移除的链表项指针
- */
-void internal_ListRemove(SchedList_t *pListItem)
-{
-    SCHED_ASSERT(SCHED_LIST_HEAD != pListItem->type,errSCHED_LIST_ERROR);
-    SCHED_ASSERT(NULL != pListItem->prev,errSCHED_LIST_ERROR);
-    SCHED_ASSERT(NULL != pListItem->next,errSCHED_LIST_ERROR);
-
-    pListItem->prev->next = pListItem->next;
-    pListItem->next->prev = pListItem->prev;
-    pListItem->next       = pListItem;
-    pListItem->prev       = pListItem;
-}
-
-/**
- * 判断链表是否为空或者链表项是否为孤立链表项
- *
- * @param pList: 链表或者链表项指针
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
- *          SCHED_FALSE 表示链表非空或者链表项不是孤立的,
- *          SCHED_TRUE  表示链表为空或者链表项是孤立的
- */
-SchedBool_t internal_ListIsEmpty(SchedList_t *pList)
-{
-SchedBool_t ret;
-
-    if (pList->next == pList)
-    {
-        SCHED_ASSERT(pList->prev == pList,errSCHED_LIST_ERROR);
-        ret = SCHED_TRUE;
-    }
-    else
-    {
-        SCHED_ASSERT(pList->prev != pList,errSCHED_LIST_ERROR);
-        ret = SCHED_FALSE;
-    }
-    return (ret);
-}
+/*******************************************************************************
+* 文 件 名: sched_list.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-25
+* 文件说明: 实现事件驱动调度器的内部数据结构 - 对象管理链表
+*******************************************************************************/
+
+#include "sched_internal.h"
+
+#if SCHED_LIST_COMPACT_EN
+static SchedListLink_t prvListLink(SchedList_t *pFrom, SchedList_t *pTo);
+
+/*设置链表后一项和前一项*/
+#define prvListSetNext(pList, pNext)    ( (pList)->next = prvListLink((pList), (pNext)) )
+#define prvListSetPrev(pList, pPrev)    ( (pList)->prev = prvListLink((pList), (pPrev)) )
+#else
+#define prvListSetNext(pList, pNext)    ( (pList)->next = (pNext) )
+#define prvListSetPrev(pList, pPrev)    ( (pList)->prev = (pPrev) )
+#endif
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+
+/**
+ * 初始化链表或者链表项
+ *
+ * @param pList: 待初始化的链表或链表项指针
+ *
+ * @param type: 初始化对象类型
+ */
+void internal_ListInit(SchedList_t *pList, SchedBase_t type)
+{
+    prvListSetNext(pList, pList);
+    prvListSetPrev(pList, pList);
+    pList->type  = type;
+    pList->value = SCHED_MAX_TICK;
+}
+
+/**
+ * 按照排序值从小到大的顺序, 向指定的链表插入链表项
+ *
+ * @param pList: 指定链表指针
+ *
+ * @param pListItem: 待插入的链表项指针
+ */
+void internal_ListInsert(SchedList_t *pList, SchedList_t *pListItem)
+{
+SchedList_t *pInterator;
+SchedList_t *pNext;
+SchedTick_t const insertValue = pListItem->value;
+
+    SCHED_ASSERT(internal_ListIsEmpty(pListItem),errSCHED_LIST_ERROR);
+    SCHED_ASSERT(SCHED_LIST_HEAD != pListItem->type,errSCHED_LIST_ERROR);
+    SCHED_ASSERT(SCHED_LIST_HEAD == pList->type,errSCHED_LIST_ERROR);
+    SCHED_ASSERT(SCHED_MAX_TICK == pList->value,errSCHED_LIST_ERROR);
+
+    if (SCHED_MAX_TICK == insertValue)
+    {
+        pInterator = internal_ListPrev(pList);
+    }
+    else
+    {
+        /*
+            1. if pList->next->value > insetValue  ==> pInterator = pList
+            2. if pList->next->value <= insetValue ==> pInterator->value <= inserValue and pInterator->next->value > insetValue
+        */
+        for (pInterator = pList;internal_ListNext(pInterator)->value <= insertValue;pInterator = internal_ListNext(pInterator))
+        {
+        }
+    }
+    pNext = internal_ListNext(pInterator);
+    prvListSetNext(pListItem, pNext);
+    prvListSetPrev(pListItem, pInterator);
+    prvListSetPrev(pNext, pListItem);
+    prvListSetNext(pInterator, pListItem);
+}
+
+/**
+ * 向指定的链表尾部插入链表项
+ *
+ * @param pList: 指定链表指针
+ *
+ * @param pListItem: 待插入的链表项指针
+ */
+void internal_ListInsertEnd(SchedList_t *pList, SchedList_t *pListItem)
+{
+SchedList_t *pPrev;
+
+    SCHED_ASSERT(internal_ListIsEmpty(pListItem),errSCHED_LIST_ERROR);
+    SCHED_ASSERT(SCHED_LIST_HEAD != pListItem->type,errSCHED_LIST_ERROR);
+    SCHED_ASSERT(SCHED_LIST_HEAD == pList->type,errSCHED_LIST_ERROR);
+    SCHED_ASSERT(SCHED_MAX_TICK == pList->value,errSCHED_LIST_ERROR);
+
+    pPrev = internal_ListPrev(pList);
+    prvListSetNext(pListItem, pList);
+    prvListSetPrev(pListItem, pPrev);
+    prvListSetNext(pPrev, pListItem);
+    prvListSetPrev(pList, pListItem);
+}
+
+/**
+ * 移除指定链表项
+ *
+ * @param pListItem: 待移除的链表项指针
+ */
+void internal_ListRemove(SchedList_t *pListItem)
+{
+SchedList_t *pNext;
+SchedList_t *pPrev;
+
+    SCHED_ASSERT(SCHED_LIST_HEAD != pListItem->type,errSCHED_LIST_ERROR);
+#if !SCHED_LIST_COMPACT_EN
+    SCHED_ASSERT(NULL != pListItem->prev,errSCHED_LIST_ERROR);
+    SCHED_ASSERT(NULL != pListItem->next,errSCHED_LIST_ERROR);
+#endif
+
+    pNext = internal_ListNext(pListItem);
+    pPrev = internal_ListPrev(pListItem);
+    prvListSetNext(pPrev, pNext);
+    prvListSetPrev(pNext, pPrev);
+    prvListSetNext(pListItem, pListItem);
+    prvListSetPrev(pListItem, pListItem);
+}
+
+/**
+ * 移除并返回链表的第一个链表项
+ *
+ * @param pList: 链表指针
+ *
+ * @return: 若链表非空, 返回被移除的链表项指针, 总是不同于链表头
+ *          若链表为空, 返回NULL
+ */
+SchedList_t *internal_ListRemoveFirst(SchedList_t *pList)
+{
+SchedList_t *pListItem = NULL;
+
+    SCHED_ASSERT(SCHED_LIST_HEAD == pList->type,errSCHED_LIST_ERROR);
+
+    if (SCHED_FALSE == internal_ListIsEmpty(pList))
+    {
+        pListItem = internal_ListNext(pList);
+        internal_ListRemove(pListItem);
+    }
+    return (pListItem);
+}
+
+/**
+ * 判断链表是否为空或者链表项是否为孤立链表项
+ *
+ * @param pList: 链表或者链表项指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_FALSE 表示链表非空或者链表项不是孤立的,
+ *          SCHED_TRUE  表示链表为空或者链表项是孤立的
+ */
+SchedBool_t internal_ListIsEmpty(SchedList_t *pList)
+{
+SchedBool_t ret;
+
+    if (internal_ListNext(pList) == pList)
+    {
+        SCHED_ASSERT(internal_ListPrev(pList) == pList,errSCHED_LIST_ERROR);
+        ret = SCHED_TRUE;
+    }
+    else
+    {
+        SCHED_ASSERT(internal_ListPrev(pList) != pList,errSCHED_LIST_ERROR);
+        ret = SCHED_FALSE;
+    }
+    return (ret);
+}
+
+#if SCHED_LIST_COMPACT_EN
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+
+/**
+ * 计算紧凑链表项之间的相对偏移量
+ *
+ * @param pFrom: 保存偏移量的链表项指针
+ *
+ * @param pTo: 偏移量指向的链表项指针
+ *
+ * @return: 以链表项对齐单位计的偏移量
+ *
+ * @note: 偏移量超出16位范围是不可恢复的配置错误(对象存储空间相距过远),
+ *        不依赖SCHED_ASSERT_EN, 总是调用错误处理函数, 错误处理函数不应返回
+ */
+static SchedListLink_t prvListLink(SchedList_t *pFrom, SchedList_t *pTo)
+{
+ptrdiff_t diff;
+
+    diff = (char *)pTo - (char *)pFrom;
+    SCHED_ASSERT(0 == diff % SCHED_LIST_LINK_UNIT,errSCHED_LIST_ERROR);
+    diff /= SCHED_LIST_LINK_UNIT;
+    if ((diff < INT16_MIN) || (diff > INT16_MAX))
+    {
+        sched_PortErrorHandler(errSCHED_LIST_LINK_OUT_OF_RANGE);
+    }
+    return ((SchedListLink_t)diff);
+}
+#endif
@@ -1,141 +1,370 @@
-/*******************************************************************************
-* 文 件 名: sched_priotbl.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-25
-* 文件说明: 实现事件驱动调度器的内部数据结构 - 优先级记录表
-*******************************************************************************/
-
-#include "sched_internal.h"
-/*******************************************************************************
-
-                                    全局数组
-
-*******************************************************************************/
-static uint8_t const FLASH_DATA priotbl_unmap[] =
-{
-    0u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x00 to 0x0F */
-    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x10 to 0x1F */
-    5u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x20 to 0x2F */
-    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x30 to 0x3F */
-    6u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x40 to 0x4F */
-    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x50 to 0x5F */
-    5u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x60 to 0x6F */
-    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x70 to 0x7F */
-    7u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x80 to 0x8F */
-    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x90 to 0x9F */
-    5u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xA0 to 0xAF */
-    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xB0 to 0xBF */
-    6u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xC0 to 0xCF */
-    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xD0 to 0xDF */
-    5u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xE0 to 0xEF */
-    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u  /* 0xF0 to 0xFF */
-};
-
-/*******************************************************************************
-
-                                    操作函数
-
-*******************************************************************************/
-
-/**
- * 初始化优先级记录表
- *
- * @param tbl: 待初始化的优先级记录表指针
- */
-void internal_PriotblInit(SchedPrioTable_t *tbl)
-{
-uint8_t i;
-
-    for (i=0;i<SCHED_PRIOTBL_TABLE_SIZE;i++)
-    {
-        tbl->tbl[i] = 0;
-    }
-    tbl->grp = 0;
-}
-
-/**
- * 在优先级记录表中记录一个优先级
- *
- * @param tbl: 目标优先级记录表指针
- *
- * @param prio: 记录的优先级, 有效范围是0 - SCHED_PRIOTBL_LOWEST_PRIO
- */
-void internal_PriotblRecordPrio(SchedPrioTable_t *tbl, uint8_t prio)
-{
-    SCHED_ASSERT(prio<=SCHED_PRIOTBL_LOWEST_PRIO,errSCHED_PRIOTBL_ERROR);
-    if (prio <= SCHED_PRIOTBL_LOWEST_PRIO)
-    {
-    uint8_t x = prio&0x7;
-    uint8_t y = prio>>3;
-
-        tbl->tbl[y] |= (uint8_t)1<<x;
-        tbl->grp    |= (uint8_t)1<<y;
-    }
-}
-
-/**
- * 在优先级记录表中清除一个优先级
- *
- * @param tbl: 目标优先级记录表指针
- *
- * @param prio: 清除的优先级, 有效范围是0 - SCHED_PRIOTBL_LOWEST_PRIO
- */
-void internal_PriotblResetPrio(SchedPrioTable_t *tbl, uint8_t prio)
-{
-    SCHED_ASSERT(prio<=SCHED_PRIOTBL_LOWEST_PRIO,errSCHED_PRIOTBL_ERROR);
-    if (prio <= SCHED_PRIOTBL_LOWEST_PRIO)
-    {
-    uint8_t x = prio&0x7;
-    uint8_t y = prio>>3;
-
-        tbl->tbl[y]  &= ~((uint8_t)1<<x);
-        if (0 == tbl->tbl[y])
-        {
-            tbl->grp &= ~((uint8_t)1<<y);
-        }
-    }
-}
-
-/**
- * 判断优先级记录表是否为空
- *
- * @param tbl: 目标优先级记录表指针
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
- *          SCHED_TRUE  表示优先级记录表为空
- *          SCHED_FALSE 表示优先级记录表不空
- */
-SchedBool_t internal_PriotblIsEmpty(SchedPrioTable_t const *tbl)
-{
-    if (0 == tbl->grp)
-    {
-        return (SCHED_TRUE);
-    }
-    else
-    {
-        return (SCHED_FALSE);
-    }
-}
-
-/**
- * 获取优先级记录表中的最高优先级
- *
- * @param tbl: 目标优先级记录表指针
- *
- * @return: 如果优先级记录表非空, 返回最高优先级,
- *          如果优先级记录表为空, 返回0
- *
- * @note: 在调用本函数获取最高优先级之前, 确保优先级记录表非空
- */
-uint8_t internal_PriotblGetHighestPrio(SchedPrioTable_t const *tbl)
-{
-uint8_t prio;
-uint8_t x,y;
-
-    y = priotbl_unmap[tbl->grp];
-    SCHED_ASSERT(y<SCHED_PRIOTBL_TABLE_SIZE,errSCHED_PRIOTBL_ERROR);
-    x = priotbl_unmap[tbl->tbl[y]];
-    prio = x + (y<<3);
-    return (prio);
-}
+/*******************************************************************************
+* 文 件 名: sched_priotbl.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-25
+* 文件说明: 实现事件驱动调度器的内部数据结构 - 优先级记录表
+*******************************************************************************/
+
+#include "sched_internal.h"
+/*******************************************************************************
+
+                                    全局数组
+
+*******************************************************************************/
+static uint8_t const FLASH_DATA priotbl_unmap[] =
+{
+    0u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x00 to 0x0F */
+    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x10 to 0x1F */
+    5u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x20 to 0x2F */
+    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x30 to 0x3F */
+    6u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x40 to 0x4F */
+    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x50 to 0x5F */
+    5u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x60 to 0x6F */
+    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x70 to 0x7F */
+    7u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x80 to 0x8F */
+    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0x90 to 0x9F */
+    5u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xA0 to 0xAF */
+    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xB0 to 0xBF */
+    6u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xC0 to 0xCF */
+    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xD0 to 0xDF */
+    5u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, /* 0xE0 to 0xEF */
+    4u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u  /* 0xF0 to 0xFF */
+};
+
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+
+/**
+ * 初始化优先级记录表
+ *
+ * @param tbl: 待初始化的优先级记录表指针
+ */
+void internal_PriotblInit(SchedPrioTable_t *tbl)
+{
+uint8_t i;
+
+    for (i=0;i<SCHED_PRIOTBL_TABLE_SIZE;i++)
+    {
+        tbl->tbl[i] = 0;
+    }
+    tbl->grp = 0;
+}
+
+/**
+ * 在优先级记录表中记录一个优先级
+ *
+ * @param tbl: 目标优先级记录表指针
+ *
+ * @param prio: 记录的优先级, 有效范围是0 - SCHED_PRIOTBL_LOWEST_PRIO
+ */
+void internal_PriotblRecordPrio(SchedPrioTable_t *tbl, uint8_t prio)
+{
+    SCHED_ASSERT(prio<=SCHED_PRIOTBL_LOWEST_PRIO,errSCHED_PRIOTBL_ERROR);
+    if (prio <= SCHED_PRIOTBL_LOWEST_PRIO)
+    {
+    uint8_t x = prio&0x7;
+    uint8_t y = prio>>3;
+
+        tbl->tbl[y] |= (uint8_t)1<<x;
+        tbl->grp    |= (uint8_t)1<<y;
+    }
+}
+
+/**
+ * 在优先级记录表中清除一个优先级
+ *
+ * @param tbl: 目标优先级记录表指针
+ *
+ * @param prio: 清除的优先级, 有效范围是0 - SCHED_PRIOTBL_LOWEST_PRIO
+ */
+void internal_PriotblResetPrio(SchedPrioTable_t *tbl, uint8_t prio)
+{
+    SCHED_ASSERT(prio<=SCHED_PRIOTBL_LOWEST_PRIO,errSCHED_PRIOTBL_ERROR);
+    if (prio <= SCHED_PRIOTBL_LOWEST_PRIO)
+    {
+    uint8_t x = prio&0x7;
+    uint8_t y = prio>>3;
+
+        tbl->tbl[y]  &= ~((uint8_t)1<<x);
+        if (0 == tbl->tbl[y])
+        {
+            tbl->grp &= ~((uint8_t)1<<y);
+        }
+    }
+}
+
+/**
+ * 判断优先级记录表是否为空
+ *
+ * @param tbl: 目标优先级记录表指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示优先级记录表为空
+ *          SCHED_FALSE 表示优先级记录表不空
+ */
+SchedBool_t internal_PriotblIsEmpty(SchedPrioTable_t const *tbl)
+{
+    if (0 == tbl->grp)
+    {
+        return (SCHED_TRUE);
+    }
+    else
+    {
+        return (SCHED_FALSE);
+    }
+}
+
+/**
+ * 获取优先级记录表中的最高优先级
+ *
+ * @param tbl: 目标优先级记录表指针
+ *
+ * @return: 如果优先级记录表非空, 返回最高优先级,
+ *          如果优先级记录表为空, 返回0
+ *
+ * @note: 在调用本函数获取最高优先级之前, 确保优先级记录表非空
+ */
+uint8_t internal_PriotblGetHighestPrio(SchedPrioTable_t const *tbl)
+{
+uint8_t prio;
+uint8_t x,y;
+
+    y = priotbl_unmap[tbl->grp];
+    SCHED_ASSERT(y<SCHED_PRIOTBL_TABLE_SIZE,errSCHED_PRIOTBL_ERROR);
+    x = priotbl_unmap[tbl->tbl[y]];
+    prio = x + (y<<3);
+    return (prio);
+}
+
+#if SCHED_SIGMASK_METHOD
+/**
+ * 获取优先级记录表中未被屏蔽的最高优先级
+ *
+ * @param tbl: 目标优先级记录表指针
+ *
+ * @param mask: 屏蔽字, 第n位为0表示屏蔽优先级n, 优先级32以上不受屏蔽
+ *
+ * @param prio: 保存结果的指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示获取成功
+ *          SCHED_FALSE 表示没有未被屏蔽的优先级
+ */
+SchedBool_t internal_PriotblGetMaskedPrio(SchedPrioTable_t const *tbl, uint32_t mask, uint8_t *prio)
+{
+SchedBool_t ret = SCHED_FALSE;
+uint8_t x,y;
+
+    /*屏蔽字覆盖的优先级逐行查找*/
+    for (y=0;(y<4)&&(y<SCHED_PRIOTBL_TABLE_SIZE);y++)
+    {
+        x = tbl->tbl[y] & (uint8_t)(mask>>(y<<3));
+        if (0 != x)
+        {
+            *prio = priotbl_unmap[x] + (y<<3);
+            ret = SCHED_TRUE;
+            break;
+        }
+    }
+    /*不受屏蔽的优先级按组查找*/
+    if ((SCHED_FALSE == ret) && (0 != (tbl->grp & 0xF0)))
+    {
+        y = priotbl_unmap[tbl->grp & 0xF0];
+        SCHED_ASSERT(y<SCHED_PRIOTBL_TABLE_SIZE,errSCHED_PRIOTBL_ERROR);
+        *prio = priotbl_unmap[tbl->tbl[y]] + (y<<3);
+        ret = SCHED_TRUE;
+    }
+    return (ret);
+}
+#endif
+
+#if SCHED_SIGTBL_EXT_EN
+/*******************************************************************************
+
+                                 多级信号记录表
+
+*******************************************************************************/
+/*顶层位图为8位, 每位对应8个位图字节, 信号数量最多为8*8*8个*/
+SCHED_STATIC_ASSERT((SCHED_SIGTBL_SIG_NUM > 0) && (SCHED_SIGTBL_GRP_SIZE <= 8), sched_sigtbl_sig_num_out_of_range);
+
+/*
+    将由位图查得的组号和行号限制在位图范围内, 位图一致时不改变结果,
+    位图被破坏且未使能断言时也不会越界访问
+*/
+#define prvSigtblGrpIndex(z)    ( (uint16_t)(((z) < SCHED_SIGTBL_GRP_SIZE) ? (z) : (SCHED_SIGTBL_GRP_SIZE-1)) )
+#define prvSigtblTblIndex(y)    ( (uint16_t)(((y) < SCHED_SIGTBL_TBL_SIZE) ? (y) : (SCHED_SIGTBL_TBL_SIZE-1)) )
+
+/**
+ * 初始化多级信号记录表
+ *
+ * @param tbl: 待初始化的多级信号记录表指针
+ */
+void internal_SigtblInit(SchedSigTable_t *tbl)
+{
+uint16_t i;
+
+    for (i=0;i<SCHED_SIGTBL_TBL_SIZE;i++)
+    {
+        tbl->tbl[i] = 0;
+    }
+    for (i=0;i<SCHED_SIGTBL_GRP_SIZE;i++)
+    {
+        tbl->grp[i] = 0;
+    }
+    tbl->top = 0;
+}
+
+/**
+ * 在多级信号记录表中记录一个信号
+ *
+ * @param tbl: 目标多级信号记录表指针
+ *
+ * @param sig: 记录的信号, 有效范围是0 - SCHED_SIGTBL_SIG_NUM-1
+ */
+void internal_SigtblRecordSig(SchedSigTable_t *tbl, uint16_t sig)
+{
+    SCHED_ASSERT(sig<SCHED_SIGTBL_SIG_NUM,errSCHED_PRIOTBL_ERROR);
+    if (sig < SCHED_SIGTBL_SIG_NUM)
+    {
+    uint16_t y = sig>>3;
+    uint16_t z = sig>>6;
+
+        tbl->tbl[y] |= (uint8_t)1<<(sig&0x7);
+        tbl->grp[z] |= (uint8_t)1<<(y&0x7);
+        tbl->top    |= (uint8_t)1<<z;
+    }
+}
+
+/**
+ * 在多级信号记录表中清除一个信号
+ *
+ * @param tbl: 目标多级信号记录表指针
+ *
+ * @param sig: 清除的信号, 有效范围是0 - SCHED_SIGTBL_SIG_NUM-1
+ */
+void internal_SigtblResetSig(SchedSigTable_t *tbl, uint16_t sig)
+{
+    SCHED_ASSERT(sig<SCHED_SIGTBL_SIG_NUM,errSCHED_PRIOTBL_ERROR);
+    if (sig < SCHED_SIGTBL_SIG_NUM)
+    {
+    uint16_t y = sig>>3;
+    uint16_t z = sig>>6;
+
+        tbl->tbl[y] &= ~((uint8_t)1<<(sig&0x7));
+        if (0 == tbl->tbl[y])
+        {
+            tbl->grp[z] &= ~((uint8_t)1<<(y&0x7));
+            if (0 == tbl->grp[z])
+            {
+                tbl->top &= ~((uint8_t)1<<z);
+            }
+        }
+    }
+}
+
+/**
+ * 判断多级信号记录表是否为空
+ *
+ * @param tbl: 目标多级信号记录表指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示多级信号记录表为空
+ *          SCHED_FALSE 表示多级信号记录表不空
+ */
+SchedBool_t internal_SigtblIsEmpty(SchedSigTable_t const *tbl)
+{
+    if (0 == tbl->top)
+    {
+        return (SCHED_TRUE);
+    }
+    else
+    {
+        return (SCHED_FALSE);
+    }
+}
+
+/**
+ * 获取多级信号记录表中的最高优先级信号(数值最小的信号)
+ *
+ * @param tbl: 目标多级信号记录表指针
+ *
+ * @return: 如果多级信号记录表非空, 返回最高优先级信号,
+ *          如果多级信号记录表为空, 返回0
+ *
+ * @note: 在调用本函数获取最高优先级信号之前, 确保多级信号记录表非空
+ */
+uint16_t internal_SigtblGetHighestSig(SchedSigTable_t const *tbl)
+{
+uint16_t x,y,z;
+
+    z = priotbl_unmap[tbl->top];
+    SCHED_ASSERT(z<SCHED_SIGTBL_GRP_SIZE,errSCHED_PRIOTBL_ERROR);
+    z = prvSigtblGrpIndex(z);
+    y = priotbl_unmap[tbl->grp[z]] + (z<<3);
+    SCHED_ASSERT(y<SCHED_SIGTBL_TBL_SIZE,errSCHED_PRIOTBL_ERROR);
+    y = prvSigtblTblIndex(y);
+    x = priotbl_unmap[tbl->tbl[y]];
+    return ((uint16_t)(x + (y<<3)));
+}
+
+#if SCHED_SIGMASK_METHOD
+/**
+ * 获取多级信号记录表中未被屏蔽的最高优先级信号
+ *
+ * @param tbl: 目标多级信号记录表指针
+ *
+ * @param mask: 屏蔽字, 第n位为0表示屏蔽信号n, 信号32以上不受屏蔽
+ *
+ * @param sig: 保存结果的指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示获取成功
+ *          SCHED_FALSE 表示没有未被屏蔽的信号
+ */
+SchedBool_t internal_SigtblGetMaskedSig(SchedSigTable_t const *tbl, uint32_t mask, uint16_t *sig)
+{
+SchedBool_t ret = SCHED_FALSE;
+uint16_t x,y,z;
+
+    /*屏蔽字覆盖的信号逐行查找*/
+    for (y=0;(y<4)&&(y<SCHED_SIGTBL_TBL_SIZE);y++)
+    {
+        x = tbl->tbl[y] & (uint8_t)(mask>>(y<<3));
+        if (0 != x)
+        {
+            *sig = priotbl_unmap[x] + (y<<3);
+            ret = SCHED_TRUE;
+            break;
+        }
+    }
+    /*不受屏蔽的信号按组查找, 第0组只查找后4行*/
+    if (SCHED_FALSE == ret)
+    {
+        if (0 != (tbl->grp[0] & 0xF0))
+        {
+            y = priotbl_unmap[tbl->grp[0] & 0xF0];
+            ret = SCHED_TRUE;
+        }
+        else if (0 != (tbl->top & 0xFE))
+        {
+            z = priotbl_unmap[tbl->top & 0xFE];
+            SCHED_ASSERT(z<SCHED_SIGTBL_GRP_SIZE,errSCHED_PRIOTBL_ERROR);
+            z = prvSigtblGrpIndex(z);
+            y = priotbl_unmap[tbl->grp[z]] + (z<<3);
+            ret = SCHED_TRUE;
+        }
+        if (SCHED_FALSE != ret)
+        {
+            SCHED_ASSERT(y<SCHED_SIGTBL_TBL_SIZE,errSCHED_PRIOTBL_ERROR);
+            y = prvSigtblTblIndex(y);
+            *sig = (uint16_t)(priotbl_unmap[tbl->tbl[y]] + (y<<3));
+        }
+    }
+    return (ret);
+}
+#endif
+#endif  /* SCHED_SIGTBL_EXT_EN */
@@ -1,218 +1,865 @@
-/*******************************************************************************
-* 文 件 名: sched_queue.c
-* 创 建 者: Keda Huang
-* 版    本: V1.0
-* 创建日期: 2016-07-25
-* 文件说明: 实现事件驱动调度器的内部数据结构 - 消息队列
-*******************************************************************************/
-
-#include "sched_internal.h"
-
-/*******************************************************************************
-
-                                    操作函数
-
-*******************************************************************************/
-
-/**
- * 队列初始化
- *
- * @param queue: 待初始化队列的指针
- *
- * @param evtQueue: 队列Buffer数组的首元素指针
- *
- * @param len: 队列长度, 长度若为0, 参数evtQueue传入为NULL
- */
-void internal_QueueInit(SchedQueue_t *queue, SchedEvent_t *evtQueue, EvtPos_t len)
-{
-    queue->evtQueue = evtQueue;
-    queue->end      = len;
-    queue->head     = 0;
-    queue->tail     = 0;
-    queue->nUsed    = 0;
-    queue->nMaxUsed = 0;
-}
-
-/**
- * 向队列尾部插入一个事件块
- *
- * @param queue: 目标队列指针
- *
- * @param evt: 待复制的事件块指针, 事件块内容复制到队列Buffer
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
- *          SCHED_TRUE  表示事件块插入成功
- *          SCHED_FALSE 表示队列已满
- */
-SchedBool_t internal_QueueSend(SchedQueue_t *queue, SchedEvent_t const *evt)
-{
-SchedBool_t ret;
-
-    if (queue->nUsed == queue->end)
-    {
-        /*队列已满*/
-        ret = SCHED_FALSE;
-    }
-    else
-    {
-        /*插入事件块*/
-        sched_PortEventCopy(&queue->evtQueue[queue->tail++], evt);
-        if (queue->tail == queue->end)
-        {
-            queue->tail = 0;
-        }
-        queue->nUsed++;
-        if (queue->nUsed > queue->nMaxUsed)
-        {
-            queue->nMaxUsed = queue->nUsed;
-        }
-        ret = SCHED_TRUE;
-    }
-
-    return (ret);
-}
-
-/**
- * 向队列头部插入一个事件块
- *
- * @param queue: 目标队列指针
- *
- * @param evt: 待复制的事件块指针, 事件块内容复制到队列Buffer
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
- *          SCHED_TRUE  表示事件块插入成功
- *          SCHED_FALSE 表示队列已满
- */
-SchedBool_t internal_QueueSendFront(SchedQueue_t *queue, SchedEvent_t const *evt)
-{
-SchedBool_t ret;
-
-    if (queue->nUsed == queue->end)
-    {
-        /*队列已满*/
-        ret = SCHED_FALSE;
-    }
-    else
-    {
-        if (0 == queue->head)
-        {
-            queue->head = queue->end - 1;
-        }
-        else
-        {
-            queue->head--;
-        }
-        sched_PortEventCopy(&queue->evtQueue[queue->head], evt);
-        queue->nUsed++;
-        if (queue->nUsed > queue->nMaxUsed)
-        {
-            queue->nMaxUsed = queue->nUsed;
-        }
-        ret = SCHED_TRUE;
-    }
-    return (ret);
-}
-
-/**
- * 从队列头部取出一个事件块
- *
- * @param queue: 目标队列指针
- *
- * @param evt: 保存结果的事件块指针, 事件块内容从队列Buffer中复制
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
- *          SCHED_TRUE  表示事件块取出成功
- *          SCHED_FALSE 表示队列已空
- */
-SchedBool_t internal_QueueReceive(SchedQueue_t *queue, SchedEvent_t *evt)
-{
-SchedBool_t ret;
-
-    if (0 == queue->nUsed)
-    {
-        ret = SCHED_FALSE;
-    }
-    else
-    {
-        sched_PortEventCopy(evt, &queue->evtQueue[queue->head++]);
-        if (queue->head == queue->end)
-        {
-            queue->head = 0;
-        }
-        queue->nUsed--;
-        ret = SCHED_TRUE;
-    }
-    return (ret);
-}
-
-/**
- * 判断队列是否为空
- *
- * @param queue: 目标队列指针
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
- *          SCHED_TRUE  表示队列为空
- *          SCHED_FALSE 表示队列不空
- */
-SchedBool_t internal_QueueIsEmpty(SchedQueue_t *queue)
-{
-SchedBool_t ret;
-
-    if (0 == queue->nUsed)
-    {
-        ret = SCHED_TRUE;
-    }
-    else
-    {
-        ret = SCHED_FALSE;
-    }
-    return (ret);
-}
-
-/**
- * 判断队列是否已满
- *
- * @param queue: 目标队列指针
- *
- * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
- *          SCHED_TRUE  表示队列已满
- *          SCHED_FALSE 表示队列未满
- */
-SchedBool_t internal_QueueIsFull(SchedQueue_t *queue)
-{
-SchedBool_t ret;
-
-    if (queue->end == queue->nUsed)
-    {
-        ret = SCHED_TRUE;
-    }
-    else
-    {
-        ret = SCHED_FALSE;
-    }
-    return (ret);
-}
-
-/**
- * 获取队列最大使用量
- *
- * @param queue: 目标队列指针
- *
- * @return: 队列最大使用量
- */
-EvtPos_t internal_QueueGetMaxUsed(SchedQueue_t *queue)
-{
-    return (queue->nMaxUsed);
-}
-
-/**
- * 获取队列长度
- *
- * @param queue: 目标队列指针
- *
- * @return: 队列长度
- */
-EvtPos_t internal_QueueGetLength(SchedQueue_t *queue)
-{
-    return (queue->end);
-}
+/*******************************************************************************
+* 文 件 名: sched_queue.c
+* 创 建 者: Keda Huang
+* 版    本: V1.0
+* 创建日期: 2016-07-25
+* 文件说明: 实现事件驱动调度器的内部数据结构 - 消息队列
+*******************************************************************************/
+
+#include "sched_internal.h"
+
+#if SCHED_EVENT_POOL_EN
+static SchedEventNode_t * prvEventPoolAlloc(SchedEventPool_t *pool);
+static void prvEventPoolFree(SchedEventPool_t *pool, SchedEventNode_t *node);
+#endif
+#if SCHED_QUEUE_POLICY_EN
+static SchedBool_t prvQueueOverflow(SchedQueue_t *queue, SchedEvent_t const *evt);
+#endif
+#if SCHED_EVENT_CONFLATE_EN
+static void prvQueueConflateInit(SchedQueue_t *queue);
+static SchedEvent_t ** prvQueueConflateSlot(SchedQueue_t *queue, EvtSig_t sig);
+static void prvQueueConflateRelease(SchedQueue_t *queue, SchedEvent_t const *pEvent);
+#if SCHED_TASK_DEFER_EN
+static void prvQueueConflateRecall(SchedQueue_t *queue, SchedEvent_t *pEvent, uint8_t *pFresh);
+#endif
+#endif
+#if SCHED_TASK_DEFER_EN && !SCHED_EVENT_POOL_EN
+static EvtPos_t prvQueueNextPos(SchedQueue_t const *queue, EvtPos_t pos);
+static EvtPos_t prvQueuePrevPos(SchedQueue_t const *queue, EvtPos_t pos);
+#endif
+/*******************************************************************************
+
+                                    操作函数
+
+*******************************************************************************/
+#if SCHED_EVENT_POOL_EN
+/**
+ * 事件节点池初始化
+ *
+ * @param pool: 待初始化事件节点池的指针
+ *
+ * @param nodes: 事件节点数组的首元素指针
+ *
+ * @param len: 事件节点数组长度
+ */
+void internal_EventPoolInit(SchedEventPool_t *pool, SchedEventNode_t *nodes, EvtPos_t len)
+{
+EvtPos_t i;
+
+    pool->freeList = NULL;
+    for (i=len;i>0;i--)
+    {
+        nodes[i-1].next = pool->freeList;
+        pool->freeList  = &nodes[i-1];
+    }
+    pool->nFree    = len;
+    pool->nMinFree = len;
+}
+
+/**
+ * 获取事件节点池空闲节点最小量
+ *
+ * @param pool: 目标事件节点池指针
+ *
+ * @return: 空闲节点最小量, 用于评估事件节点池大小是否合适
+ */
+EvtPos_t internal_EventPoolGetMinFree(SchedEventPool_t *pool)
+{
+    return (pool->nMinFree);
+}
+
+/**
+ * 队列初始化, 队列节点从共享事件节点池中分配
+ *
+ * @param queue: 待初始化队列的指针
+ *
+ * @param pool: 队列使用的共享事件节点池指针
+ *
+ * @param len: 队列容量上限, 即队列允许占用的最大节点数量
+ */
+void internal_QueueInit(SchedQueue_t *queue, SchedEventPool_t *pool, EvtPos_t len)
+{
+    queue->pool     = pool;
+    queue->first    = NULL;
+    queue->last     = NULL;
+    queue->end      = len;
+    queue->nUsed    = 0;
+    queue->nMaxUsed = 0;
+#if SCHED_QUEUE_POLICY_EN
+    queue->policy   = SCHED_QUEUE_REJECT;
+    queue->nDropped = 0;
+#endif
+#if SCHED_EVENT_CONFLATE_EN
+    prvQueueConflateInit(queue);
+#endif
+}
+#else
+/**
+ * 队列初始化
+ *
+ * @param queue: 待初始化队列的指针
+ *
+ * @param evtQueue: 队列Buffer数组的首元素指针
+ *
+ * @param len: 队列长度, 长度若为0, 参数evtQueue传入为NULL,
+ *             若使能SCHED_QUEUE_POW2_EN, 长度必须是2的幂
+ */
+void internal_QueueInit(SchedQueue_t *queue, SchedEvent_t *evtQueue, EvtPos_t len)
+{
+#if SCHED_QUEUE_POW2_EN
+    SCHED_ASSERT(0 == (len & (EvtPos_t)(len - 1)),errSCHED_PARAM_NOT_ALLOWED);
+#endif
+    queue->evtQueue = evtQueue;
+    queue->end      = len;
+    queue->head     = 0;
+    queue->tail     = 0;
+    queue->nUsed    = 0;
+    queue->nMaxUsed = 0;
+#if SCHED_QUEUE_POLICY_EN
+    queue->policy   = SCHED_QUEUE_REJECT;
+    queue->nDropped = 0;
+#endif
+#if SCHED_EVENT_CONFLATE_EN
+    prvQueueConflateInit(queue);
+#endif
+}
+#endif
+
+/**
+ * 向队列尾部插入一个事件块
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param evt: 待复制的事件块指针, 事件块内容复制到队列Buffer
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示事件块插入成功(或者按照溢出策略合并到队列中)
+ *          SCHED_FALSE 表示队列已满
+ */
+SchedBool_t internal_QueueSend(SchedQueue_t *queue, SchedEvent_t const *evt)
+{
+SchedBool_t ret = SCHED_FALSE;
+#if SCHED_EVENT_POOL_EN
+SchedEventNode_t *pNode = NULL;
+#endif
+#if SCHED_EVENT_CONFLATE_EN
+SchedEvent_t **ppSlot;
+
+    /*合并信号已在队列中等待处理, 直接更新等待的事件块*/
+    ppSlot = prvQueueConflateSlot(queue, evt->sig);
+    if ((NULL != ppSlot) && (NULL != *ppSlot))
+    {
+        sched_PortEventCopy(*ppSlot, evt);
+        ret = SCHED_TRUE;
+    }
+#endif
+
+#if SCHED_QUEUE_POLICY_EN
+    /*队列已满时按照溢出策略处理*/
+    if ((SCHED_FALSE == ret) && (SCHED_FALSE != internal_QueueIsFull(queue)))
+    {
+        /*事件块已合并到队列中时无需继续插入*/
+        ret = prvQueueOverflow(queue, evt);
+    }
+#endif
+#if SCHED_EVENT_POOL_EN
+    /*事件块未合并时分配节点, 队列已满或者节点池已空时插入失败*/
+    if ((SCHED_FALSE == ret) && (queue->nUsed != queue->end))
+    {
+        pNode = prvEventPoolAlloc(queue->pool);
+    }
+    if (NULL != pNode)
+    {
+        /*插入事件节点*/
+        sched_PortEventCopy(&pNode->event, evt);
+        pNode->next = NULL;
+        if (NULL == queue->last)
+        {
+            queue->first = pNode;
+        }
+        else
+        {
+            queue->last->next = pNode;
+        }
+        queue->last = pNode;
+    #if SCHED_EVENT_CONFLATE_EN
+        if (NULL != ppSlot)
+        {
+            *ppSlot = &pNode->event;
+        }
+    #endif
+#else
+    /*事件块未合并时插入, 队列已满时插入失败*/
+    if ((SCHED_FALSE == ret) && (queue->nUsed != queue->end))
+    {
+        /*插入事件块*/
+    #if SCHED_EVENT_CONFLATE_EN
+        if (NULL != ppSlot)
+        {
+            *ppSlot = &queue->evtQueue[queue->tail];
+        }
+    #endif
+    #if SCHED_QUEUE_POW2_EN
+        sched_PortEventCopy(&queue->evtQueue[queue->tail], evt);
+        queue->tail = (queue->tail + 1) & (queue->end - 1);
+    #else
+        sched_PortEventCopy(&queue->evtQueue[queue->tail++], evt);
+        if (queue->tail == queue->end)
+        {
+            queue->tail = 0;
+        }
+    #endif
+#endif
+        queue->nUsed++;
+        if (queue->nUsed > queue->nMaxUsed)
+        {
+            queue->nMaxUsed = queue->nUsed;
+        }
+        ret = SCHED_TRUE;
+    }
+
+    return (ret);
+}
+
+/**
+ * 向队列头部插入一个事件块
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param evt: 待复制的事件块指针, 事件块内容复制到队列Buffer
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示事件块插入成功(或者按照溢出策略合并到队列中)
+ *          SCHED_FALSE 表示队列已满
+ */
+SchedBool_t internal_QueueSendFront(SchedQueue_t *queue, SchedEvent_t const *evt)
+{
+SchedBool_t ret = SCHED_FALSE;
+#if SCHED_EVENT_POOL_EN
+SchedEventNode_t *pNode = NULL;
+#endif
+#if SCHED_EVENT_CONFLATE_EN
+SchedEvent_t **ppSlot;
+
+    /*合并信号已在队列中等待处理, 直接更新等待的事件块*/
+    ppSlot = prvQueueConflateSlot(queue, evt->sig);
+    if ((NULL != ppSlot) && (NULL != *ppSlot))
+    {
+        sched_PortEventCopy(*ppSlot, evt);
+        ret = SCHED_TRUE;
+    }
+#endif
+
+#if SCHED_QUEUE_POLICY_EN
+    /*队列已满时按照溢出策略处理*/
+    if ((SCHED_FALSE == ret) && (SCHED_FALSE != internal_QueueIsFull(queue)))
+    {
+        /*事件块已合并到队列中时无需继续插入*/
+        ret = prvQueueOverflow(queue, evt);
+    }
+#endif
+#if SCHED_EVENT_POOL_EN
+    /*事件块未合并时分配节点, 队列已满或者节点池已空时插入失败*/
+    if ((SCHED_FALSE == ret) && (queue->nUsed != queue->end))
+    {
+        pNode = prvEventPoolAlloc(queue->pool);
+    }
+    if (NULL != pNode)
+    {
+        sched_PortEventCopy(&pNode->event, evt);
+        pNode->next  = queue->first;
+        queue->first = pNode;
+        if (NULL == queue->last)
+        {
+            queue->last = pNode;
+        }
+    #if SCHED_EVENT_CONFLATE_EN
+        if (NULL != ppSlot)
+        {
+            *ppSlot = &pNode->event;
+        }
+    #endif
+#else
+    /*事件块未合并时插入, 队列已满时插入失败*/
+    if ((SCHED_FALSE == ret) && (queue->nUsed != queue->end))
+    {
+    #if SCHED_QUEUE_POW2_EN
+        queue->head = (queue->head - 1) & (queue->end - 1);
+    #else
+        if (0 == queue->head)
+        {
+            queue->head = queue->end - 1;
+        }
+        else
+        {
+            queue->head--;
+        }
+    #endif
+        sched_PortEventCopy(&queue->evtQueue[queue->head], evt);
+    #if SCHED_EVENT_CONFLATE_EN
+        if (NULL != ppSlot)
+        {
+            *ppSlot = &queue->evtQueue[queue->head];
+        }
+    #endif
+#endif
+        queue->nUsed++;
+        if (queue->nUsed > queue->nMaxUsed)
+        {
+            queue->nMaxUsed = queue->nUsed;
+        }
+        ret = SCHED_TRUE;
+    }
+    return (ret);
+}
+
+/**
+ * 从队列头部取出一个事件块
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param evt: 保存结果的事件块指针, 事件块内容从队列Buffer中复制
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示事件块取出成功
+ *          SCHED_FALSE 表示队列已空
+ */
+SchedBool_t internal_QueueReceive(SchedQueue_t *queue, SchedEvent_t *evt)
+{
+SchedBool_t ret;
+#if SCHED_EVENT_POOL_EN
+SchedEventNode_t *pNode;
+#endif
+
+    if (0 == queue->nUsed)
+    {
+        ret = SCHED_FALSE;
+    }
+    else
+    {
+    #if SCHED_EVENT_POOL_EN
+        pNode        = queue->first;
+        queue->first = pNode->next;
+        if (NULL == queue->first)
+        {
+            queue->last = NULL;
+        }
+        sched_PortEventCopy(evt, &pNode->event);
+    #if SCHED_EVENT_CONFLATE_EN
+        prvQueueConflateRelease(queue, &pNode->event);
+    #endif
+        prvEventPoolFree(queue->pool, pNode);
+    #else
+    #if SCHED_EVENT_CONFLATE_EN
+        prvQueueConflateRelease(queue, &queue->evtQueue[queue->head]);
+    #endif
+    #if SCHED_QUEUE_POW2_EN
+        sched_PortEventCopy(evt, &queue->evtQueue[queue->head]);
+        queue->head = (queue->head + 1) & (queue->end - 1);
+    #else
+        sched_PortEventCopy(evt, &queue->evtQueue[queue->head++]);
+        if (queue->head == queue->end)
+        {
+            queue->head = 0;
+        }
+    #endif
+    #endif
+        queue->nUsed--;
+        ret = SCHED_TRUE;
+    }
+    return (ret);
+}
+
+/**
+ * 判断队列是否为空
+ *
+ * @param queue: 目标队列指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示队列为空
+ *          SCHED_FALSE 表示队列不空
+ */
+SchedBool_t internal_QueueIsEmpty(SchedQueue_t *queue)
+{
+SchedBool_t ret;
+
+    if (0 == queue->nUsed)
+    {
+        ret = SCHED_TRUE;
+    }
+    else
+    {
+        ret = SCHED_FALSE;
+    }
+    return (ret);
+}
+
+/**
+ * 判断队列是否已满
+ *
+ * @param queue: 目标队列指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示队列已满(或者共享事件节点池已空)
+ *          SCHED_FALSE 表示队列未满
+ */
+SchedBool_t internal_QueueIsFull(SchedQueue_t *queue)
+{
+SchedBool_t ret;
+
+    if (queue->end == queue->nUsed)
+    {
+        ret = SCHED_TRUE;
+    }
+#if SCHED_EVENT_POOL_EN
+    else if (0 == queue->pool->nFree)
+    {
+        ret = SCHED_TRUE;
+    }
+#endif
+    else
+    {
+        ret = SCHED_FALSE;
+    }
+    return (ret);
+}
+
+/**
+ * 获取队列最大使用量
+ *
+ * @param queue: 目标队列指针
+ *
+ * @return: 队列最大使用量
+ */
+EvtPos_t internal_QueueGetMaxUsed(SchedQueue_t *queue)
+{
+    return (queue->nMaxUsed);
+}
+
+/**
+ * 获取队列长度
+ *
+ * @param queue: 目标队列指针
+ *
+ * @return: 队列长度
+ */
+EvtPos_t internal_QueueGetLength(SchedQueue_t *queue)
+{
+    return (queue->end);
+}
+
+#if SCHED_QUEUE_POLICY_EN
+/**
+ * 设置队列溢出策略
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param policy: 队列溢出策略
+ *                SCHED_QUEUE_REJECT      表示拒绝新事件块
+ *                SCHED_QUEUE_DROP_OLDEST 表示丢弃队列中最早的事件块
+ *                SCHED_QUEUE_COALESCE    表示替换队列中相同信号的事件块
+ */
+void internal_QueueSetPolicy(SchedQueue_t *queue, uint8_t policy)
+{
+    queue->policy = policy;
+}
+
+/**
+ * 获取队列丢弃计数
+ *
+ * @param queue: 目标队列指针
+ *
+ * @return: 队列溢出时被丢弃或者被替换的事件块数量
+ */
+uint32_t internal_QueueGetDropCount(SchedQueue_t *queue)
+{
+    return (queue->nDropped);
+}
+#endif
+
+#if SCHED_EVENT_CONFLATE_EN
+/**
+ * 设置信号是否合并, 合并信号在队列中最多只有一个等待的事件块,
+ * 发送已在队列中等待的合并信号时, 直接更新等待的事件块
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param sig: 设置的信号, 有效范围是SCHED_SIG_USER - SCHED_SIG_USER+SCHED_CONFLATE_SIG_NUM-1
+ *
+ * @param enable: 布尔值(SCHED_TRUE/SCHED_FALSE), 表示是否合并信号
+ */
+void internal_QueueSetConflate(SchedQueue_t *queue, EvtSig_t sig, SchedBool_t enable)
+{
+EvtSig_t idx = sig - SCHED_SIG_USER;
+
+    SCHED_ASSERT((sig>=SCHED_SIG_USER)&&(idx<SCHED_CONFLATE_SIG_NUM),errSCHED_PARAM_NOT_ALLOWED);
+    if ((sig >= SCHED_SIG_USER) && (idx < SCHED_CONFLATE_SIG_NUM))
+    {
+        if (enable)
+        {
+            queue->conflateMap[idx>>3] |= (uint8_t)1<<(idx&0x7);
+        }
+        else
+        {
+            queue->conflateMap[idx>>3] &= ~((uint8_t)1<<(idx&0x7));
+            queue->conflateSlot[idx] = NULL;
+        }
+    }
+}
+#endif
+
+#if SCHED_TASK_DEFER_EN
+/**
+ * 将延迟队列中的事件块按原顺序移动到队列头部, 队列空位不足时只移动最早的部分事件块
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param defer: 延迟队列指针, 若使能共享事件节点池, 必须与目标队列使用同一节点池
+ *
+ * @return: 移动的事件块数量
+ *
+ * @note: 移动的事件块不经过溢出策略处理, 也不与队列中已有的事件块合并;
+ *        合并信号在队列中没有等待的事件块时, 最后移动的该信号事件块登记到
+ *        合并索引, 之后发送的同信号事件块合并到该事件块
+ */
+EvtPos_t internal_QueueRecall(SchedQueue_t *queue, SchedQueue_t *defer)
+{
+EvtPos_t n, i;
+#if SCHED_EVENT_POOL_EN
+SchedEventNode_t *pFirst, *pLast;
+#else
+EvtPos_t pos;
+#endif
+#if SCHED_EVENT_CONFLATE_EN
+uint8_t fresh[(SCHED_CONFLATE_SIG_NUM+7)/8];
+#endif
+
+    n = queue->end - queue->nUsed;
+    if (n > defer->nUsed)
+    {
+        n = defer->nUsed;
+    }
+    if (n > 0)
+    {
+    #if SCHED_EVENT_POOL_EN
+        SCHED_ASSERT(queue->pool == defer->pool,errSCHED_PARAM_NOT_ALLOWED);
+        /*从延迟队列头部摘下n个节点, 整体链接到队列头部*/
+        pFirst = defer->first;
+        pLast  = pFirst;
+        for (i=1;i<n;i++)
+        {
+            pLast = pLast->next;
+        }
+        defer->first = pLast->next;
+        if (NULL == defer->first)
+        {
+            defer->last = NULL;
+        }
+        pLast->next  = queue->first;
+        queue->first = pFirst;
+        if (NULL == queue->last)
+        {
+            queue->last = pLast;
+        }
+    #else
+        /*定位待移动的最后一个事件块*/
+        pos = defer->head;
+        for (i=1;i<n;i++)
+        {
+            pos = prvQueueNextPos(defer, pos);
+        }
+        defer->head = prvQueueNextPos(defer, pos);
+        /*逆序插入队列头部, 保持事件块原有顺序*/
+        for (i=0;i<n;i++)
+        {
+            queue->head = prvQueuePrevPos(queue, queue->head);
+            sched_PortEventCopy(&queue->evtQueue[queue->head], &defer->evtQueue[pos]);
+            pos = prvQueuePrevPos(defer, pos);
+        }
+    #endif
+    #if SCHED_EVENT_CONFLATE_EN
+        /*按原顺序登记移动的合并信号事件块*/
+        for (i=0;i<(SCHED_CONFLATE_SIG_NUM+7)/8;i++)
+        {
+            fresh[i] = 0;
+        }
+    #if SCHED_EVENT_POOL_EN
+        for (i=0;i<n;i++)
+        {
+            prvQueueConflateRecall(queue, &pFirst->event, fresh);
+            pFirst = pFirst->next;
+        }
+    #else
+        pos = queue->head;
+        for (i=0;i<n;i++)
+        {
+            prvQueueConflateRecall(queue, &queue->evtQueue[pos], fresh);
+            pos = prvQueueNextPos(queue, pos);
+        }
+    #endif
+    #endif
+        defer->nUsed -= n;
+        queue->nUsed += n;
+        if (queue->nUsed > queue->nMaxUsed)
+        {
+            queue->nMaxUsed = queue->nUsed;
+        }
+    }
+    return (n);
+}
+#endif
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+#if SCHED_EVENT_POOL_EN
+/**
+ * 从事件节点池中分配一个节点
+ *
+ * @param pool: 目标事件节点池指针
+ *
+ * @return: 若分配成功, 返回事件节点指针
+ *          若节点池已空, 返回NULL
+ */
+static SchedEventNode_t * prvEventPoolAlloc(SchedEventPool_t *pool)
+{
+SchedEventNode_t *pNode;
+
+    pNode = pool->freeList;
+    if (NULL != pNode)
+    {
+        pool->freeList = pNode->next;
+        pool->nFree--;
+        if (pool->nFree < pool->nMinFree)
+        {
+            pool->nMinFree = pool->nFree;
+        }
+    }
+    return (pNode);
+}
+
+/**
+ * 向事件节点池归还一个节点
+ *
+ * @param pool: 目标事件节点池指针
+ *
+ * @param node: 待归还的事件节点指针
+ */
+static void prvEventPoolFree(SchedEventPool_t *pool, SchedEventNode_t *node)
+{
+    node->next     = pool->freeList;
+    pool->freeList = node;
+    pool->nFree++;
+}
+#endif  /* SCHED_EVENT_POOL_EN */
+
+#if SCHED_QUEUE_POLICY_EN
+/**
+ * 队列已满时按照溢出策略处理待插入的事件块
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param evt: 待插入的事件块指针
+ *
+ * @return: 布尔值(SCHED_TRUE/SCHED_FALSE),
+ *          SCHED_TRUE  表示事件块已合并到队列中, 无需继续插入
+ *          SCHED_FALSE 表示事件块未合并, 需要继续插入(丢弃最早事件块后队列存在空位)
+ */
+static SchedBool_t prvQueueOverflow(SchedQueue_t *queue, SchedEvent_t const *evt)
+{
+SchedBool_t ret = SCHED_FALSE;
+SchedBool_t dropped = SCHED_TRUE;
+SchedEvent_t discard;
+#if SCHED_EVENT_POOL_EN
+SchedEventNode_t *pNode;
+#else
+EvtPos_t i, pos;
+#endif
+
+    if (SCHED_QUEUE_DROP_OLDEST == queue->policy)
+    {
+        /*丢弃队列头部最早的事件块, 队列为空(节点池已被其他队列用完)时没有可丢弃的事件块*/
+        dropped = internal_QueueReceive(queue, &discard);
+    }
+    else if (SCHED_QUEUE_COALESCE == queue->policy)
+    {
+        /*查找相同信号的事件块并替换*/
+    #if SCHED_EVENT_POOL_EN
+        for (pNode = queue->first;NULL != pNode;pNode = pNode->next)
+        {
+            if (pNode->event.sig == evt->sig)
+            {
+                sched_PortEventCopy(&pNode->event, evt);
+                ret = SCHED_TRUE;
+                break;
+            }
+        }
+    #else
+        pos = queue->head;
+        for (i=0;i<queue->nUsed;i++)
+        {
+            if (queue->evtQueue[pos].sig == evt->sig)
+            {
+                sched_PortEventCopy(&queue->evtQueue[pos], evt);
+                ret = SCHED_TRUE;
+                break;
+            }
+        #if SCHED_QUEUE_POW2_EN
+            pos = (pos + 1) & (queue->end - 1);
+        #else
+            if (++pos == queue->end)
+            {
+                pos = 0;
+            }
+        #endif
+        }
+    #endif
+    }
+    if (SCHED_FALSE != dropped)
+    {
+        queue->nDropped++;
+    }
+    return (ret);
+}
+#endif  /* SCHED_QUEUE_POLICY_EN */
+
+#if SCHED_EVENT_CONFLATE_EN
+/**
+ * 初始化信号合并索引, 所有信号均不合并
+ *
+ * @param queue: 目标队列指针
+ */
+static void prvQueueConflateInit(SchedQueue_t *queue)
+{
+EvtSig_t i;
+
+    for (i=0;i<(SCHED_CONFLATE_SIG_NUM+7)/8;i++)
+    {
+        queue->conflateMap[i] = 0;
+    }
+    for (i=0;i<SCHED_CONFLATE_SIG_NUM;i++)
+    {
+        queue->conflateSlot[i] = NULL;
+    }
+}
+
+/**
+ * 获取合并信号的索引项
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param sig: 事件信号
+ *
+ * @return: 若信号设置为合并, 返回索引项指针, 索引项保存等待中的事件块位置(NULL表示没有等待)
+ *          若信号不合并, 返回NULL
+ */
+static SchedEvent_t ** prvQueueConflateSlot(SchedQueue_t *queue, EvtSig_t sig)
+{
+SchedEvent_t **ppSlot = NULL;
+EvtSig_t idx = sig - SCHED_SIG_USER;
+
+    if ((sig >= SCHED_SIG_USER) && (idx < SCHED_CONFLATE_SIG_NUM) &&
+        (0 != (queue->conflateMap[idx>>3] & ((uint8_t)1<<(idx&0x7)))))
+    {
+        ppSlot = &queue->conflateSlot[idx];
+    }
+    return (ppSlot);
+}
+
+/**
+ * 事件块离开队列时, 清除指向该事件块的合并信号索引
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param pEvent: 即将离开队列的事件块指针
+ */
+static void prvQueueConflateRelease(SchedQueue_t *queue, SchedEvent_t const *pEvent)
+{
+SchedEvent_t **ppSlot;
+
+    ppSlot = prvQueueConflateSlot(queue, pEvent->sig);
+    if ((NULL != ppSlot) && (pEvent == *ppSlot))
+    {
+        *ppSlot = NULL;
+    }
+}
+
+#if SCHED_TASK_DEFER_EN
+/**
+ * 召回的事件块进入队列时登记合并信号索引, 需按原顺序调用,
+ * 召回前没有等待中事件块的合并信号最终登记为最后召回的事件块
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param pEvent: 已进入队列的事件块指针
+ *
+ * @param pFresh: 本次召回中由召回事件块登记的合并信号位图, 召回开始前清零
+ */
+static void prvQueueConflateRecall(SchedQueue_t *queue, SchedEvent_t *pEvent, uint8_t *pFresh)
+{
+SchedEvent_t **ppSlot;
+EvtSig_t idx = pEvent->sig - SCHED_SIG_USER;
+
+    ppSlot = prvQueueConflateSlot(queue, pEvent->sig);
+    if (NULL != ppSlot)
+    {
+        if (NULL == *ppSlot)
+        {
+            pFresh[idx>>3] |= (uint8_t)((uint8_t)1<<(idx&0x7));
+        }
+        if (0 != (pFresh[idx>>3] & ((uint8_t)1<<(idx&0x7))))
+        {
+            *ppSlot = pEvent;
+        }
+    }
+}
+#endif
+#endif  /* SCHED_EVENT_CONFLATE_EN */
+
+#if SCHED_TASK_DEFER_EN && !SCHED_EVENT_POOL_EN
+/**
+ * 获取环形Buffer中指定位置的下一个位置
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param pos: 当前位置
+ *
+ * @return: 下一个位置
+ */
+static EvtPos_t prvQueueNextPos(SchedQueue_t const *queue, EvtPos_t pos)
+{
+#if SCHED_QUEUE_POW2_EN
+    return ((EvtPos_t)((pos + 1) & (queue->end - 1)));
+#else
+    if (++pos == queue->end)
+    {
+        pos = 0;
+    }
+    return (pos);
+#endif
+}
+
+/**
+ * 获取环形Buffer中指定位置的上一个位置
+ *
+ * @param queue: 目标队列指针
+ *
+ * @param pos: 当前位置
+ *
+ * @return: 上一个位置
+ */
+static EvtPos_t prvQueuePrevPos(SchedQueue_t const *queue, EvtPos_t pos)
+{
+#if SCHED_QUEUE_POW2_EN
+    return ((EvtPos_t)((pos - 1) & (queue->end - 1)));
+#else
+    if (0 == pos)
+    {
+        pos = queue->end;
+    }
+    return (pos - 1);
+#endif
+}
+#endif  /* SCHED_TASK_DEFER_EN && !SCHED_EVENT_POOL_EN */
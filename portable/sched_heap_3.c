@@ -0,0 +1,245 @@
+/*******************************************************************************
+* 文 件 名: sched_heap_3.c
+* 创 建 者: agent
+* 版    本: V1.0
+* 创建日期: 2026-10-19
+* 文件说明: 事件驱动调度器的动态内存分配 - 分级固定大小内存池,
+*           块大小从SCHED_HEAP_CLASS_MIN开始逐级加倍, 共SCHED_HEAP_CLASS_NUM级,
+*           空闲链表为空时从堆中切分新块, 释放的块回到所属级的空闲链表,
+*           分配和释放的时间与堆的使用情况无关;
+*           大于最大块的分配从大块空闲链表中首次适配复用, 没有足够大的空闲
+*           大块时从堆中切分, 释放的大块整块回到大块空闲链表(不分割不合并)
+*******************************************************************************/
+
+#include "sched_port.h"
+/*******************************************************************************
+
+                                    全局变量
+
+*******************************************************************************/
+#define SCHED_BYTE_ALIGNMENT_MASK   ( SCHED_BYTE_ALIGNMENT-1 )
+#define SCHED_ADJUST_HEAP_SIZE      ( SCHED_TOTAL_HEAP_SIZE - SCHED_BYTE_ALIGNMENT )
+/*块头最后一个字节保存块所属级数, 块头占用一个对齐单位, 保证块内存对齐*/
+#define SCHED_HEAP_HEADER_SIZE      ( SCHED_BYTE_ALIGNMENT )
+#define SCHED_HEAP_LARGE_CLASS      ( 0xFF )
+/*大块块头在开头额外保存块大小, 向上取整为对齐单位的整数倍*/
+#define SCHED_HEAP_LARGE_HEADER_SIZE \
+    ( ((sizeof(size_t) + 1 + SCHED_BYTE_ALIGNMENT_MASK) / SCHED_BYTE_ALIGNMENT) * SCHED_BYTE_ALIGNMENT )
+/*获取块所属级数*/
+#define prvHeapBlockClass(pv)       ( ((uint8_t *)(pv))[-1] )
+/*获取大块的块大小*/
+#define prvHeapLargeSize(pv)        ( *(size_t *)((uint8_t *)(pv) - SCHED_HEAP_LARGE_HEADER_SIZE) )
+
+SCHED_STATIC_ASSERT((SCHED_HEAP_CLASS_MIN % SCHED_BYTE_ALIGNMENT) == 0, sched_heap_class_min_not_aligned);
+SCHED_STATIC_ASSERT(SCHED_HEAP_CLASS_MIN >= sizeof(void *), sched_heap_class_min_too_small);
+SCHED_STATIC_ASSERT((SCHED_HEAP_CLASS_NUM > 0) && (SCHED_HEAP_CLASS_NUM < SCHED_HEAP_LARGE_CLASS),
+                    sched_heap_class_num_out_of_range);
+
+/*空闲块, 链表指针保存在块内存中*/
+typedef struct heap_free_block HeapFreeBlock_t;
+struct heap_free_block
+{
+    HeapFreeBlock_t *next;
+};
+
+static uint8_t  heapMemory[SCHED_TOTAL_HEAP_SIZE];
+static uint8_t *heapAlignedStart;
+static size_t   heapNextFreeByte;
+static HeapFreeBlock_t *heapFreeList[SCHED_HEAP_CLASS_NUM];
+static HeapFreeBlock_t *heapLargeFreeList;
+static SchedHeapClassStat_t heapClassStat[SCHED_HEAP_CLASS_NUM];
+
+static uint8_t * prvHeapCarve(size_t size);
+/*******************************************************************************
+
+                                    内存分配
+
+*******************************************************************************/
+/*内存管理初始化*/
+void sched_PortHeapInit(void)
+{
+uint8_t i;
+
+    heapNextFreeByte = 0;
+    if ( (((size_t)heapMemory)&SCHED_BYTE_ALIGNMENT_MASK) != 0 )
+    {
+        heapAlignedStart = heapMemory + ( SCHED_BYTE_ALIGNMENT - (((size_t)heapMemory)&SCHED_BYTE_ALIGNMENT_MASK) );
+    }
+    else
+    {
+        heapAlignedStart = heapMemory;
+    }
+    for (i=0;i<SCHED_HEAP_CLASS_NUM;i++)
+    {
+        heapFreeList[i] = NULL;
+        heapClassStat[i].blockSize = (size_t)SCHED_HEAP_CLASS_MIN << i;
+        heapClassStat[i].carved    = 0;
+        heapClassStat[i].used      = 0;
+        heapClassStat[i].maxUsed   = 0;
+    }
+    heapLargeFreeList = NULL;
+}
+
+/*动态内存分配*/
+void *sched_PortMalloc(size_t size)
+{
+void       *ret = NULL;
+uint8_t    *pBlock;
+uint8_t     classIdx = 0;
+HeapFreeBlock_t **ppFree;
+SchedCPU_t  cpu_sr;
+
+    /*查找能容纳size的最小块大小级*/
+    while ((classIdx < SCHED_HEAP_CLASS_NUM) && (heapClassStat[classIdx].blockSize < size))
+    {
+        classIdx++;
+    }
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        if (classIdx < SCHED_HEAP_CLASS_NUM)
+        {
+            if (NULL != heapFreeList[classIdx])
+            {
+                ret = heapFreeList[classIdx];
+                heapFreeList[classIdx] = heapFreeList[classIdx]->next;
+            }
+            else
+            {
+                pBlock = prvHeapCarve(SCHED_HEAP_HEADER_SIZE + heapClassStat[classIdx].blockSize);
+                if (NULL != pBlock)
+                {
+                    ret = pBlock + SCHED_HEAP_HEADER_SIZE;
+                    prvHeapBlockClass(ret) = classIdx;
+                    heapClassStat[classIdx].carved++;
+                }
+            }
+            if (NULL != ret)
+            {
+                heapClassStat[classIdx].used++;
+                if (heapClassStat[classIdx].used > heapClassStat[classIdx].maxUsed)
+                {
+                    heapClassStat[classIdx].maxUsed = heapClassStat[classIdx].used;
+                }
+            }
+        }
+        else
+        {
+            if ( (size&SCHED_BYTE_ALIGNMENT_MASK) != 0 )
+            {
+                size += ( SCHED_BYTE_ALIGNMENT - (size&SCHED_BYTE_ALIGNMENT_MASK) );
+            }
+            /*首次适配: 复用大块空闲链表中第一个足够大的块*/
+            ppFree = &heapLargeFreeList;
+            while ((NULL != *ppFree) && (prvHeapLargeSize(*ppFree) < size))
+            {
+                ppFree = &(*ppFree)->next;
+            }
+            if (NULL != *ppFree)
+            {
+                ret = *ppFree;
+                *ppFree = (*ppFree)->next;
+            }
+            else
+            {
+                pBlock = prvHeapCarve(SCHED_HEAP_LARGE_HEADER_SIZE + size);
+                if (NULL != pBlock)
+                {
+                    ret = pBlock + SCHED_HEAP_LARGE_HEADER_SIZE;
+                    prvHeapLargeSize(ret) = size;
+                    prvHeapBlockClass(ret) = SCHED_HEAP_LARGE_CLASS;
+                }
+            }
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    SCHED_CHECK(NULL != ret,chkSCHED_MALLOC_FAILED);
+    return (ret);
+}
+
+/*动态内存释放*/
+void sched_PortFree(void *pv)
+{
+HeapFreeBlock_t *pFree;
+uint8_t          classIdx;
+SchedCPU_t       cpu_sr;
+
+    if (NULL != pv)
+    {
+        classIdx = prvHeapBlockClass(pv);
+        SCHED_ASSERT((classIdx < SCHED_HEAP_CLASS_NUM) || (SCHED_HEAP_LARGE_CLASS == classIdx),
+                     errSCHED_PARAM_NOT_ALLOWED);
+
+        pFree = (HeapFreeBlock_t *)pv;
+        cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+        {
+            if (SCHED_HEAP_LARGE_CLASS == classIdx)
+            {
+                /*大块整块回到大块空闲链表*/
+                pFree->next = heapLargeFreeList;
+                heapLargeFreeList = pFree;
+            }
+            else
+            {
+                pFree->next = heapFreeList[classIdx];
+                heapFreeList[classIdx] = pFree;
+                heapClassStat[classIdx].used--;
+            }
+        }
+        SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    }
+}
+
+/**
+ * 获取内存池块大小级的使用统计
+ *
+ * @param classIdx: 块大小级数, 0为最小块
+ *
+ * @param stat: 保存统计结果的指针, maxUsed用于评估SCHED_TOTAL_HEAP_SIZE是否合适
+ *
+ * @return: SCHED_FALSE 表示级数超出范围
+ */
+SchedBool_t sched_PortHeapGetClassStat(uint8_t classIdx, SchedHeapClassStat_t *stat)
+{
+SchedBool_t ret = SCHED_FALSE;
+SchedCPU_t cpu_sr;
+
+    SCHED_ASSERT(NULL != stat,errSCHED_PARAM_PTR_IS_NULL);
+    if (classIdx < SCHED_HEAP_CLASS_NUM)
+    {
+        cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+        {
+            *stat = heapClassStat[classIdx];
+        }
+        SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+        ret = SCHED_TRUE;
+    }
+    return (ret);
+}
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+
+/**
+ * 从堆中切分内存, 调用前需进入临界区
+ *
+ * @param size: 切分大小, 必须是对齐单位的整数倍
+ *
+ * @return: 内存指针, 堆空间不足时返回NULL
+ */
+static uint8_t * prvHeapCarve(size_t size)
+{
+uint8_t *ret = NULL;
+
+    if (((size + heapNextFreeByte) < SCHED_ADJUST_HEAP_SIZE) &&
+        ((size + heapNextFreeByte) > heapNextFreeByte))
+    {
+        ret = heapAlignedStart + heapNextFreeByte;
+        heapNextFreeByte += size;
+    }
+    return (ret);
+}
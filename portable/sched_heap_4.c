@@ -0,0 +1,442 @@
+/*******************************************************************************
+* 文 件 名: sched_heap_4.c
+* 创 建 者: agent
+* 版    本: V1.0
+* 创建日期: 2026-10-19
+* 文件说明: 事件驱动调度器的动态内存分配 - 两级分离适配(TLSF)分配器,
+*           空闲块按大小分为一级(2的幂)和二级(一级区间的2^SL_LOG2等分)链表,
+*           通过位图查找非空链表, 分配和释放的时间与堆的使用情况无关;
+*           释放时立即合并物理相邻的空闲块, 使能SCHED_ASSERT_EN时校验块头
+*******************************************************************************/
+
+#include "sched_port.h"
+/*******************************************************************************
+
+                                    全局变量
+
+*******************************************************************************/
+/*常量表达式的以2为底的对数(向下取整), x < 2^32*/
+#define TLSF_LOG2_2(x)          ( ((x) >= 2UL) ? 1 : 0 )
+#define TLSF_LOG2_4(x)          ( ((x) >= 4UL) ? 2 + TLSF_LOG2_2((x)>>2) : TLSF_LOG2_2(x) )
+#define TLSF_LOG2_16(x)         ( ((x) >= 16UL) ? 4 + TLSF_LOG2_4((x)>>4) : TLSF_LOG2_4(x) )
+#define TLSF_LOG2_256(x)        ( ((x) >= 256UL) ? 8 + TLSF_LOG2_16((x)>>8) : TLSF_LOG2_16(x) )
+#define TLSF_LOG2(x)            ( ((x) >= 65536UL) ? 16 + TLSF_LOG2_256((x)>>16) : TLSF_LOG2_256(x) )
+
+/*块大小对齐单位, 至少能保存一个指针*/
+#define TLSF_ALIGN_SIZE         ( (SCHED_BYTE_ALIGNMENT >= sizeof(void *)) ? SCHED_BYTE_ALIGNMENT : sizeof(void *) )
+#define TLSF_ALIGN_MASK         ( TLSF_ALIGN_SIZE-1 )
+#define TLSF_ALIGN_LOG2         ( TLSF_LOG2(TLSF_ALIGN_SIZE) )
+/*二级链表数量, 小于TLSF_SMALL_BLOCK的块按对齐单位线性划分*/
+#define TLSF_SL_LOG2            ( SCHED_HEAP_TLSF_SL_LOG2 )
+#define TLSF_SL_COUNT           ( 1 << TLSF_SL_LOG2 )
+#define TLSF_FL_SHIFT           ( TLSF_SL_LOG2 + TLSF_ALIGN_LOG2 )
+#define TLSF_SMALL_BLOCK        ( (size_t)1 << TLSF_FL_SHIFT )
+/*一级链表数量, 覆盖SCHED_TOTAL_HEAP_SIZE*/
+#define TLSF_FL_COUNT           ( TLSF_LOG2(SCHED_TOTAL_HEAP_SIZE) - TLSF_FL_SHIFT + 2 )
+
+#define TLSF_BLOCK_FREE         ( (size_t)1 )
+#define TLSF_BLOCK_MAGIC        ( (size_t)0x5A3C96E1UL )
+
+SCHED_STATIC_ASSERT((SCHED_HEAP_TLSF_SL_LOG2 >= 1) && (SCHED_HEAP_TLSF_SL_LOG2 <= 5), sched_heap_tlsf_sl_log2_out_of_range);
+SCHED_STATIC_ASSERT((TLSF_FL_COUNT >= 1) && (TLSF_FL_COUNT <= 32), sched_heap_tlsf_fl_count_out_of_range);
+
+/*块头, 负载紧随块头; 空闲块的负载保存空闲链表指针*/
+typedef struct tlsf_block TlsfBlock_t;
+struct tlsf_block
+{
+    TlsfBlock_t    *prevPhys;   /*物理相邻的前一块, 第一块为NULL*/
+    size_t          size;       /*负载大小, 最低位为空闲标志*/
+#if SCHED_ASSERT_EN
+    size_t          check;      /*块头校验值*/
+#endif
+};
+typedef struct tlsf_free_link TlsfFreeLink_t;
+struct tlsf_free_link
+{
+    TlsfBlock_t    *next;
+    TlsfBlock_t    *prev;
+};
+
+#define TLSF_HEADER_SIZE        ( (sizeof(TlsfBlock_t) + TLSF_ALIGN_MASK) & ~(size_t)TLSF_ALIGN_MASK )
+#define TLSF_MIN_PAYLOAD        ( (sizeof(TlsfFreeLink_t) + TLSF_ALIGN_MASK) & ~(size_t)TLSF_ALIGN_MASK )
+
+static uint8_t      heapMemory[SCHED_TOTAL_HEAP_SIZE];
+static uint32_t     tlsfFlBitmap;
+static uint32_t     tlsfSlBitmap[TLSF_FL_COUNT];
+static TlsfBlock_t *tlsfFreeList[TLSF_FL_COUNT][TLSF_SL_COUNT];
+static size_t       tlsfFreeSize;
+
+static uint8_t prvTlsfFls(uint32_t x);
+static void prvTlsfMapping(size_t size, uint8_t *fl, uint8_t *sl);
+static TlsfBlock_t * prvTlsfFindSuitable(size_t size);
+static void prvTlsfInsert(TlsfBlock_t *block);
+static void prvTlsfRemove(TlsfBlock_t *block);
+static void prvTlsfSetSize(TlsfBlock_t *block, size_t size);
+static TlsfBlock_t * prvTlsfNext(TlsfBlock_t *block);
+static TlsfFreeLink_t * prvTlsfLink(TlsfBlock_t *block);
+static void prvTlsfCheck(TlsfBlock_t *block);
+/*******************************************************************************
+
+                                    内存分配
+
+*******************************************************************************/
+/*内存管理初始化, 整个堆初始化为一个空闲块和一个结束哨兵块*/
+void sched_PortHeapInit(void)
+{
+TlsfBlock_t *pBlock;
+TlsfBlock_t *pSentinel;
+uint8_t     *pStart;
+size_t       total;
+uint8_t      i;
+uint8_t      j;
+
+    tlsfFlBitmap = 0;
+    for (i=0;i<TLSF_FL_COUNT;i++)
+    {
+        tlsfSlBitmap[i] = 0;
+        for (j=0;j<TLSF_SL_COUNT;j++)
+        {
+            tlsfFreeList[i][j] = NULL;
+        }
+    }
+    pStart = heapMemory;
+    if ( (((size_t)pStart)&TLSF_ALIGN_MASK) != 0 )
+    {
+        pStart += ( TLSF_ALIGN_SIZE - (((size_t)pStart)&TLSF_ALIGN_MASK) );
+    }
+    total = (size_t)(heapMemory + SCHED_TOTAL_HEAP_SIZE - pStart) & ~(size_t)TLSF_ALIGN_MASK;
+    SCHED_ASSERT(total >= 2*TLSF_HEADER_SIZE + TLSF_MIN_PAYLOAD,errSCHED_PARAM_NOT_ALLOWED);
+
+    pBlock = (TlsfBlock_t *)pStart;
+    pBlock->prevPhys = NULL;
+    prvTlsfSetSize(pBlock, (total - 2*TLSF_HEADER_SIZE) | TLSF_BLOCK_FREE);
+    pSentinel = prvTlsfNext(pBlock);
+    pSentinel->prevPhys = pBlock;
+    prvTlsfSetSize(pSentinel, 0);
+    tlsfFreeSize = 0;
+    prvTlsfInsert(pBlock);
+}
+
+/*动态内存分配*/
+void *sched_PortMalloc(size_t size)
+{
+void        *ret = NULL;
+TlsfBlock_t *pBlock;
+TlsfBlock_t *pRemain;
+size_t       blockSize;
+SchedCPU_t   cpu_sr;
+
+    size = (size + TLSF_ALIGN_MASK) & ~(size_t)TLSF_ALIGN_MASK;
+    if (size < TLSF_MIN_PAYLOAD)
+    {
+        size = TLSF_MIN_PAYLOAD;
+    }
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        pBlock = (size < SCHED_TOTAL_HEAP_SIZE) ? prvTlsfFindSuitable(size) : NULL;
+        if (NULL != pBlock)
+        {
+            prvTlsfRemove(pBlock);
+            blockSize = pBlock->size & ~TLSF_BLOCK_FREE;
+            /*剩余空间足够时切分出新的空闲块*/
+            if (blockSize >= size + TLSF_HEADER_SIZE + TLSF_MIN_PAYLOAD)
+            {
+                prvTlsfSetSize(pBlock, size);
+                pRemain = prvTlsfNext(pBlock);
+                pRemain->prevPhys = pBlock;
+                prvTlsfSetSize(pRemain, (blockSize - size - TLSF_HEADER_SIZE) | TLSF_BLOCK_FREE);
+                prvTlsfNext(pRemain)->prevPhys = pRemain;
+                prvTlsfInsert(pRemain);
+            }
+            else
+            {
+                prvTlsfSetSize(pBlock, blockSize);
+            }
+            ret = (uint8_t *)pBlock + TLSF_HEADER_SIZE;
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+
+    SCHED_CHECK(NULL != ret,chkSCHED_MALLOC_FAILED);
+    return (ret);
+}
+
+/*动态内存释放, 与物理相邻的空闲块合并*/
+void sched_PortFree(void *pv)
+{
+TlsfBlock_t *pBlock;
+TlsfBlock_t *pNeighbor;
+SchedCPU_t   cpu_sr;
+
+    if (NULL != pv)
+    {
+        pBlock = (TlsfBlock_t *)((uint8_t *)pv - TLSF_HEADER_SIZE);
+
+        cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+        {
+            prvTlsfCheck(pBlock);
+            SCHED_ASSERT(0 == (pBlock->size & TLSF_BLOCK_FREE),errSCHED_HEAP_CORRUPTED);
+            /*与后一块合并*/
+            pNeighbor = prvTlsfNext(pBlock);
+            prvTlsfCheck(pNeighbor);
+            SCHED_ASSERT(pNeighbor->prevPhys == pBlock,errSCHED_HEAP_CORRUPTED);
+            if (0 != (pNeighbor->size & TLSF_BLOCK_FREE))
+            {
+                prvTlsfRemove(pNeighbor);
+                prvTlsfSetSize(pBlock, pBlock->size + TLSF_HEADER_SIZE + (pNeighbor->size & ~TLSF_BLOCK_FREE));
+            }
+            /*与前一块合并*/
+            pNeighbor = pBlock->prevPhys;
+            if (NULL != pNeighbor)
+            {
+                prvTlsfCheck(pNeighbor);
+                if (0 != (pNeighbor->size & TLSF_BLOCK_FREE))
+                {
+                    prvTlsfRemove(pNeighbor);
+                    prvTlsfSetSize(pNeighbor, (pNeighbor->size & ~TLSF_BLOCK_FREE) + TLSF_HEADER_SIZE + pBlock->size);
+                    pBlock = pNeighbor;
+                }
+            }
+            prvTlsfSetSize(pBlock, pBlock->size | TLSF_BLOCK_FREE);
+            prvTlsfNext(pBlock)->prevPhys = pBlock;
+            prvTlsfInsert(pBlock);
+        }
+        SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    }
+}
+
+/**
+ * 获取空闲内存总量
+ *
+ * @return: 所有空闲块的负载大小之和
+ */
+size_t sched_PortHeapGetFreeSize(void)
+{
+size_t size;
+SchedCPU_t cpu_sr;
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        size = tlsfFreeSize;
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    return (size);
+}
+
+/**
+ * 获取最大空闲块大小, 只遍历最大的非空链表
+ *
+ * @return: 最大空闲块的负载大小, 即一次能分配的最大内存
+ */
+size_t sched_PortHeapGetLargestFree(void)
+{
+TlsfBlock_t *pBlock;
+size_t size = 0;
+uint8_t fl;
+uint8_t sl;
+SchedCPU_t cpu_sr;
+
+    cpu_sr = SCHED_EnterCritical(); /*进入临界区*/
+    {
+        if (0 != tlsfFlBitmap)
+        {
+            fl = prvTlsfFls(tlsfFlBitmap);
+            sl = prvTlsfFls(tlsfSlBitmap[fl]);
+            for (pBlock=tlsfFreeList[fl][sl];NULL!=pBlock;pBlock=prvTlsfLink(pBlock)->next)
+            {
+                if ((pBlock->size & ~TLSF_BLOCK_FREE) > size)
+                {
+                    size = pBlock->size & ~TLSF_BLOCK_FREE;
+                }
+            }
+        }
+    }
+    SCHED_ExitCritical(cpu_sr);     /*退出临界区*/
+    return (size);
+}
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+
+/*最高置位的位序号, x不为0*/
+static uint8_t prvTlsfFls(uint32_t x)
+{
+uint8_t n = 0;
+
+    if (x & 0xFFFF0000UL) { n += 16; x >>= 16; }
+    if (x & 0x0000FF00UL) { n +=  8; x >>=  8; }
+    if (x & 0x000000F0UL) { n +=  4; x >>=  4; }
+    if (x & 0x0000000CUL) { n +=  2; x >>=  2; }
+    if (x & 0x00000002UL) { n +=  1; }
+    return (n);
+}
+
+/**
+ * 计算块大小所属的链表
+ *
+ * @param size: 块负载大小
+ *
+ * @param fl: 一级链表序号
+ *
+ * @param sl: 二级链表序号
+ */
+static void prvTlsfMapping(size_t size, uint8_t *fl, uint8_t *sl)
+{
+uint8_t n;
+
+    if (size < TLSF_SMALL_BLOCK)
+    {
+        *fl = 0;
+        *sl = (uint8_t)(size >> TLSF_ALIGN_LOG2);
+    }
+    else
+    {
+        n   = prvTlsfFls((uint32_t)size);
+        *sl = (uint8_t)((size >> (n - TLSF_SL_LOG2)) - TLSF_SL_COUNT);
+        *fl = (uint8_t)(n - TLSF_FL_SHIFT + 1);
+    }
+}
+
+/**
+ * 查找能容纳size的空闲块: 将size向上取整到链表区间上限,
+ * 保证找到的链表中任意块都足够大, 不需要遍历链表;
+ * 没有找到时再检查size所属链表的第一个块
+ *
+ * @param size: 需要的负载大小, 已对齐
+ *
+ * @return: 空闲块指针, 没有合适的空闲块时返回NULL
+ */
+static TlsfBlock_t * prvTlsfFindSuitable(size_t size)
+{
+TlsfBlock_t *pBlock = NULL;
+uint32_t map;
+uint8_t fl;
+uint8_t sl;
+size_t  round = size;
+
+    if (size >= TLSF_SMALL_BLOCK)
+    {
+        round += ((size_t)1 << (prvTlsfFls((uint32_t)size) - TLSF_SL_LOG2)) - 1;
+    }
+    prvTlsfMapping(round, &fl, &sl);
+    if (fl < TLSF_FL_COUNT)
+    {
+        map = tlsfSlBitmap[fl] & (~(uint32_t)0 << sl);
+        if (0 == map)
+        {
+            /*当前一级链表中没有足够大的块, 使用更大的一级链表*/
+            map = (fl + 1 < 32) ? (tlsfFlBitmap & (~(uint32_t)0 << (fl + 1))) : 0;
+            if (0 != map)
+            {
+                fl  = prvTlsfFls(map & (~map + 1));
+                map = tlsfSlBitmap[fl];
+            }
+        }
+        if (0 != map)
+        {
+            sl = prvTlsfFls(map & (~map + 1));
+            pBlock = tlsfFreeList[fl][sl];
+        }
+    }
+    if (NULL == pBlock)
+    {
+        prvTlsfMapping(size, &fl, &sl);
+        if ((fl < TLSF_FL_COUNT) && (NULL != tlsfFreeList[fl][sl])
+          &&((tlsfFreeList[fl][sl]->size & ~TLSF_BLOCK_FREE) >= size))
+        {
+            pBlock = tlsfFreeList[fl][sl];
+        }
+    }
+    return (pBlock);
+}
+
+/*将空闲块插入所属链表头部*/
+static void prvTlsfInsert(TlsfBlock_t *block)
+{
+TlsfFreeLink_t *pLink;
+uint8_t fl;
+uint8_t sl;
+
+    prvTlsfMapping(block->size & ~TLSF_BLOCK_FREE, &fl, &sl);
+    pLink = prvTlsfLink(block);
+    pLink->prev = NULL;
+    pLink->next = tlsfFreeList[fl][sl];
+    if (NULL != pLink->next)
+    {
+        prvTlsfLink(pLink->next)->prev = block;
+    }
+    tlsfFreeList[fl][sl] = block;
+    tlsfFlBitmap    |= (uint32_t)1 << fl;
+    tlsfSlBitmap[fl] |= (uint32_t)1 << sl;
+    tlsfFreeSize += block->size & ~TLSF_BLOCK_FREE;
+}
+
+/*将空闲块从所属链表中移除*/
+static void prvTlsfRemove(TlsfBlock_t *block)
+{
+TlsfFreeLink_t *pLink;
+uint8_t fl;
+uint8_t sl;
+
+    prvTlsfCheck(block);
+    SCHED_ASSERT(0 != (block->size & TLSF_BLOCK_FREE),errSCHED_HEAP_CORRUPTED);
+    prvTlsfMapping(block->size & ~TLSF_BLOCK_FREE, &fl, &sl);
+    pLink = prvTlsfLink(block);
+    if (NULL != pLink->next)
+    {
+        prvTlsfLink(pLink->next)->prev = pLink->prev;
+    }
+    if (NULL != pLink->prev)
+    {
+        prvTlsfLink(pLink->prev)->next = pLink->next;
+    }
+    else
+    {
+        tlsfFreeList[fl][sl] = pLink->next;
+        if (NULL == pLink->next)
+        {
+            tlsfSlBitmap[fl] &= ~((uint32_t)1 << sl);
+            if (0 == tlsfSlBitmap[fl])
+            {
+                tlsfFlBitmap &= ~((uint32_t)1 << fl);
+            }
+        }
+    }
+    tlsfFreeSize -= block->size & ~TLSF_BLOCK_FREE;
+}
+
+/*设置块大小和空闲标志, 并更新块头校验值*/
+static void prvTlsfSetSize(TlsfBlock_t *block, size_t size)
+{
+    block->size = size;
+#if SCHED_ASSERT_EN
+    block->check = (size_t)block ^ size ^ TLSF_BLOCK_MAGIC;
+#endif
+}
+
+/*物理相邻的后一块*/
+static TlsfBlock_t * prvTlsfNext(TlsfBlock_t *block)
+{
+    return ((TlsfBlock_t *)((uint8_t *)block + TLSF_HEADER_SIZE + (block->size & ~TLSF_BLOCK_FREE)));
+}
+
+/*空闲块的链表指针*/
+static TlsfFreeLink_t * prvTlsfLink(TlsfBlock_t *block)
+{
+    return ((TlsfFreeLink_t *)((uint8_t *)block + TLSF_HEADER_SIZE));
+}
+
+/*校验块头, 检测越界写入和无效指针*/
+static void prvTlsfCheck(TlsfBlock_t *block)
+{
+    SCHED_ASSERT(((uint8_t *)block >= heapMemory) && ((uint8_t *)block < heapMemory + SCHED_TOTAL_HEAP_SIZE),
+                 errSCHED_HEAP_CORRUPTED);
+#if SCHED_ASSERT_EN
+    SCHED_ASSERT(block->check == ((size_t)block ^ block->size ^ TLSF_BLOCK_MAGIC),errSCHED_HEAP_CORRUPTED);
+#endif
+    ((void)block);
+}
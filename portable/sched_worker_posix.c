@@ -0,0 +1,224 @@
+/*******************************************************************************
+* 文 件 名: sched_worker_posix.c
+* 创 建 者: agent
+* 版    本: V1.0
+* 创建日期: 2026-10-19
+* 文件说明: 事件驱动调度器的底层接口 - POSIX工作线程池(需要C11原子操作和pthread),
+*           只有调度线程提交作业, 作业进入调度线程拥有的Chase-Lev双端队列,
+*           由空闲的工作线程在top端窃取执行(单生产者多窃取者), 工作线程
+*           不产生作业, 因此不设各自的双端队列
+*******************************************************************************/
+
+#include "sched_port.h"
+
+#if SCHED_DAEMON_OFFLOAD_EN
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define SCHED_WORKER_DEQUE_MASK     ( SCHED_WORKER_DEQUE_LEN-1 )
+
+SCHED_STATIC_ASSERT((SCHED_WORKER_DEQUE_LEN & SCHED_WORKER_DEQUE_MASK) == 0, sched_worker_deque_len_not_pow2);
+SCHED_STATIC_ASSERT(SCHED_WORKER_NUM > 0, sched_worker_num_is_zero);
+
+/*工作窃取双端队列, 所有者(调度线程)在bottom端压入, 工作线程在top端窃取*/
+typedef struct sched_worker_deque SchedWorkerDeque_t;
+struct sched_worker_deque
+{
+    atomic_llong                    top;    /*窃取端位置*/
+    atomic_llong                    bottom; /*所有者端位置*/
+    _Atomic(SchedWorkerJob_t *)     buf[SCHED_WORKER_DEQUE_LEN];
+};
+/*******************************************************************************
+
+                                    全局变量
+
+*******************************************************************************/
+/*调度线程拥有的作业双端队列*/
+static SchedWorkerDeque_t workerDeque;
+static pthread_t workerThread[SCHED_WORKER_NUM];
+/*已提交未取出的作业数量, 工作线程无作业时在条件变量上休眠*/
+static atomic_int workerPending;
+static pthread_mutex_t workerLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t workerWake = PTHREAD_COND_INITIALIZER;
+/*已完成作业链表, 后完成的作业在前*/
+static _Atomic(SchedWorkerJob_t *) workerDone;
+
+static SchedBool_t prvDequePush(SchedWorkerDeque_t *deque, SchedWorkerJob_t *job);
+static SchedWorkerJob_t * prvDequeSteal(SchedWorkerDeque_t *deque);
+static void * prvWorkerThread(void *arg);
+/*******************************************************************************
+
+                                    底层接口
+
+*******************************************************************************/
+/*工作线程池初始化, 在调度线程中调用*/
+void sched_PortWorkerInit(void)
+{
+int i;
+int err;
+
+    atomic_init(&workerDeque.top, 0);
+    atomic_init(&workerDeque.bottom, 0);
+    atomic_init(&workerPending, 0);
+    atomic_init(&workerDone, NULL);
+    for (i=0;i<SCHED_WORKER_NUM;i++)
+    {
+        err = pthread_create(&workerThread[i], NULL, prvWorkerThread, NULL);
+        SCHED_CHECK(0 == err,chkSCHED_MALLOC_FAILED);
+        (void)err;
+    }
+}
+
+/**
+ * 提交作业到调度线程的双端队列, 并唤醒一个休眠的工作线程, 只允许在调度线程中调用
+ *
+ * @param job: 作业指针
+ *
+ * @return: SCHED_TRUE  表示提交成功
+ *          SCHED_FALSE 表示作业队列已满
+ */
+SchedBool_t sched_PortWorkerSubmit(SchedWorkerJob_t *job)
+{
+SchedBool_t ret;
+
+    SCHED_ASSERT(NULL != job,errSCHED_PARAM_PTR_IS_NULL);
+    ret = prvDequePush(&workerDeque, job);
+    if (SCHED_FALSE != ret)
+    {
+        /*先增加计数再加锁通知, 工作线程在锁内检查计数, 不会丢失唤醒*/
+        atomic_fetch_add(&workerPending, 1);
+        pthread_mutex_lock(&workerLock);
+        pthread_cond_signal(&workerWake);
+        pthread_mutex_unlock(&workerLock);
+    }
+    return (ret);
+}
+
+/**
+ * 报告作业完成, 作业加入完成链表
+ *
+ * @param job: 已完成的作业指针
+ */
+void sched_PortWorkerComplete(SchedWorkerJob_t *job)
+{
+SchedWorkerJob_t *head;
+
+    head = atomic_load_explicit(&workerDone, memory_order_relaxed);
+    do
+    {
+        job->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&workerDone, &head, job,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+/**
+ * 取出全部已完成的作业
+ *
+ * @return: 按完成顺序链接的作业链表, 没有已完成的作业时返回NULL
+ */
+SchedWorkerJob_t *sched_PortWorkerTakeDone(void)
+{
+SchedWorkerJob_t *head;
+SchedWorkerJob_t *prev = NULL;
+SchedWorkerJob_t *next;
+
+    /*没有已完成的作业时不执行原子交换*/
+    if (NULL != atomic_load_explicit(&workerDone, memory_order_relaxed))
+    {
+        head = atomic_exchange_explicit(&workerDone, NULL, memory_order_acquire);
+        /*反转链表, 先完成的作业在前*/
+        while (NULL != head)
+        {
+            next = head->next;
+            head->next = prev;
+            prev = head;
+            head = next;
+        }
+    }
+    return (prev);
+}
+
+/*******************************************************************************
+
+                                    私有函数
+
+*******************************************************************************/
+
+/**
+ * 所有者在bottom端压入作业
+ *
+ * @return: 队列已满时返回SCHED_FALSE
+ */
+static SchedBool_t prvDequePush(SchedWorkerDeque_t *deque, SchedWorkerJob_t *job)
+{
+SchedBool_t ret = SCHED_FALSE;
+long long b;
+long long t;
+
+    b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (b - t < SCHED_WORKER_DEQUE_LEN)
+    {
+        atomic_store_explicit(&deque->buf[b & SCHED_WORKER_DEQUE_MASK], job, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+        ret = SCHED_TRUE;
+    }
+    return (ret);
+}
+
+/**
+ * 在top端窃取作业
+ *
+ * @return: 作业指针, 队列为空(或者竞争失败)时返回NULL
+ */
+static SchedWorkerJob_t * prvDequeSteal(SchedWorkerDeque_t *deque)
+{
+SchedWorkerJob_t *job = NULL;
+long long b;
+long long t;
+
+    t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (t < b)
+    {
+        job = atomic_load_explicit(&deque->buf[t & SCHED_WORKER_DEQUE_MASK], memory_order_relaxed);
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed))
+        {
+            job = NULL;
+        }
+    }
+    return (job);
+}
+
+/*工作线程*/
+static void * prvWorkerThread(void *arg)
+{
+SchedWorkerJob_t *job;
+
+    (void)arg;
+    for ( ;; )
+    {
+        job = prvDequeSteal(&workerDeque);
+        if (NULL != job)
+        {
+            atomic_fetch_sub(&workerPending, 1);
+            (job->func)(job);
+        }
+        else
+        {
+            /*没有已提交的作业时休眠, 窃取竞争失败时重新查找*/
+            pthread_mutex_lock(&workerLock);
+            while (0 == atomic_load(&workerPending))
+            {
+                pthread_cond_wait(&workerWake, &workerLock);
+            }
+            pthread_mutex_unlock(&workerLock);
+        }
+    }
+    return (NULL);
+}
+
+#endif  /* SCHED_DAEMON_OFFLOAD_EN */